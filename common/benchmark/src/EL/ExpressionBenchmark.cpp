@@ -0,0 +1,141 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/ModelDefinition.h"
+#include "EL/CompiledExpression.h"
+#include "EL/EvaluationContext.h"
+#include "EL/Expression.h"
+#include "EL/Value.h"
+#include "IO/ELParser.h"
+#include "Model/Entity.h"
+#include "Model/EntityPropertiesVariableStore.h"
+
+#include <string>
+#include <vector>
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+
+namespace TrenchBroom
+{
+namespace EL
+{
+static constexpr size_t NumEntities = 100'000;
+
+static std::vector<Model::Entity> makeEntities()
+{
+  auto entities = std::vector<Model::Entity>{};
+  entities.reserve(NumEntities);
+
+  for (size_t i = 0; i < NumEntities; ++i)
+  {
+    entities.push_back(Model::Entity{
+      {},
+      {{"classname", "item_health"},
+       {"spawnflags", std::to_string(i % 4)},
+       {"skin", std::to_string(i % 3)}}});
+  }
+
+  return entities;
+}
+
+TEST_CASE("ExpressionBenchmark.evaluateModelExpressions")
+{
+  const auto expression = IO::ELParser::parseStrict(R"(
+{{
+  spawnflags == 1 -> { path: ":maps/b_bh10.bsp", skin: skin },
+  spawnflags & 2  -> { path: ":maps/b_bh100.bsp", frame: spawnflags - 1 },
+                     { path: ":maps/b_bh25.bsp", scale: [ skin, 1 ] }
+}})");
+  const auto compiledExpression = expression.compile();
+
+  const auto entities = makeEntities();
+
+  auto expectedValues = std::vector<Value>{};
+  expectedValues.reserve(NumEntities);
+
+  timeLambda(
+    [&]() {
+      for (const auto& entity : entities)
+      {
+        const auto context =
+          EvaluationContext{Model::EntityPropertiesVariableStore{entity}};
+        expectedValues.push_back(expression.evaluate(context));
+      }
+    },
+    "evaluate " + std::to_string(NumEntities) + " model expressions");
+
+  auto values = std::vector<Value>{};
+  values.reserve(NumEntities);
+
+  timeLambda(
+    [&]() {
+      for (const auto& entity : entities)
+      {
+        values.push_back(
+          compiledExpression.evaluate(Model::EntityPropertiesVariableStore{entity}));
+      }
+    },
+    "evaluate " + std::to_string(NumEntities) + " compiled model expressions");
+
+  CHECK(values == expectedValues);
+}
+
+TEST_CASE("ExpressionBenchmark.resolveModelSpecifications")
+{
+  const auto modelDefinition = Assets::ModelDefinition{IO::ELParser::parseStrict(R"(
+{{
+  spawnflags == 1 -> { path: ":maps/b_bh10.bsp", skin: skin },
+  spawnflags & 2  -> { path: ":maps/b_bh100.bsp", frame: spawnflags - 1 },
+                     { path: ":maps/b_bh25.bsp" }
+}})")};
+
+  const auto entities = makeEntities();
+
+  auto expectedModelSpecifications = std::vector<Assets::ModelSpecification>{};
+  expectedModelSpecifications.reserve(NumEntities);
+
+  timeLambda(
+    [&]() {
+      for (const auto& entity : entities)
+      {
+        expectedModelSpecifications.push_back(modelDefinition.modelSpecification(
+          Model::EntityPropertiesVariableStore{entity}));
+      }
+    },
+    "resolve " + std::to_string(NumEntities) + " model specifications");
+
+  auto modelSpecifications = std::vector<Assets::ModelSpecification>{};
+  modelSpecifications.reserve(NumEntities);
+
+  timeLambda(
+    [&]() {
+      auto cache = Assets::ModelSpecificationCache{};
+      for (const auto& entity : entities)
+      {
+        modelSpecifications.push_back(cache.modelSpecification(
+          modelDefinition, Model::EntityPropertiesVariableStore{entity}));
+      }
+    },
+    "resolve " + std::to_string(NumEntities) + " cached model specifications");
+
+  CHECK(modelSpecifications == expectedModelSpecifications);
+}
+} // namespace EL
+} // namespace TrenchBroom
@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/NodeWriter.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <sstream>
+#include <string>
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+
+namespace TrenchBroom
+{
+namespace IO
+{
+static constexpr size_t NumEntities = 2'000;
+static constexpr size_t NumBrushesPerEntity = 32;
+
+static void addBrushes(Model::WorldNode& world)
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = Model::BrushBuilder{world.mapFormat(), worldBounds};
+
+  for (size_t i = 0; i < NumEntities; ++i)
+  {
+    auto* entityNode = new Model::EntityNode{Model::Entity{
+      {},
+      {{"classname", "func_detail"},
+       {"targetname", "entity" + std::to_string(i)},
+       {"_phong", "1"}}}};
+
+    for (size_t j = 0; j < NumBrushesPerEntity; ++j)
+    {
+      auto brush = builder.createCube(64.0, "some/texture").value();
+      const auto offset = vm::vec3{
+        static_cast<FloatType>(i % 64) * 64.0,
+        static_cast<FloatType>(i / 64) * 64.0,
+        static_cast<FloatType>(j) * 64.0};
+      REQUIRE(
+        brush.transform(worldBounds, vm::translation_matrix(offset), false).is_success());
+      entityNode->addChild(new Model::BrushNode{std::move(brush)});
+    }
+    world.defaultLayer()->addChild(entityNode);
+  }
+}
+
+TEST_CASE("NodeWriterBenchmark.writeMap")
+{
+  auto world = Model::WorldNode{{}, {}, Model::MapFormat::Valve};
+  addBrushes(world);
+
+  auto str = std::stringstream{};
+  timeLambda(
+    [&]() {
+      auto writer = NodeWriter{world, str};
+      writer.writeMap();
+    },
+    "write map with " + std::to_string(NumEntities * NumBrushesPerEntity) + " brushes");
+
+  CHECK(str.str().size() > 0u);
+}
+} // namespace IO
+} // namespace TrenchBroom
@@ -0,0 +1,107 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/Group.h"
+#include "Model/GroupNode.h"
+#include "Model/MapFormat.h"
+
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+
+namespace TrenchBroom
+{
+namespace Model
+{
+static constexpr size_t NumLinkedGroups = 400;
+static constexpr size_t NumBrushesPerGroup = 64;
+
+static std::unique_ptr<GroupNode> createLinkedGroup(
+  const BrushBuilder& builder,
+  const vm::bbox3& worldBounds,
+  const vm::mat4x4& transformation)
+{
+  auto group = Group{"prefab"};
+  group.setLinkedGroupId("linked_group_id");
+  group.transform(transformation);
+
+  auto groupNode = std::make_unique<GroupNode>(std::move(group));
+
+  auto* entityNode = new EntityNode{Entity{{}, {{"classname", "func_detail"}}}};
+  for (size_t i = 0; i < NumBrushesPerGroup; ++i)
+  {
+    auto brush = builder.createCube(16.0, "some/texture").value();
+    const auto offset = vm::vec3{
+      static_cast<FloatType>(i % 8) * 16.0, static_cast<FloatType>(i / 8) * 16.0, 0.0};
+    REQUIRE(brush
+              .transform(
+                worldBounds, transformation * vm::translation_matrix(offset), false)
+              .is_success());
+    entityNode->addChild(new BrushNode{std::move(brush)});
+  }
+  groupNode->addChild(entityNode);
+
+  return groupNode;
+}
+
+TEST_CASE("UpdateLinkedGroupsBenchmark.updateLinkedGroups")
+{
+  const auto worldBounds = vm::bbox3{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Valve, worldBounds};
+
+  auto groupNodes = std::vector<std::unique_ptr<GroupNode>>{};
+  for (size_t i = 0; i < NumLinkedGroups; ++i)
+  {
+    const auto offset = vm::vec3{
+      static_cast<FloatType>(i % 20) * 256.0,
+      static_cast<FloatType>(i / 20) * 256.0,
+      0.0};
+    groupNodes.push_back(
+      createLinkedGroup(builder, worldBounds, vm::translation_matrix(offset)));
+  }
+
+  const auto& sourceGroupNode = *groupNodes.front();
+  const auto targetGroupNodes = kdl::vec_transform(
+    groupNodes, [](const auto& groupNode) { return groupNode.get(); });
+
+  timeLambda(
+    [&]() {
+      CHECK(updateLinkedGroups(sourceGroupNode, targetGroupNodes, worldBounds)
+              .is_success());
+    },
+    "update " + std::to_string(NumLinkedGroups) + " linked groups with "
+      + std::to_string(NumBrushesPerGroup) + " brushes");
+}
+} // namespace Model
+} // namespace TrenchBroom
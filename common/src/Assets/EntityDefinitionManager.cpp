@@ -133,6 +133,7 @@ void EntityDefinitionManager::updateGroups()
 void EntityDefinitionManager::updateCache()
 {
   clearCache();
+  m_cache.reserve(m_definitions.size());
   for (EntityDefinition* definition : m_definitions)
   {
     m_cache[definition->name()] = definition;
@@ -19,8 +19,8 @@
 
 #pragma once
 
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
@@ -47,7 +47,7 @@ enum class EntityDefinitionType;
 class EntityDefinitionManager
 {
 private:
-  using Cache = std::map<std::string, EntityDefinition*>;
+  using Cache = std::unordered_map<std::string, EntityDefinition*>;
   std::vector<EntityDefinition*> m_definitions;
   std::vector<EntityDefinitionGroup> m_groups;
   Cache m_cache;
@@ -58,16 +58,19 @@ kdl_reflect_impl(ModelSpecification);
 
 ModelDefinition::ModelDefinition()
   : m_expression{EL::LiteralExpression{EL::Value::Undefined}, 0, 0}
+  , m_compiledExpression{m_expression.compile()}
 {
 }
 
 ModelDefinition::ModelDefinition(const size_t line, const size_t column)
   : m_expression{EL::LiteralExpression{EL::Value::Undefined}, line, column}
+  , m_compiledExpression{m_expression.compile()}
 {
 }
 
 ModelDefinition::ModelDefinition(const EL::Expression& expression)
   : m_expression{expression}
+  , m_compiledExpression{m_expression.compile()}
 {
 }
 
@@ -79,6 +82,17 @@ void ModelDefinition::append(const ModelDefinition& other)
   auto cases = std::vector<EL::Expression>{std::move(m_expression), other.m_expression};
 
   m_expression = EL::Expression{EL::SwitchExpression{std::move(cases)}, line, column};
+  m_compiledExpression = m_expression.compile();
+}
+
+const EL::Expression& ModelDefinition::expression() const
+{
+  return m_expression;
+}
+
+const std::vector<std::string>& ModelDefinition::propertyKeys() const
+{
+  return m_compiledExpression.variableNames();
 }
 
 static IO::Path path(const EL::Value& value)
@@ -127,8 +141,7 @@ static ModelSpecification convertToModel(const EL::Value& value)
 ModelSpecification ModelDefinition::modelSpecification(
   const EL::VariableStore& variableStore) const
 {
-  const auto context = EL::EvaluationContext{variableStore};
-  return convertToModel(m_expression.evaluate(context));
+  return convertToModel(m_compiledExpression.evaluate(variableStore));
 }
 
 ModelSpecification ModelDefinition::defaultModelSpecification() const
@@ -191,8 +204,7 @@ vm::vec3 ModelDefinition::scale(
   const EL::VariableStore& variableStore,
   const std::optional<EL::Expression>& defaultScaleExpression) const
 {
-  const auto context = EL::EvaluationContext{variableStore};
-  const auto value = m_expression.evaluate(context);
+  const auto value = m_compiledExpression.evaluate(variableStore);
 
   switch (value.type())
   {
@@ -213,6 +225,7 @@ vm::vec3 ModelDefinition::scale(
 
   if (defaultScaleExpression)
   {
+    const auto context = EL::EvaluationContext{variableStore};
     if (const auto scale = convertToScale(defaultScaleExpression->evaluate(context)))
     {
       return *scale;
@@ -224,6 +237,50 @@ vm::vec3 ModelDefinition::scale(
 
 kdl_reflect_impl(ModelDefinition);
 
+static std::optional<std::vector<std::string>> makeCacheKey(
+  const ModelDefinition& definition, const EL::VariableStore& variableStore)
+{
+  auto key = std::vector<std::string>{};
+  key.reserve(definition.propertyKeys().size());
+
+  for (const auto& name : definition.propertyKeys())
+  {
+    const auto value = variableStore.value(name);
+    if (value.type() != EL::ValueType::String)
+    {
+      return std::nullopt;
+    }
+    key.push_back(value.stringValue());
+  }
+
+  return key;
+}
+
+ModelSpecification ModelSpecificationCache::modelSpecification(
+  const ModelDefinition& definition, const EL::VariableStore& variableStore)
+{
+  auto key = makeCacheKey(definition, variableStore);
+  if (!key)
+  {
+    return definition.modelSpecification(variableStore);
+  }
+
+  auto& cache = m_cache[&definition];
+  if (const auto it = cache.find(*key); it != cache.end())
+  {
+    return it->second;
+  }
+
+  auto modelSpecification = definition.modelSpecification(variableStore);
+  cache.emplace(std::move(*key), modelSpecification);
+  return modelSpecification;
+}
+
+void ModelSpecificationCache::clear()
+{
+  m_cache.clear();
+}
+
 vm::vec3 safeGetModelScale(
   const ModelDefinition& definition,
   const EL::VariableStore& variableStore,
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "EL/CompiledExpression.h"
 #include "EL/Expression.h"
 #include "FloatType.h"
 #include "IO/Path.h"
@@ -27,7 +28,10 @@
 #include <vecmath/vec.h>
 
 #include <iosfwd>
+#include <map>
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -58,6 +62,7 @@ class ModelDefinition
 {
 private:
   EL::Expression m_expression;
+  EL::CompiledExpression m_compiledExpression;
 
 public:
   ModelDefinition();
@@ -66,6 +71,15 @@ public:
 
   void append(const ModelDefinition& other);
 
+  const EL::Expression& expression() const;
+
+  /**
+   * Returns the names of the variables that the model expression reads. Evaluating the
+   * model expression with variable stores that agree on the values of these variables
+   * yields the same model specification.
+   */
+  const std::vector<std::string>& propertyKeys() const;
+
   /**
    * Evaluates the model expresion, using the given variable store to interpolate
    * variables.
@@ -101,6 +115,33 @@ public:
   kdl_reflect_decl(ModelDefinition, m_expression);
 };
 
+/**
+ * Memoizes the model specifications of model definitions by the values of the variables
+ * that their model expressions read.
+ *
+ * The cache refers to model definitions by their address, so it must not outlive them.
+ */
+class ModelSpecificationCache
+{
+private:
+  using Key = std::vector<std::string>;
+  std::map<const ModelDefinition*, std::map<Key, ModelSpecification>> m_cache;
+
+public:
+  /**
+   * Returns the model specification of the given definition for the given variable store.
+   * The model expression is evaluated only if the cache does not contain a model
+   * specification for the values of the variables that the expression reads, or if any
+   * of these values is not a string.
+   *
+   * @throws EL::Exception if the expression could not be evaluated
+   */
+  ModelSpecification modelSpecification(
+    const ModelDefinition& definition, const EL::VariableStore& variableStore);
+
+  void clear();
+};
+
 /**
  * Returns the model scale value for the given parameters or a default scale of 1, 1, 1 if
  * an error occurs.
@@ -56,6 +56,9 @@ Texture::Texture(
   , m_culling{TextureCulling::CullDefault}
   , m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA}
   , m_textureId{0}
+  , m_uploadPending{false}
+  , m_minFilter{0}
+  , m_magFilter{0}
   , m_gameData{std::move(gameData)}
 {
   assert(m_width > 0);
@@ -85,6 +88,9 @@ Texture::Texture(
   , m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA}
   , m_textureId(0)
   , m_buffers{std::move(buffers)}
+  , m_uploadPending{false}
+  , m_minFilter{0}
+  , m_magFilter{0}
   , m_gameData{std::move(gameData)}
 {
   assert(m_width > 0);
@@ -125,6 +131,9 @@ Texture::Texture(
   , m_culling{TextureCulling::CullDefault}
   , m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA}
   , m_textureId{0}
+  , m_uploadPending{false}
+  , m_minFilter{0}
+  , m_magFilter{0}
   , m_gameData{std::move(gameData)}
 {
 }
@@ -147,6 +156,9 @@ Texture::Texture(Texture&& other)
   , m_blendFunc{std::move(other.m_blendFunc)}
   , m_textureId{std::move(other.m_textureId)}
   , m_buffers{std::move(other.m_buffers)}
+  , m_uploadPending{std::move(other.m_uploadPending)}
+  , m_minFilter{std::move(other.m_minFilter)}
+  , m_magFilter{std::move(other.m_magFilter)}
   , m_gameData{std::move(other.m_gameData)}
 {
 }
@@ -168,6 +180,9 @@ Texture& Texture::operator=(Texture&& other)
   m_blendFunc = std::move(other.m_blendFunc);
   m_textureId = std::move(other.m_textureId);
   m_buffers = std::move(other.m_buffers);
+  m_uploadPending = std::move(other.m_uploadPending);
+  m_minFilter = std::move(other.m_minFilter);
+  m_magFilter = std::move(other.m_magFilter);
   m_gameData = std::move(other.m_gameData);
   return *this;
 }
@@ -303,85 +318,100 @@ void Texture::prepare(const GLuint textureId, const int minFilter, const int mag
 
   if (!m_buffers.empty())
   {
-    const auto compressed = isCompressedFormat(m_format);
+    m_textureId = textureId;
+    m_minFilter = minFilter;
+    m_magFilter = magFilter;
+    m_uploadPending = true;
+  }
+}
 
-    glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
-    glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
-    glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
-    glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
-    glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
-    glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+void Texture::upload() const
+{
+  assert(m_uploadPending);
 
-    glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
-    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
-    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
-    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
-    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
+  const auto compressed = isCompressedFormat(m_format);
 
-    if (m_type == TextureType::Masked)
-    {
-      // masked textures don't work well with automatic mipmaps, so we force GL_NEAREST
-      // filtering and don't generate any
-      glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_FALSE));
-      glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
-      glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
-    }
-    else if (m_buffers.size() == 1)
+  glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
+  glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
+  glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+  glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+  glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+  glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+  glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
+  glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_minFilter));
+  glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_magFilter));
+  glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
+  glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
+
+  if (m_type == TextureType::Masked)
+  {
+    // masked textures don't work well with automatic mipmaps, so we force GL_NEAREST
+    // filtering and don't generate any
+    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_FALSE));
+    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+  }
+  else if (m_buffers.size() == 1)
+  {
+    // generate mipmaps if we don't have any
+    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE));
+  }
+  else
+  {
+    glAssert(glTexParameteri(
+      GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_buffers.size() - 1)));
+  }
+
+  // Upload only the first mipmap for masked textures.
+  const auto mipmapsToUpload = (m_type == TextureType::Masked) ? 1u : m_buffers.size();
+
+  for (size_t j = 0; j < mipmapsToUpload; ++j)
+  {
+    const auto mipSize = sizeAtMipLevel(m_width, m_height, j);
+
+    const auto* data = reinterpret_cast<const GLvoid*>(m_buffers[j].data());
+    if (compressed)
     {
-      // generate mipmaps if we don't have any
-      glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE));
+      const auto dataSize = static_cast<GLsizei>(m_buffers[j].size());
+
+      glAssert(glCompressedTexImage2D(
+        GL_TEXTURE_2D,
+        static_cast<GLint>(j),
+        m_format,
+        static_cast<GLsizei>(mipSize.x()),
+        static_cast<GLsizei>(mipSize.y()),
+        0,
+        dataSize,
+        data));
     }
     else
     {
-      glAssert(glTexParameteri(
-        GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_buffers.size() - 1)));
-    }
-
-    // Upload only the first mipmap for masked textures.
-    const auto mipmapsToUpload = (m_type == TextureType::Masked) ? 1u : m_buffers.size();
-
-    for (size_t j = 0; j < mipmapsToUpload; ++j)
-    {
-      const auto mipSize = sizeAtMipLevel(m_width, m_height, j);
-
-      const auto* data = reinterpret_cast<const GLvoid*>(m_buffers[j].data());
-      if (compressed)
-      {
-        const auto dataSize = static_cast<GLsizei>(m_buffers[j].size());
-
-        glAssert(glCompressedTexImage2D(
-          GL_TEXTURE_2D,
-          static_cast<GLint>(j),
-          m_format,
-          static_cast<GLsizei>(mipSize.x()),
-          static_cast<GLsizei>(mipSize.y()),
-          0,
-          dataSize,
-          data));
-      }
-      else
-      {
-        glAssert(glTexImage2D(
-          GL_TEXTURE_2D,
-          static_cast<GLint>(j),
-          GL_RGBA,
-          static_cast<GLsizei>(mipSize.x()),
-          static_cast<GLsizei>(mipSize.y()),
-          0,
-          m_format,
-          GL_UNSIGNED_BYTE,
-          data));
-      }
+      glAssert(glTexImage2D(
+        GL_TEXTURE_2D,
+        static_cast<GLint>(j),
+        GL_RGBA,
+        static_cast<GLsizei>(mipSize.x()),
+        static_cast<GLsizei>(mipSize.y()),
+        0,
+        m_format,
+        GL_UNSIGNED_BYTE,
+        data));
     }
-
-    m_buffers.clear();
-    m_textureId = textureId;
   }
+
+  m_buffers.clear();
+  m_uploadPending = false;
 }
 
 void Texture::setMode(const int minFilter, const int magFilter)
 {
-  if (isPrepared())
+  if (m_uploadPending)
+  {
+    m_minFilter = minFilter;
+    m_magFilter = magFilter;
+  }
+  else if (isPrepared())
   {
     activate();
     if (m_type == TextureType::Masked)
@@ -403,7 +433,13 @@ void Texture::activate() const
 {
   if (isPrepared())
   {
+    if (m_uploadPending)
+    {
+      upload();
+    }
+
     glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
+    ++glCallCounts().textureBinds;
 
     switch (m_culling)
     {
@@ -463,6 +499,7 @@ void Texture::deactivate() const
     }
 
     glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+    ++glCallCounts().textureBinds;
   }
 }
 
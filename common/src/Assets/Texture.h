@@ -128,6 +128,11 @@ private:
   mutable GLuint m_textureId;
   mutable BufferList m_buffers;
 
+  // the texture data is uploaded when the texture is first activated
+  mutable bool m_uploadPending;
+  int m_minFilter;
+  int m_magFilter;
+
   GameData m_gameData;
 
 public:
@@ -210,16 +215,25 @@ public:
   void setOverridden(bool overridden);
 
   bool isPrepared() const;
+
+  /**
+   * Assigns the given texture ID to this texture. The texture data is not uploaded until
+   * the texture is activated for the first time, so that textures which are never
+   * rendered do not occupy any texture memory.
+   */
   void prepare(GLuint textureId, int minFilter, int magFilter);
   void setMode(int minFilter, int magFilter);
 
   void activate() const;
   void deactivate() const;
 
+private:
+  void upload() const;
+
 public: // exposed for tests only
   /**
    * Returns the texture data in the format returned by format().
-   * Once prepare() is called, this will be an empty vector.
+   * Once the texture is uploaded, this will be an empty vector.
    */
   const BufferList& buffersIfUnprepared() const;
   /**
@@ -0,0 +1,354 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CompiledExpression.h"
+
+#include "EL/EvaluationContext.h"
+#include "EL/Expression.h"
+#include "EL/Expressions.h"
+#include "EL/VariableStore.h"
+#include "Ensure.h"
+#include "Macros.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+namespace TrenchBroom
+{
+namespace EL
+{
+CompiledExpression::CompiledExpression()
+  : m_maxStackSize{0u}
+{
+}
+
+Value CompiledExpression::evaluate(const EvaluationContext& context) const
+{
+  return run([&](const auto& name) { return context.variableValue(name); });
+}
+
+Value CompiledExpression::evaluate(const VariableStore& variableStore) const
+{
+  return run([&](const auto& name) { return variableStore.value(name); });
+}
+
+const std::vector<Instruction>& CompiledExpression::instructions() const
+{
+  return m_instructions;
+}
+
+const std::vector<std::string>& CompiledExpression::variableNames() const
+{
+  return m_names;
+}
+
+namespace
+{
+/**
+ * The operand stack of a compiled expression. The values are constructed in place, and
+ * no memory is allocated unless the expression needs more than a few stack slots.
+ */
+class ValueStack
+{
+private:
+  static constexpr size_t InlineCapacity = 8u;
+
+  alignas(Value) std::byte m_inlineStorage[InlineCapacity * sizeof(Value)];
+  std::unique_ptr<std::byte[]> m_heapStorage;
+  Value* m_values;
+  size_t m_size;
+
+public:
+  explicit ValueStack(const size_t capacity)
+    : m_size{0u}
+  {
+    if (capacity > InlineCapacity)
+    {
+      m_heapStorage = std::make_unique<std::byte[]>(capacity * sizeof(Value));
+      m_values = reinterpret_cast<Value*>(m_heapStorage.get());
+    }
+    else
+    {
+      m_values = reinterpret_cast<Value*>(m_inlineStorage);
+    }
+  }
+
+  ~ValueStack() { pop(m_size); }
+
+  size_t size() const { return m_size; }
+
+  /**
+   * Returns the value at the given position, counted from the bottom of the stack.
+   */
+  Value& operator[](const size_t index) { return m_values[index]; }
+
+  /**
+   * Returns the value at the given position, counted from the top of the stack.
+   */
+  Value& top(const size_t offset = 0u) { return m_values[m_size - 1u - offset]; }
+
+  void push(Value value)
+  {
+    new (m_values + m_size) Value{std::move(value)};
+    ++m_size;
+  }
+
+  void pop(const size_t count = 1u)
+  {
+    assert(count <= m_size);
+    for (size_t i = 0u; i < count; ++i)
+    {
+      m_values[--m_size].~Value();
+    }
+  }
+
+  deleteCopyAndMove(ValueStack);
+};
+} // namespace
+
+template <typename LookupVariable>
+Value CompiledExpression::run(const LookupVariable& lookupVariable) const
+{
+  auto stack = ValueStack{m_maxStackSize};
+
+  // the values of the auto range parameters of the enclosing subscripts
+  auto autoRangeParameters = std::vector<Value>{};
+
+  auto next = size_t(0);
+  while (next < m_instructions.size())
+  {
+    const auto& instruction = m_instructions[next++];
+    switch (instruction.opCode)
+    {
+    case OpCode::PushLiteral:
+      stack.push(m_literals[instruction.operand]);
+      break;
+    case OpCode::PushVariable:
+      stack.push(lookupVariable(m_names[instruction.operand]));
+      break;
+    case OpCode::PushAutoRangeParameter:
+      assert(!autoRangeParameters.empty());
+      stack.push(autoRangeParameters.back());
+      break;
+    case OpCode::MakeArray: {
+      const auto count = size_t(instruction.operand);
+      const auto first = stack.size() - count;
+
+      auto array = ArrayType{};
+      array.reserve(count);
+      for (size_t i = 0u; i < count; ++i)
+      {
+        appendArrayElement(array, std::move(stack[first + i]));
+      }
+
+      stack.pop(count);
+      stack.push(Value{std::move(array)});
+      break;
+    }
+    case OpCode::MakeMap: {
+      const auto& keys = m_keys[instruction.operand];
+      const auto first = stack.size() - keys.size();
+
+      auto map = MapType{};
+      for (size_t i = 0u; i < keys.size(); ++i)
+      {
+        map.emplace(keys[i], std::move(stack[first + i]));
+      }
+
+      stack.pop(keys.size());
+      stack.push(Value{std::move(map)});
+      break;
+    }
+    case OpCode::UnaryOperation:
+      stack.top() = evaluateUnaryOperator(
+        static_cast<UnaryOperator>(instruction.subCode), stack.top());
+      break;
+    case OpCode::BinaryOperation:
+      stack.top(1u) = evaluateBinaryOperator(
+        static_cast<BinaryOperator>(instruction.subCode), stack.top(1u), stack.top());
+      stack.pop();
+      break;
+    case OpCode::BinaryOperationWithLiteral:
+      stack.top() = evaluateBinaryOperator(
+        static_cast<BinaryOperator>(instruction.subCode),
+        stack.top(),
+        m_literals[instruction.operand]);
+      break;
+    case OpCode::JumpIfShortCircuit:
+      if (
+        auto result = evaluateShortCircuit(
+          static_cast<BinaryOperator>(instruction.subCode), stack.top()))
+      {
+        stack.top() = std::move(*result);
+        next = instruction.operand;
+      }
+      break;
+    case OpCode::JumpIfDefined:
+      if (!stack.top().hasType(ValueType::Undefined))
+      {
+        next = instruction.operand;
+      }
+      break;
+    case OpCode::Pop:
+      stack.pop();
+      break;
+    case OpCode::BeginSubscript:
+      autoRangeParameters.emplace_back(stack.top().length() - 1u);
+      break;
+    case OpCode::EndSubscript:
+      autoRangeParameters.pop_back();
+      stack.top(1u) = stack.top(1u)[stack.top()];
+      stack.pop();
+      break;
+      switchDefault();
+    }
+  }
+
+  assert(stack.size() == 1u);
+  return std::move(stack.top());
+}
+
+ExpressionCompiler::ExpressionCompiler()
+  : m_stackSize{0u}
+  , m_subscriptDepth{0u}
+  , m_lastJumpTarget{0u}
+{
+}
+
+void ExpressionCompiler::compile(const Expression& expression)
+{
+  expression.m_expression->compile(*this);
+}
+
+CompiledExpression ExpressionCompiler::result() &&
+{
+  assert(m_stackSize == 1u);
+  return std::move(m_result);
+}
+
+void ExpressionCompiler::emitLiteral(const Value& value)
+{
+  emit(OpCode::PushLiteral, 0, m_result.m_literals.size(), 1);
+  m_result.m_literals.push_back(value);
+}
+
+void ExpressionCompiler::emitVariable(const std::string& name)
+{
+  if (m_subscriptDepth > 0u && name == SubscriptExpression::AutoRangeParameterName())
+  {
+    emit(OpCode::PushAutoRangeParameter, 0, 0, 1);
+    return;
+  }
+
+  const auto it = std::find(m_result.m_names.begin(), m_result.m_names.end(), name);
+  emit(
+    OpCode::PushVariable, 0, size_t(std::distance(m_result.m_names.begin(), it)), 1);
+  if (it == m_result.m_names.end())
+  {
+    m_result.m_names.push_back(name);
+  }
+}
+
+void ExpressionCompiler::emitArray(const size_t count)
+{
+  emit(OpCode::MakeArray, 0, count, 1 - int(count));
+}
+
+void ExpressionCompiler::emitMap(std::vector<std::string> keys)
+{
+  emit(OpCode::MakeMap, 0, m_result.m_keys.size(), 1 - int(keys.size()));
+  m_result.m_keys.push_back(std::move(keys));
+}
+
+void ExpressionCompiler::emitUnaryOperation(const UnaryOperator operator_)
+{
+  emit(OpCode::UnaryOperation, std::uint8_t(operator_), 0, 0);
+}
+
+void ExpressionCompiler::emitBinaryOperation(const BinaryOperator operator_)
+{
+  auto& instructions = m_result.m_instructions;
+  if (
+    !instructions.empty() && instructions.back().opCode == OpCode::PushLiteral
+    && m_lastJumpTarget < instructions.size())
+  {
+    // fold the right operand into the operation unless a jump targets the operation
+    auto& instruction = instructions.back();
+    instruction.opCode = OpCode::BinaryOperationWithLiteral;
+    instruction.subCode = std::uint8_t(operator_);
+    --m_stackSize;
+    return;
+  }
+
+  emit(OpCode::BinaryOperation, std::uint8_t(operator_), 0, -1);
+}
+
+void ExpressionCompiler::emitPop()
+{
+  emit(OpCode::Pop, 0, 0, -1);
+}
+
+void ExpressionCompiler::emitBeginSubscript()
+{
+  emit(OpCode::BeginSubscript, 0, 0, 0);
+  ++m_subscriptDepth;
+}
+
+void ExpressionCompiler::emitEndSubscript()
+{
+  assert(m_subscriptDepth > 0u);
+  --m_subscriptDepth;
+  emit(OpCode::EndSubscript, 0, 0, -1);
+}
+
+size_t ExpressionCompiler::emitJumpIfShortCircuit(const BinaryOperator operator_)
+{
+  emit(OpCode::JumpIfShortCircuit, std::uint8_t(operator_), 0, 0);
+  return m_result.m_instructions.size() - 1u;
+}
+
+size_t ExpressionCompiler::emitJumpIfDefined()
+{
+  emit(OpCode::JumpIfDefined, 0, 0, 0);
+  return m_result.m_instructions.size() - 1u;
+}
+
+void ExpressionCompiler::patchJump(const size_t jump)
+{
+  assert(jump < m_result.m_instructions.size());
+  m_lastJumpTarget = m_result.m_instructions.size();
+  m_result.m_instructions[jump].operand = std::uint32_t(m_lastJumpTarget);
+}
+
+void ExpressionCompiler::emit(
+  const OpCode opCode,
+  const std::uint8_t subCode,
+  const size_t operand,
+  const int stackChange)
+{
+  assert(int(m_stackSize) + stackChange >= 0);
+
+  m_result.m_instructions.push_back(Instruction{opCode, subCode, std::uint32_t(operand)});
+  m_stackSize = size_t(int(m_stackSize) + stackChange);
+  m_result.m_maxStackSize = std::max(m_result.m_maxStackSize, m_stackSize);
+}
+} // namespace EL
+} // namespace TrenchBroom
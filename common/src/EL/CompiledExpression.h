@@ -0,0 +1,161 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "EL/EL_Forward.h"
+#include "EL/Value.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace EL
+{
+enum class UnaryOperator;
+enum class BinaryOperator;
+
+enum class OpCode : std::uint8_t
+{
+  /** Pushes the literal with the index given by the operand. */
+  PushLiteral,
+  /** Pushes the value of the variable whose name has the index given by the operand. */
+  PushVariable,
+  /** Pushes the auto range parameter of the innermost subscript. */
+  PushAutoRangeParameter,
+  /** Replaces the given number of values with an array containing them. */
+  MakeArray,
+  /** Replaces the values with a map, using the key list with the given index. */
+  MakeMap,
+  /** Applies the unary operator given by the sub code to the topmost value. */
+  UnaryOperation,
+  /** Applies the binary operator given by the sub code to the two topmost values. */
+  BinaryOperation,
+  /**
+   * Applies the binary operator given by the sub code to the topmost value and the
+   * literal with the index given by the operand.
+   */
+  BinaryOperationWithLiteral,
+  /**
+   * If the binary operator given by the sub code can be evaluated from its left operand
+   * alone, replaces the topmost value with the result and jumps to the operand.
+   */
+  JumpIfShortCircuit,
+  /** Jumps to the operand if the topmost value is not undefined. */
+  JumpIfDefined,
+  /** Removes the topmost value. */
+  Pop,
+  /** Declares the auto range parameter for the subscript of the topmost value. */
+  BeginSubscript,
+  /** Replaces the two topmost values with the result of the subscript. */
+  EndSubscript,
+};
+
+struct Instruction
+{
+  OpCode opCode;
+  std::uint8_t subCode;
+  std::uint32_t operand;
+};
+
+/**
+ * A flat representation of an expression tree that can be evaluated without recursion.
+ *
+ * The instructions operate on a value stack. Literals, variable names and map keys are
+ * stored in separate tables and referenced by index. Evaluating a compiled expression
+ * yields the same value as evaluating the expression it was compiled from, except that
+ * the resulting values do not refer to the expressions that produced them.
+ */
+class CompiledExpression
+{
+private:
+  std::vector<Instruction> m_instructions;
+  std::vector<Value> m_literals;
+  std::vector<std::string> m_names;
+  std::vector<std::vector<std::string>> m_keys;
+  size_t m_maxStackSize;
+
+public:
+  CompiledExpression();
+
+  Value evaluate(const EvaluationContext& context) const;
+  Value evaluate(const VariableStore& variableStore) const;
+
+  const std::vector<Instruction>& instructions() const;
+
+  /**
+   * Returns the names of the variables that are read when evaluating this expression.
+   */
+  const std::vector<std::string>& variableNames() const;
+
+private:
+  template <typename LookupVariable>
+  Value run(const LookupVariable& lookupVariable) const;
+
+  friend class ExpressionCompiler;
+};
+
+/**
+ * Translates an expression tree into a compiled expression. Each expression node emits
+ * the instructions for its operands followed by its own instructions.
+ */
+class ExpressionCompiler
+{
+private:
+  CompiledExpression m_result;
+  size_t m_stackSize;
+  size_t m_subscriptDepth;
+  size_t m_lastJumpTarget;
+
+public:
+  ExpressionCompiler();
+
+  void compile(const Expression& expression);
+  CompiledExpression result() &&;
+
+  void emitLiteral(const Value& value);
+  void emitVariable(const std::string& name);
+  void emitArray(size_t count);
+  void emitMap(std::vector<std::string> keys);
+  void emitUnaryOperation(UnaryOperator operator_);
+  void emitBinaryOperation(BinaryOperator operator_);
+  void emitPop();
+  void emitBeginSubscript();
+  void emitEndSubscript();
+
+  /**
+   * Emits a jump instruction whose target is set by a subsequent call to patchJump.
+   *
+   * @return the index of the jump instruction
+   */
+  size_t emitJumpIfShortCircuit(BinaryOperator operator_);
+  size_t emitJumpIfDefined();
+
+  /**
+   * Sets the target of the jump instruction at the given index to the next instruction.
+   */
+  void patchJump(size_t jump);
+
+private:
+  void emit(OpCode opCode, std::uint8_t subCode, size_t operand, int stackChange);
+};
+} // namespace EL
+} // namespace TrenchBroom
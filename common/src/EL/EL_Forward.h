@@ -27,6 +27,8 @@ class Value;
 enum class ValueType;
 
 class Expression;
+class CompiledExpression;
+class ExpressionCompiler;
 
 class EvaluationContext;
 
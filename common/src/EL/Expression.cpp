@@ -19,6 +19,7 @@
 
 #include "Expression.h"
 
+#include "EL/CompiledExpression.h"
 #include "EL/EvaluationContext.h"
 #include "EL/Expressions.h"
 #include "Ensure.h"
@@ -110,6 +111,13 @@ Expression Expression::optimize() const
   return Expression{m_expression->optimize(), m_line, m_column};
 }
 
+CompiledExpression Expression::compile() const
+{
+  auto compiler = ExpressionCompiler{};
+  compiler.compile(*this);
+  return std::move(compiler).result();
+}
+
 size_t Expression::line() const
 {
   return m_line;
@@ -65,6 +65,12 @@ public:
   Value evaluate(const EvaluationContext& context) const;
   Expression optimize() const;
 
+  /**
+   * Compiles this expression into a flat instruction sequence which can be evaluated
+   * more efficiently than the expression tree.
+   */
+  CompiledExpression compile() const;
+
   size_t line() const;
   size_t column() const;
 
@@ -74,6 +80,8 @@ public:
   friend bool operator!=(const Expression& lhs, const Expression& rhs);
   friend std::ostream& operator<<(std::ostream& str, const Expression& exp);
 
+  friend class ExpressionCompiler;
+
 private:
   void rebalanceByPrecedence();
   size_t precedence() const;
@@ -19,6 +19,7 @@
 
 #include "Expressions.h"
 
+#include "EL/CompiledExpression.h"
 #include "EL/ELExceptions.h"
 #include "EL/EvaluationContext.h"
 #include "Ensure.h"
@@ -110,6 +111,11 @@ std::unique_ptr<ExpressionImpl> LiteralExpression::optimize() const
   return std::make_unique<LiteralExpression>(m_value);
 }
 
+void LiteralExpression::compile(ExpressionCompiler& compiler) const
+{
+  compiler.emitLiteral(m_value);
+}
+
 bool LiteralExpression::operator==(const ExpressionImpl& rhs) const
 {
   return rhs == *this;
@@ -140,6 +146,11 @@ std::unique_ptr<ExpressionImpl> VariableExpression::optimize() const
   return std::make_unique<VariableExpression>(m_variableName);
 }
 
+void VariableExpression::compile(ExpressionCompiler& compiler) const
+{
+  compiler.emitVariable(m_variableName);
+}
+
 bool VariableExpression::operator==(const ExpressionImpl& rhs) const
 {
   return rhs == *this;
@@ -166,23 +177,7 @@ Value ArrayExpression::evaluate(const EvaluationContext& context) const
   array.reserve(m_elements.size());
   for (const auto& element : m_elements)
   {
-    auto value = element.evaluate(context);
-    if (value.hasType(ValueType::Range))
-    {
-      const auto& range = value.rangeValue();
-      if (!range.empty())
-      {
-        array.reserve(array.size() + range.size() - 1u);
-        for (size_t i = 0u; i < range.size(); ++i)
-        {
-          array.emplace_back(range[i], value.expression());
-        }
-      }
-    }
-    else
-    {
-      array.push_back(std::move(value));
-    }
+    appendArrayElement(array, element.evaluate(context));
   }
 
   return Value{std::move(array)};
@@ -212,6 +207,15 @@ std::unique_ptr<ExpressionImpl> ArrayExpression::optimize() const
   return std::make_unique<LiteralExpression>(Value{std::move(values)});
 }
 
+void ArrayExpression::compile(ExpressionCompiler& compiler) const
+{
+  for (const auto& element : m_elements)
+  {
+    compiler.compile(element);
+  }
+  compiler.emitArray(m_elements.size());
+}
+
 bool ArrayExpression::operator==(const ExpressionImpl& rhs) const
 {
   return rhs == *this;
@@ -280,6 +284,19 @@ std::unique_ptr<ExpressionImpl> MapExpression::optimize() const
   return std::make_unique<LiteralExpression>(Value{std::move(values)});
 }
 
+void MapExpression::compile(ExpressionCompiler& compiler) const
+{
+  auto keys = std::vector<std::string>{};
+  keys.reserve(m_elements.size());
+
+  for (const auto& [key, expression] : m_elements)
+  {
+    compiler.compile(expression);
+    keys.push_back(key);
+  }
+  compiler.emitMap(std::move(keys));
+}
+
 bool MapExpression::operator==(const ExpressionImpl& rhs) const
 {
   return rhs == *this;
@@ -402,7 +419,7 @@ static Value evaluateBitwiseNegation(const Value& v)
     + v.typeName()};
 }
 
-static Value evaluateUnaryExpression(const UnaryOperator& operator_, const Value& operand)
+Value evaluateUnaryOperator(const UnaryOperator operator_, const Value& operand)
 {
   if (operand == Value::Undefined)
   {
@@ -427,13 +444,13 @@ static Value evaluateUnaryExpression(const UnaryOperator& operator_, const Value
 
 Value UnaryExpression::evaluate(const EvaluationContext& context) const
 {
-  return evaluateUnaryExpression(m_operator, m_operand.evaluate(context));
+  return evaluateUnaryOperator(m_operator, m_operand.evaluate(context));
 }
 
 std::unique_ptr<ExpressionImpl> UnaryExpression::optimize() const
 {
   auto optimizedOperand = m_operand.optimize();
-  if (auto value = evaluateUnaryExpression(
+  if (auto value = evaluateUnaryOperator(
         m_operator, optimizedOperand.evaluate(EvaluationContext{}));
       value != Value::Undefined)
   {
@@ -443,6 +460,12 @@ std::unique_ptr<ExpressionImpl> UnaryExpression::optimize() const
   return std::make_unique<UnaryExpression>(m_operator, std::move(optimizedOperand));
 }
 
+void UnaryExpression::compile(ExpressionCompiler& compiler) const
+{
+  compiler.compile(m_operand);
+  compiler.emitUnaryOperation(m_operator);
+}
+
 bool UnaryExpression::operator==(const ExpressionImpl& rhs) const
 {
   return rhs == *this;
@@ -1109,6 +1132,74 @@ static Value evaluateBinaryExpression(
   };
 }
 
+Value evaluateBinaryOperator(
+  const BinaryOperator operator_, const Value& leftOperand, const Value& rightOperand)
+{
+  return evaluateBinaryExpression(
+    operator_,
+    [&]() -> const Value& { return leftOperand; },
+    [&]() -> const Value& { return rightOperand; });
+}
+
+std::optional<Value> evaluateShortCircuit(
+  const BinaryOperator operator_, const Value& leftOperand)
+{
+  switch (operator_)
+  {
+  case BinaryOperator::LogicalAnd:
+    if (leftOperand.hasType(ValueType::Undefined))
+    {
+      return Value::Undefined;
+    }
+    if (
+      leftOperand.hasType(ValueType::Boolean, ValueType::Null)
+      && !leftOperand.convertTo(ValueType::Boolean).booleanValue())
+    {
+      return Value{false};
+    }
+    return std::nullopt;
+  case BinaryOperator::LogicalOr:
+    if (leftOperand.hasType(ValueType::Undefined))
+    {
+      return Value::Undefined;
+    }
+    if (
+      leftOperand.hasType(ValueType::Boolean, ValueType::Null)
+      && leftOperand.convertTo(ValueType::Boolean).booleanValue())
+    {
+      return Value{true};
+    }
+    return std::nullopt;
+  case BinaryOperator::Case:
+    if (
+      leftOperand.hasType(ValueType::Undefined)
+      || !leftOperand.convertTo(ValueType::Boolean).booleanValue())
+    {
+      return Value::Undefined;
+    }
+    return std::nullopt;
+  case BinaryOperator::Addition:
+  case BinaryOperator::Subtraction:
+  case BinaryOperator::Multiplication:
+  case BinaryOperator::Division:
+  case BinaryOperator::Modulus:
+  case BinaryOperator::BitwiseAnd:
+  case BinaryOperator::BitwiseXOr:
+  case BinaryOperator::BitwiseOr:
+  case BinaryOperator::BitwiseShiftLeft:
+  case BinaryOperator::BitwiseShiftRight:
+  case BinaryOperator::Less:
+  case BinaryOperator::LessOrEqual:
+  case BinaryOperator::Greater:
+  case BinaryOperator::GreaterOrEqual:
+  case BinaryOperator::Equal:
+  case BinaryOperator::NotEqual:
+  case BinaryOperator::Range:
+    return std::nullopt;
+    switchDefault();
+  };
+}
+
 Value BinaryExpression::evaluate(const EvaluationContext& context) const
 {
   return evaluateBinaryExpression(
@@ -1147,6 +1238,52 @@ std::unique_ptr<ExpressionImpl> BinaryExpression::optimize() const
     std::move(optimizedRightOperand).value_or(m_rightOperand.optimize()));
 }
 
+void BinaryExpression::compile(ExpressionCompiler& compiler) const
+{
+  compiler.compile(m_leftOperand);
+
+  switch (m_operator)
+  {
+  case BinaryOperator::LogicalAnd:
+  case BinaryOperator::LogicalOr: {
+    const auto jump = compiler.emitJumpIfShortCircuit(m_operator);
+    compiler.compile(m_rightOperand);
+    compiler.emitBinaryOperation(m_operator);
+    compiler.patchJump(jump);
+    break;
+  }
+  case BinaryOperator::Case: {
+    // if the left operand does not short circuit, the right operand is the result
+    const auto jump = compiler.emitJumpIfShortCircuit(m_operator);
+    compiler.emitPop();
+    compiler.compile(m_rightOperand);
+    compiler.patchJump(jump);
+    break;
+  }
+  case BinaryOperator::Addition:
+  case BinaryOperator::Subtraction:
+  case BinaryOperator::Multiplication:
+  case BinaryOperator::Division:
+  case BinaryOperator::Modulus:
+  case BinaryOperator::BitwiseAnd:
+  case BinaryOperator::BitwiseXOr:
+  case BinaryOperator::BitwiseOr:
+  case BinaryOperator::BitwiseShiftLeft:
+  case BinaryOperator::BitwiseShiftRight:
+  case BinaryOperator::Less:
+  case BinaryOperator::LessOrEqual:
+  case BinaryOperator::Greater:
+  case BinaryOperator::GreaterOrEqual:
+  case BinaryOperator::Equal:
+  case BinaryOperator::NotEqual:
+  case BinaryOperator::Range:
+    compiler.compile(m_rightOperand);
+    compiler.emitBinaryOperation(m_operator);
+    break;
+    switchDefault();
+  };
+}
+
 size_t BinaryExpression::precedence() const
 {
   switch (m_operator)
@@ -1315,6 +1452,14 @@ std::unique_ptr<ExpressionImpl> SubscriptExpression::optimize() const
     std::move(optimizedLeftOperand), std::move(optimizedRightOperand));
 }
 
+void SubscriptExpression::compile(ExpressionCompiler& compiler) const
+{
+  compiler.compile(m_leftOperand);
+  compiler.emitBeginSubscript();
+  compiler.compile(m_rightOperand);
+  compiler.emitEndSubscript();
+}
+
 bool SubscriptExpression::operator==(const ExpressionImpl& rhs) const
 {
   return rhs == *this;
@@ -1365,6 +1510,25 @@ std::unique_ptr<ExpressionImpl> SwitchExpression::optimize() const
   return std::make_unique<SwitchExpression>(std::move(optimizedExpressions));
 }
 
+void SwitchExpression::compile(ExpressionCompiler& compiler) const
+{
+  auto jumps = std::vector<size_t>{};
+  jumps.reserve(m_cases.size());
+
+  for (const auto& case_ : m_cases)
+  {
+    compiler.compile(case_);
+    jumps.push_back(compiler.emitJumpIfDefined());
+    compiler.emitPop();
+  }
+  compiler.emitLiteral(Value::Undefined);
+
+  for (const auto jump : jumps)
+  {
+    compiler.patchJump(jump);
+  }
+}
+
 bool SwitchExpression::operator==(const ExpressionImpl& rhs) const
 {
   return rhs == *this;
@@ -1390,5 +1554,25 @@ void SwitchExpression::appendToStream(std::ostream& str) const
   }
   str << " }}";
 }
+
+void appendArrayElement(ArrayType& array, Value value)
+{
+  if (value.hasType(ValueType::Range))
+  {
+    const auto& range = value.rangeValue();
+    if (!range.empty())
+    {
+      array.reserve(array.size() + range.size() - 1u);
+      for (size_t i = 0u; i < range.size(); ++i)
+      {
+        array.emplace_back(range[i], value.expression());
+      }
+    }
+  }
+  else
+  {
+    array.push_back(std::move(value));
+  }
+}
 } // namespace EL
 } // namespace TrenchBroom
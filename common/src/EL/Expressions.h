@@ -25,6 +25,7 @@
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -39,6 +40,7 @@ public:
 
   virtual Value evaluate(const EvaluationContext& context) const = 0;
   virtual std::unique_ptr<ExpressionImpl> optimize() const = 0;
+  virtual void compile(ExpressionCompiler& compiler) const = 0;
 
   virtual size_t precedence() const;
 
@@ -70,6 +72,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   bool operator==(const ExpressionImpl& rhs) const override;
   bool operator==(const LiteralExpression& rhs) const override;
@@ -88,6 +91,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   bool operator==(const ExpressionImpl& rhs) const override;
   bool operator==(const VariableExpression& rhs) const override;
@@ -106,6 +110,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   bool operator==(const ExpressionImpl& rhs) const override;
   bool operator==(const ArrayExpression& rhs) const override;
@@ -124,6 +129,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   bool operator==(const ExpressionImpl& rhs) const override;
   bool operator==(const MapExpression& rhs) const override;
@@ -152,6 +158,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   bool operator==(const ExpressionImpl& rhs) const override;
   bool operator==(const UnaryExpression& rhs) const override;
@@ -204,6 +211,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   size_t precedence() const override;
 
@@ -228,6 +236,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   bool operator==(const ExpressionImpl& rhs) const override;
   bool operator==(const SubscriptExpression& rhs) const override;
@@ -246,6 +255,7 @@ public:
 
   Value evaluate(const EvaluationContext& context) const override;
   std::unique_ptr<ExpressionImpl> optimize() const override;
+  void compile(ExpressionCompiler& compiler) const override;
 
   bool operator==(const ExpressionImpl& rhs) const override;
   bool operator==(const SwitchExpression& rhs) const override;
@@ -253,5 +263,21 @@ public:
 private:
   void appendToStream(std::ostream& str) const override;
 };
+
+/**
+ * Appends the given value to the given array. Ranges are expanded into their elements.
+ */
+void appendArrayElement(ArrayType& array, Value value);
+
+Value evaluateUnaryOperator(UnaryOperator operator_, const Value& operand);
+Value evaluateBinaryOperator(
+  BinaryOperator operator_, const Value& leftOperand, const Value& rightOperand);
+
+/**
+ * Returns the value of a binary expression with the given operator and left operand if
+ * it does not depend on the right operand, and an empty optional otherwise.
+ */
+std::optional<Value> evaluateShortCircuit(
+  BinaryOperator operator_, const Value& leftOperand);
 } // namespace EL
 } // namespace TrenchBroom
@@ -55,16 +55,19 @@ public:
 class Value
 {
 private:
+  // Booleans, strings, numbers, null and undefined are stored inline so that creating
+  // and copying them does not allocate (short strings fit into the string's own buffer).
+  // Arrays, maps and ranges are shared between copies.
   using VariantType = std::variant<
     BooleanType,
     StringType,
     NumberType,
-    ArrayType,
-    MapType,
-    RangeType,
+    std::shared_ptr<const ArrayType>,
+    std::shared_ptr<const MapType>,
+    std::shared_ptr<const RangeType>,
     NullType,
     UndefinedType>;
-  std::shared_ptr<VariantType> m_value;
+  VariantType m_value;
   std::optional<Expression> m_expression;
 
 public:
@@ -142,6 +145,13 @@ public:
   friend bool operator!=(const Value& lhs, const Value& rhs);
 
   friend std::ostream& operator<<(std::ostream& lhs, const Value& rhs);
+
+private:
+  template <typename Visitor>
+  decltype(auto) visit(const Visitor& visitor) const;
+
+  template <typename Visitor>
+  static decltype(auto) visit(const Visitor& visitor, const Value& lhs, const Value& rhs);
 };
 } // namespace EL
 } // namespace TrenchBroom
@@ -0,0 +1,142 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BinaryCache.h"
+
+#include "IO/ReaderException.h"
+#include "Logger.h"
+
+#include <ostream>
+
+namespace TrenchBroom
+{
+namespace IO
+{
+namespace BinaryCache
+{
+namespace
+{
+LogLevel readLogLevel(Reader& reader)
+{
+  const auto level = static_cast<LogLevel>(read<std::uint8_t>(reader));
+  switch (level)
+  {
+  case LogLevel::Debug:
+  case LogLevel::Info:
+  case LogLevel::Warn:
+  case LogLevel::Error:
+    return level;
+  }
+  throw ReaderException{"Unknown log level"};
+}
+} // namespace
+
+std::string beginCache(const std::string_view magic, const std::uint32_t version)
+{
+  auto buffer = std::string{magic};
+  write(buffer, version);
+  return buffer;
+}
+
+void endCache(std::string& buffer, const std::string_view magic, std::ostream& stream)
+{
+  buffer.append(magic);
+  stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+void writeSize(std::string& buffer, const size_t size)
+{
+  write(buffer, static_cast<std::uint64_t>(size));
+}
+
+void writeFlag(std::string& buffer, const bool flag)
+{
+  write(buffer, static_cast<std::uint8_t>(flag));
+}
+
+void writeString(std::string& buffer, const std::string_view str)
+{
+  writeSize(buffer, str.size());
+  buffer.append(str);
+}
+
+void writeMessages(
+  std::string& buffer, const std::vector<CollectingParserStatus::Message>& messages)
+{
+  writeSize(buffer, messages.size());
+  for (const auto& [level, message] : messages)
+  {
+    write(buffer, static_cast<std::uint8_t>(level));
+    writeString(buffer, message);
+  }
+}
+
+bool readHeader(Reader& reader, const std::string_view magic, const std::uint32_t version)
+{
+  return reader.readString(magic.size()) == magic
+         && read<std::uint32_t>(reader) == version;
+}
+
+bool readTrailer(Reader& reader, const std::string_view magic)
+{
+  return reader.readString(magic.size()) == magic && reader.eof();
+}
+
+size_t readSize(Reader& reader)
+{
+  return reader.read<std::uint64_t, size_t>();
+}
+
+size_t readCount(Reader& reader)
+{
+  const auto count = readSize(reader);
+  if (!reader.canRead(count))
+  {
+    throw ReaderException{"Invalid element count"};
+  }
+  return count;
+}
+
+bool readFlag(Reader& reader)
+{
+  return read<std::uint8_t>(reader) != 0;
+}
+
+std::string readString(Reader& reader)
+{
+  auto str = std::string(readCount(reader), '\0');
+  reader.read(str.data(), str.size());
+  return str;
+}
+
+std::vector<CollectingParserStatus::Message> readMessages(Reader& reader)
+{
+  auto messages = std::vector<CollectingParserStatus::Message>{};
+  const auto messageCount = readCount(reader);
+  messages.reserve(messageCount);
+  for (size_t i = 0; i < messageCount; ++i)
+  {
+    const auto level = readLogLevel(reader);
+    messages.emplace_back(level, readString(reader));
+  }
+  return messages;
+}
+} // namespace BinaryCache
+} // namespace IO
+} // namespace TrenchBroom
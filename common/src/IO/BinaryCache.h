@@ -0,0 +1,107 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/CollectingParserStatus.h"
+#include "IO/Reader.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace IO
+{
+/**
+ * Functions for writing and reading the binary cache files of the map cache, the entity
+ * definition cache, the shader cache and the shader program cache.
+ *
+ * A cache starts with a magic string identifying the kind of cache and a format version,
+ * followed by the cached data and the magic string again. The magic string at the end
+ * allows detecting truncated caches. Values are stored in the native byte order, so a
+ * cache is only meant to be read on the machine that wrote it.
+ *
+ * The write functions append to a buffer which is written to a stream at once by
+ * endCache. The read functions throw a ReaderException if the cache is malformed.
+ */
+namespace BinaryCache
+{
+/**
+ * Returns a buffer containing the header of a cache with the given magic string and
+ * version.
+ */
+std::string beginCache(std::string_view magic, std::uint32_t version);
+
+/**
+ * Appends the trailer of a cache with the given magic string to the given buffer and
+ * writes the buffer to the given stream.
+ */
+void endCache(std::string& buffer, std::string_view magic, std::ostream& stream);
+
+template <typename T>
+void write(std::string& buffer, const T value)
+{
+  static_assert(std::is_arithmetic_v<T>, "value must be arithmetic");
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeSize(std::string& buffer, size_t size);
+void writeFlag(std::string& buffer, bool flag);
+void writeString(std::string& buffer, std::string_view str);
+void writeMessages(
+  std::string& buffer, const std::vector<CollectingParserStatus::Message>& messages);
+
+/**
+ * Reads the header of a cache and returns whether it has the given magic string and
+ * version.
+ */
+bool readHeader(Reader& reader, std::string_view magic, std::uint32_t version);
+
+/**
+ * Reads the trailer of a cache and returns whether it has the given magic string and
+ * ends the cache.
+ */
+bool readTrailer(Reader& reader, std::string_view magic);
+
+template <typename T>
+T read(Reader& reader)
+{
+  static_assert(std::is_arithmetic_v<T>, "value must be arithmetic");
+  return reader.read<T, T>();
+}
+
+size_t readSize(Reader& reader);
+
+/**
+ * Reads a count of elements that take at least one byte each. Checking it against the
+ * remaining size prevents huge allocations for malformed caches.
+ */
+size_t readCount(Reader& reader);
+
+bool readFlag(Reader& reader);
+std::string readString(Reader& reader);
+std::vector<CollectingParserStatus::Message> readMessages(Reader& reader);
+} // namespace BinaryCache
+} // namespace IO
+} // namespace TrenchBroom
@@ -0,0 +1,65 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CollectingParserStatus.h"
+
+#include <string>
+
+namespace TrenchBroom
+{
+namespace IO
+{
+CollectingParserStatus::CollectingParserStatus(Logger& logger, const std::string& prefix)
+  : ParserStatus{logger, prefix}
+{
+}
+
+CollectingParserStatus::CollectingParserStatus(const ParserStatus& status)
+  : ParserStatus{status.m_logger, status.m_prefix}
+{
+}
+
+const std::vector<CollectingParserStatus::Message>& CollectingParserStatus::messages()
+  const&
+{
+  return m_messages;
+}
+
+std::vector<CollectingParserStatus::Message> CollectingParserStatus::messages() &&
+{
+  return std::move(m_messages);
+}
+
+void CollectingParserStatus::logMessages(
+  ParserStatus& status, const std::vector<Message>& messages)
+{
+  for (const auto& [level, str] : messages)
+  {
+    status.doLog(level, str);
+  }
+}
+
+void CollectingParserStatus::doProgress(const double /* progress */) {}
+
+void CollectingParserStatus::doLog(const LogLevel level, const std::string& str)
+{
+  m_messages.emplace_back(level, str);
+}
+} // namespace IO
+} // namespace TrenchBroom
@@ -0,0 +1,66 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/ParserStatus.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace IO
+{
+/**
+ * Collects the messages logged during parsing instead of logging them. This allows
+ * parsing on a worker thread and logging the messages on the calling thread afterwards.
+ * Progress is ignored.
+ */
+class CollectingParserStatus : public ParserStatus
+{
+public:
+  using Message = std::tuple<LogLevel, std::string>;
+
+private:
+  std::vector<Message> m_messages;
+
+public:
+  CollectingParserStatus(Logger& logger, const std::string& prefix);
+
+  /**
+   * Creates a status that formats its messages like the given status.
+   */
+  explicit CollectingParserStatus(const ParserStatus& status);
+
+  const std::vector<Message>& messages() const&;
+  std::vector<Message> messages() &&;
+
+  /**
+   * Logs the given messages, which are already formatted, to the given status.
+   */
+  static void logMessages(ParserStatus& status, const std::vector<Message>& messages);
+
+private:
+  void doProgress(double progress) override;
+  void doLog(LogLevel level, const std::string& str) override;
+};
+} // namespace IO
+} // namespace TrenchBroom
@@ -183,7 +183,7 @@ DefParser::TokenNameMap DefParser::tokenNames() const
   return names;
 }
 
-std::vector<EntityDefinitionClassInfo> DefParser::parseClassInfos(ParserStatus& status)
+std::vector<EntityDefinitionClassInfo> DefParser::doParseClassInfos(ParserStatus& status)
 {
   std::vector<EntityDefinitionClassInfo> result;
 
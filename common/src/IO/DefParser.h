@@ -82,7 +82,7 @@ public:
 
 private:
   TokenNameMap tokenNames() const override;
-  std::vector<EntityDefinitionClassInfo> parseClassInfos(ParserStatus& status) override;
+  std::vector<EntityDefinitionClassInfo> doParseClassInfos(ParserStatus& status) override;
 
   std::optional<EntityDefinitionClassInfo> parseClassInfo(ParserStatus& status);
   PropertyDefinitionPtr parseSpawnflags(ParserStatus& status);
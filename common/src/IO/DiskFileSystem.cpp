@@ -24,6 +24,8 @@
 #include "IO/DiskIO.h"
 #include "IO/File.h"
 
+#include <kdl/vector_utils.h>
+
 #include <memory>
 #include <string>
 
@@ -78,6 +80,15 @@ std::vector<Path> DiskFileSystem::doGetDirectoryContents(const Path& path) const
   return Disk::getDirectoryContents(doMakeAbsolute(path));
 }
 
+std::vector<std::pair<Path, bool>> DiskFileSystem::doFindAllItems(
+  const Path& searchPath, const bool recurse) const
+{
+  return kdl::vec_transform(
+    Disk::findAllItems(doMakeAbsolute(searchPath), recurse), [&](const auto& item) {
+      return std::make_pair(searchPath + item.first, item.second);
+    });
+}
+
 std::shared_ptr<File> DiskFileSystem::doOpenFile(const Path& path) const
 {
   auto file = Disk::openFile(doMakeAbsolute(path));
@@ -24,6 +24,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -51,6 +53,8 @@ protected:
   bool doFileExists(const Path& path) const override;
 
   std::vector<Path> doGetDirectoryContents(const Path& path) const override;
+  std::vector<std::pair<Path, bool>> doFindAllItems(
+    const Path& searchPath, bool recurse) const override;
   std::shared_ptr<File> doOpenFile(const Path& path) const override;
 };
 
@@ -25,13 +25,21 @@
 #include "IO/IOUtils.h"
 #include "IO/PathQt.h"
 
+#include <kdl/parallel.h>
 #include <kdl/string_compare.h>
+#include <kdl/vector_utils.h>
 
+#include <algorithm>
+#include <exception>
 #include <fstream>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
+#include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
+#include <QSaveFile>
 
 namespace TrenchBroom
 {
@@ -39,6 +47,77 @@ namespace IO
 {
 namespace Disk
 {
+namespace
+{
+struct DirectoryListing
+{
+  QDateTime lastModified;
+  std::vector<std::pair<Path, bool>> entries;
+};
+
+/**
+ * A directory listing is only cached if the directory was last modified at least this
+ * many milliseconds before it was read. Otherwise, a change made within the timestamp
+ * granularity of the file system could go unnoticed.
+ */
+constexpr qint64 MinCachedListingAge = 2000;
+
+std::mutex directoryListingCacheMutex;
+std::unordered_map<std::string, DirectoryListing> directoryListingCache;
+
+void invalidateDirectoryListing(const Path& fixedPath)
+{
+  const auto lock = std::lock_guard<std::mutex>{directoryListingCacheMutex};
+  directoryListingCache.erase(fixedPath.asString());
+}
+
+/**
+ * Returns the names of the items in the given directory, each paired with a flag
+ * indicating whether the item is a directory. The given path must already be fixed.
+ *
+ * This function is thread safe.
+ */
+std::vector<std::pair<Path, bool>> readDirectory(const Path& fixedPath)
+{
+  const auto qPath = pathAsQString(fixedPath);
+  auto dir = QDir{qPath};
+  if (!dir.exists())
+  {
+    throw FileSystemException("Cannot open directory: '" + fixedPath.asString() + "'");
+  }
+
+  const auto key = fixedPath.asString();
+  const auto lastModified = QFileInfo{qPath}.lastModified();
+  {
+    const auto lock = std::lock_guard<std::mutex>{directoryListingCacheMutex};
+    const auto it = directoryListingCache.find(key);
+    if (it != std::end(directoryListingCache) && it->second.lastModified == lastModified)
+    {
+      return it->second.entries;
+    }
+  }
+
+  dir.setFilter(QDir::NoDotAndDotDot | QDir::AllEntries);
+
+  auto entries = std::vector<std::pair<Path, bool>>{};
+  for (const auto& fileInfo : dir.entryInfoList())
+  {
+    entries.emplace_back(pathFromQString(fileInfo.fileName()), fileInfo.isDir());
+  }
+
+  const auto lock = std::lock_guard<std::mutex>{directoryListingCacheMutex};
+  if (lastModified.msecsTo(QDateTime::currentDateTime()) >= MinCachedListingAge)
+  {
+    directoryListingCache[key] = DirectoryListing{lastModified, entries};
+  }
+  else
+  {
+    directoryListingCache.erase(key);
+  }
+  return entries;
+}
+} // namespace
+
 bool doCheckCaseSensitive();
 Path findCaseSensitivePath(const std::vector<Path>& list, const Path& path);
 Path fixCase(const Path& path);
@@ -142,19 +221,68 @@ bool fileExists(const Path& path)
 std::vector<Path> getDirectoryContents(const Path& path)
 {
   const Path fixedPath = fixPath(path);
-  QDir dir(pathAsQString(fixedPath));
-  if (!dir.exists())
-  {
-    throw FileSystemException("Cannot open directory: '" + fixedPath.asString() + "'");
-  }
+  return kdl::vec_transform(
+    readDirectory(fixedPath), [](const auto& entry) { return entry.first; });
+}
 
-  dir.setFilter(QDir::NoDotAndDotDot | QDir::AllEntries);
+std::vector<std::pair<Path, bool>> findAllItems(const Path& path, const bool recurse)
+{
+  const Path fixedPath = fixPath(path);
+
+  auto result = std::vector<std::pair<Path, bool>>{};
 
-  std::vector<Path> result;
-  for (QString& entry : dir.entryList())
+  // walk the directory tree level by level, reading the directories of each level in
+  // parallel
+  auto directories = std::vector<Path>{Path{}};
+  while (!directories.empty())
   {
-    result.push_back(pathFromQString(entry));
+    auto listings = std::vector<std::vector<std::pair<Path, bool>>>(directories.size());
+    auto errors = std::vector<std::exception_ptr>(directories.size());
+
+    const auto readListing = [&](const size_t i) {
+      try
+      {
+        listings[i] = readDirectory(fixedPath + directories[i]);
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+    };
+
+    if (directories.size() == 1)
+    {
+      readListing(0);
+    }
+    else
+    {
+      kdl::parallel_for(directories.size(), readListing);
+    }
+
+    auto subDirectories = std::vector<Path>{};
+    for (size_t i = 0; i < directories.size(); ++i)
+    {
+      if (errors[i])
+      {
+        std::rethrow_exception(errors[i]);
+      }
+
+      for (const auto& [name, directory] : listings[i])
+      {
+        auto itemPath = directories[i] + name;
+        if (directory && recurse)
+        {
+          subDirectories.push_back(itemPath);
+        }
+        result.emplace_back(std::move(itemPath), directory);
+      }
+    }
+    directories = std::move(subDirectories);
   }
+
+  std::sort(std::begin(result), std::end(result), [](const auto& lhs, const auto& rhs) {
+    return lhs.first < rhs.first;
+  });
   return result;
 }
 
@@ -214,6 +342,24 @@ void createFile(const Path& path, const std::string& contents)
 
   std::ofstream stream = openPathAsOutputStream(fixedPath);
   stream << contents;
+  invalidateDirectoryListing(fixedPath.deleteLastComponent());
+}
+
+void createFileAtomically(const Path& path, const std::string& contents)
+{
+  const auto fixedPath = fixPath(path);
+  const auto directory = fixedPath.deleteLastComponent();
+  ensureDirectoryExists(directory);
+
+  const auto size = static_cast<qint64>(contents.size());
+  auto file = QSaveFile{pathAsQString(fixedPath)};
+  if (
+    !file.open(QIODevice::WriteOnly) || file.write(contents.data(), size) != size
+    || !file.commit())
+  {
+    throw FileSystemException{"Could not write file '" + fixedPath.asString() + "'"};
+  }
+  invalidateDirectoryListing(directory);
 }
 
 bool createDirectoryHelper(const Path& path);
@@ -241,6 +387,7 @@ bool createDirectoryHelper(const Path& path)
   const IO::Path parent = path.deleteLastComponent();
   if (!QDir(pathAsQString(parent)).exists() && !createDirectoryHelper(parent))
     return false;
+  invalidateDirectoryListing(parent);
   return QDir().mkdir(pathAsQString(path));
 }
 
@@ -261,6 +408,7 @@ void deleteFile(const Path& path)
   if (!fileExists(fixedPath))
     throw FileSystemException(
       "Could not delete file '" + fixedPath.asString() + "': File does not exist.");
+  invalidateDirectoryListing(fixedPath.deleteLastComponent());
   if (!QFile::remove(pathAsQString(fixedPath)))
     throw FileSystemException("Could not delete file '" + path.asString() + "'");
 }
@@ -287,6 +435,7 @@ void copyFile(const Path& sourcePath, const Path& destPath, const bool overwrite
         + fixedDestPath.asString() + "': couldn't remove destination");
     }
   }
+  invalidateDirectoryListing(fixedDestPath.deleteLastComponent());
   // NOTE: QFile::copy will not overwrite the dest
   if (!QFile::copy(pathAsQString(fixedSourcePath), pathAsQString(fixedDestPath)))
     throw FileSystemException(
@@ -314,6 +463,8 @@ void moveFile(const Path& sourcePath, const Path& destPath, const bool overwrite
   }
   if (directoryExists(fixedDestPath))
     fixedDestPath = fixedDestPath + sourcePath.lastComponent();
+  invalidateDirectoryListing(fixedSourcePath.deleteLastComponent());
+  invalidateDirectoryListing(fixedDestPath.deleteLastComponent());
   if (!QFile::rename(pathAsQString(fixedSourcePath), pathAsQString(fixedDestPath)))
     throw FileSystemException(
       "Could not move file '" + fixedSourcePath.asString() + "' to '"
@@ -23,6 +23,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -44,15 +46,29 @@ std::shared_ptr<File> openFile(const Path& path);
 std::string readTextFile(const Path& path);
 Path getCurrentWorkingDir();
 
+/**
+ * Returns the items in the given directory, and optionally the items in all of its sub
+ * directories, each paired with a flag indicating whether the item is a directory.
+ *
+ * The returned paths are relative to the given directory and sorted. When recursing,
+ * the sub directories at the same depth are read in parallel. Directory listings are
+ * cached and revalidated against the modification time of the directory.
+ *
+ * @param path the path of the directory to search
+ * @param recurse whether or not to recurse into sub directories
+ * @return the items and whether they are directories
+ *
+ * @throws FileSystemException if the given directory or one of its sub directories
+ * cannot be read
+ */
+std::vector<std::pair<Path, bool>> findAllItems(const Path& path, bool recurse);
+
 template <class M>
 void doFindItems(
   const Path& searchPath, const M& matcher, const bool recurse, std::vector<Path>& result)
 {
-  for (const Path& itemPath : getDirectoryContents(searchPath))
+  for (const auto& [itemPath, directory] : findAllItems(searchPath, recurse))
   {
-    const bool directory = directoryExists(searchPath + itemPath);
-    if (directory && recurse)
-      doFindItems(searchPath + itemPath, matcher, recurse, result);
     if (matcher(searchPath + itemPath, directory))
       result.push_back(searchPath + itemPath);
   }
@@ -79,6 +95,17 @@ std::vector<Path> findItemsRecursively(const Path& path, const M& matcher)
 std::vector<Path> findItemsRecursively(const Path& path);
 
 void createFile(const Path& path, const std::string& contents);
+
+/**
+ * Writes the given contents to the file at the given path and creates the containing
+ * directory if necessary. The contents are written to a temporary file which then
+ * replaces the file at the given path, so that the file is never left incomplete, even
+ * if the process dies or another process writes the same file at the same time.
+ *
+ * @throws FileSystemException if the file cannot be written
+ */
+void createFileAtomically(const Path& path, const std::string& contents);
+
 void createDirectory(const Path& path);
 void ensureDirectoryExists(const Path& path);
 void deleteFile(const Path& path);
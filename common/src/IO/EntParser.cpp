@@ -52,7 +52,7 @@ EntParser::EntParser(std::string_view str, const Color& defaultEntityColor)
 {
 }
 
-std::vector<EntityDefinitionClassInfo> EntParser::parseClassInfos(ParserStatus& status)
+std::vector<EntityDefinitionClassInfo> EntParser::doParseClassInfos(ParserStatus& status)
 {
   tinyxml2::XMLDocument doc;
   doc.Parse(m_begin, static_cast<size_t>(m_end - m_begin));
@@ -70,10 +70,10 @@ std::vector<EntityDefinitionClassInfo> EntParser::parseClassInfos(ParserStatus&
       throw ParserException(lineNum, error);
     }
   }
-  return parseClassInfos(doc, status);
+  return parseClasses(doc, status);
 }
 
-std::vector<EntityDefinitionClassInfo> EntParser::parseClassInfos(
+std::vector<EntityDefinitionClassInfo> EntParser::parseClasses(
   const tinyxml2::XMLDocument& document, ParserStatus& status)
 {
   std::vector<EntityDefinitionClassInfo> result;
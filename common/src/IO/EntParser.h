@@ -64,9 +64,9 @@ public:
   EntParser(std::string_view str, const Color& defaultEntityColor);
 
 private:
-  std::vector<EntityDefinitionClassInfo> parseClassInfos(ParserStatus& status) override;
+  std::vector<EntityDefinitionClassInfo> doParseClassInfos(ParserStatus& status) override;
 
-  std::vector<EntityDefinitionClassInfo> parseClassInfos(
+  std::vector<EntityDefinitionClassInfo> parseClasses(
     const tinyxml2::XMLDocument& document, ParserStatus& status);
   std::optional<EntityDefinitionClassInfo> parseClassInfo(
     const tinyxml2::XMLElement& element,
@@ -0,0 +1,587 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityDefinitionCache.h"
+
+#include "Assets/ModelDefinition.h"
+#include "Assets/PropertyDefinition.h"
+#include "EL/Expression.h"
+#include "EL/Expressions.h"
+#include "Exceptions.h"
+#include "IO/BinaryCache.h"
+#include "IO/ELParser.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+#include "IO/SystemPaths.h"
+
+#include <kdl/string_utils.h>
+
+#include <vecmath/bbox.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace TrenchBroom
+{
+namespace IO
+{
+namespace
+{
+using namespace BinaryCache;
+
+constexpr auto Magic = std::string_view{"TBECACHE"};
+constexpr auto Version = std::uint32_t(2);
+
+enum class ModelDefinitionKind : std::uint8_t
+{
+  None,
+  Undefined,
+  Expression,
+};
+
+/**
+ * Distinguishes the property definition classes. The property definition type is not
+ * sufficient because unknown property definitions have the string property type.
+ */
+enum class PropertyDefinitionKind : std::uint8_t
+{
+  Plain,
+  String,
+  Boolean,
+  Integer,
+  Float,
+  Choice,
+  Flags,
+  Unknown,
+};
+
+template <typename T>
+std::optional<T> defaultValue(
+  const Assets::PropertyDefinitionWithDefaultValue<T>& definition)
+{
+  return definition.hasDefaultValue() ? std::optional<T>{definition.defaultValue()}
+                                      : std::nullopt;
+}
+
+// writing
+
+template <typename T, typename WriteValue>
+void writeOptional(
+  std::string& buffer, const std::optional<T>& value, const WriteValue& writeValue)
+{
+  writeFlag(buffer, value.has_value());
+  if (value)
+  {
+    writeValue(buffer, *value);
+  }
+}
+
+void writeKey(std::string& buffer, const EntityDefinitionCacheKey& key)
+{
+  writeString(buffer, key.path.asString("/"));
+  write(buffer, key.sourceSize);
+  write(buffer, key.sourceHash);
+}
+
+/**
+ * Writes the given model definition and returns true if it can be restored when reading
+ * the cache.
+ */
+bool writeModelDefinition(
+  std::string& buffer, const std::optional<Assets::ModelDefinition>& modelDefinition)
+{
+  if (!modelDefinition)
+  {
+    write(buffer, static_cast<std::uint8_t>(ModelDefinitionKind::None));
+    return true;
+  }
+
+  const auto& expression = modelDefinition->expression();
+  if (expression == EL::Expression{EL::LiteralExpression{EL::Value::Undefined}, 0, 0})
+  {
+    write(buffer, static_cast<std::uint8_t>(ModelDefinitionKind::Undefined));
+    writeSize(buffer, expression.line());
+    writeSize(buffer, expression.column());
+    return true;
+  }
+
+  const auto source = expression.asString();
+  try
+  {
+    if (ELParser::parseStrict(source) != expression)
+    {
+      return false;
+    }
+  }
+  catch (const ParserException&)
+  {
+    return false;
+  }
+
+  write(buffer, static_cast<std::uint8_t>(ModelDefinitionKind::Expression));
+  writeString(buffer, source);
+  writeSize(buffer, expression.line());
+  writeSize(buffer, expression.column());
+  return true;
+}
+
+void writePropertyDefinition(
+  std::string& buffer, const Assets::PropertyDefinition& propertyDefinition)
+{
+  writeString(buffer, propertyDefinition.key());
+  writeString(buffer, propertyDefinition.shortDescription());
+  writeString(buffer, propertyDefinition.longDescription());
+  writeFlag(buffer, propertyDefinition.readOnly());
+
+  const auto writeKind = [&](const auto kind) {
+    write(buffer, static_cast<std::uint8_t>(kind));
+  };
+
+  // unknown property definitions are string property definitions, too
+  if (
+    const auto* unknownDefinition =
+      dynamic_cast<const Assets::UnknownPropertyDefinition*>(&propertyDefinition))
+  {
+    writeKind(PropertyDefinitionKind::Unknown);
+    writeOptional(buffer, defaultValue(*unknownDefinition), writeString);
+  }
+  else if (
+    const auto* stringDefinition =
+      dynamic_cast<const Assets::StringPropertyDefinition*>(&propertyDefinition))
+  {
+    writeKind(PropertyDefinitionKind::String);
+    writeOptional(buffer, defaultValue(*stringDefinition), writeString);
+  }
+  else if (
+    const auto* booleanDefinition =
+      dynamic_cast<const Assets::BooleanPropertyDefinition*>(&propertyDefinition))
+  {
+    writeKind(PropertyDefinitionKind::Boolean);
+    writeOptional(buffer, defaultValue(*booleanDefinition), writeFlag);
+  }
+  else if (
+    const auto* integerDefinition =
+      dynamic_cast<const Assets::IntegerPropertyDefinition*>(&propertyDefinition))
+  {
+    writeKind(PropertyDefinitionKind::Integer);
+    writeOptional(buffer, defaultValue(*integerDefinition), write<int>);
+  }
+  else if (
+    const auto* floatDefinition =
+      dynamic_cast<const Assets::FloatPropertyDefinition*>(&propertyDefinition))
+  {
+    writeKind(PropertyDefinitionKind::Float);
+    writeOptional(buffer, defaultValue(*floatDefinition), write<float>);
+  }
+  else if (
+    const auto* choiceDefinition =
+      dynamic_cast<const Assets::ChoicePropertyDefinition*>(&propertyDefinition))
+  {
+    writeKind(PropertyDefinitionKind::Choice);
+    writeSize(buffer, choiceDefinition->options().size());
+    for (const auto& option : choiceDefinition->options())
+    {
+      writeString(buffer, option.value());
+      writeString(buffer, option.description());
+    }
+    writeOptional(buffer, defaultValue(*choiceDefinition), writeString);
+  }
+  else if (
+    const auto* flagsDefinition =
+      dynamic_cast<const Assets::FlagsPropertyDefinition*>(&propertyDefinition))
+  {
+    writeKind(PropertyDefinitionKind::Flags);
+    writeSize(buffer, flagsDefinition->options().size());
+    for (const auto& option : flagsDefinition->options())
+    {
+      write(buffer, option.value());
+      writeString(buffer, option.shortDescription());
+      writeString(buffer, option.longDescription());
+      writeFlag(buffer, option.isDefault());
+    }
+  }
+  else
+  {
+    writeKind(PropertyDefinitionKind::Plain);
+    write(buffer, static_cast<std::uint8_t>(propertyDefinition.type()));
+  }
+}
+
+bool writeClassInfo(std::string& buffer, const EntityDefinitionClassInfo& classInfo)
+{
+  write(buffer, static_cast<std::uint8_t>(classInfo.type));
+  writeSize(buffer, classInfo.line);
+  writeSize(buffer, classInfo.column);
+  writeString(buffer, classInfo.name);
+
+  writeOptional(buffer, classInfo.description, writeString);
+  writeOptional(buffer, classInfo.color, [](auto& b, const auto& color) {
+    write(b, color.r());
+    write(b, color.g());
+    write(b, color.b());
+    write(b, color.a());
+  });
+  writeOptional(buffer, classInfo.size, [](auto& b, const auto& size) {
+    for (size_t i = 0; i < 3; ++i)
+    {
+      write(b, size.min[i]);
+    }
+    for (size_t i = 0; i < 3; ++i)
+    {
+      write(b, size.max[i]);
+    }
+  });
+  if (!writeModelDefinition(buffer, classInfo.modelDefinition))
+  {
+    return false;
+  }
+
+  writeSize(buffer, classInfo.propertyDefinitions.size());
+  for (const auto& propertyDefinition : classInfo.propertyDefinitions)
+  {
+    writePropertyDefinition(buffer, *propertyDefinition);
+  }
+
+  writeSize(buffer, classInfo.superClasses.size());
+  for (const auto& superClass : classInfo.superClasses)
+  {
+    writeString(buffer, superClass);
+  }
+
+  return true;
+}
+
+// reading
+
+template <typename ReadValue>
+auto readOptional(Reader& reader, const ReadValue& readValue)
+  -> std::optional<decltype(readValue(reader))>
+{
+  if (readFlag(reader))
+  {
+    return readValue(reader);
+  }
+  return std::nullopt;
+}
+
+EntityDefinitionCacheKey readKey(Reader& reader)
+{
+  auto path = Path{readString(reader)};
+  const auto sourceSize = read<std::uint64_t>(reader);
+  const auto sourceHash = read<std::uint64_t>(reader);
+  return EntityDefinitionCacheKey{std::move(path), sourceSize, sourceHash};
+}
+
+std::optional<Assets::ModelDefinition> readModelDefinition(Reader& reader)
+{
+  switch (static_cast<ModelDefinitionKind>(read<std::uint8_t>(reader)))
+  {
+  case ModelDefinitionKind::None:
+    return std::nullopt;
+  case ModelDefinitionKind::Undefined: {
+    const auto line = readSize(reader);
+    const auto column = readSize(reader);
+    return Assets::ModelDefinition{line, column};
+  }
+  case ModelDefinitionKind::Expression: {
+    const auto source = readString(reader);
+    const auto line = readSize(reader);
+    const auto column = readSize(reader);
+    auto parser = ELParser{ELParser::Mode::Strict, source, line, column};
+    return Assets::ModelDefinition{parser.parse()};
+  }
+  }
+  throw ReaderException{"Unknown model definition kind"};
+}
+
+Assets::PropertyDefinitionType readPropertyDefinitionType(Reader& reader)
+{
+  const auto type =
+    static_cast<Assets::PropertyDefinitionType>(read<std::uint8_t>(reader));
+  switch (type)
+  {
+  case Assets::PropertyDefinitionType::TargetSourceProperty:
+  case Assets::PropertyDefinitionType::TargetDestinationProperty:
+  case Assets::PropertyDefinitionType::StringProperty:
+  case Assets::PropertyDefinitionType::BooleanProperty:
+  case Assets::PropertyDefinitionType::IntegerProperty:
+  case Assets::PropertyDefinitionType::FloatProperty:
+  case Assets::PropertyDefinitionType::ChoiceProperty:
+  case Assets::PropertyDefinitionType::FlagsProperty:
+    return type;
+  }
+  throw ReaderException{"Unknown property definition type"};
+}
+
+std::shared_ptr<Assets::PropertyDefinition> readPropertyDefinition(Reader& reader)
+{
+  auto key = readString(reader);
+  auto shortDescription = readString(reader);
+  auto longDescription = readString(reader);
+  const auto readOnly = readFlag(reader);
+
+  switch (static_cast<PropertyDefinitionKind>(read<std::uint8_t>(reader)))
+  {
+  case PropertyDefinitionKind::Plain: {
+    const auto type = readPropertyDefinitionType(reader);
+    return std::make_shared<Assets::PropertyDefinition>(
+      key, type, shortDescription, longDescription, readOnly);
+  }
+  case PropertyDefinitionKind::String:
+    return std::make_shared<Assets::StringPropertyDefinition>(
+      key,
+      shortDescription,
+      longDescription,
+      readOnly,
+      readOptional(reader, readString));
+  case PropertyDefinitionKind::Boolean:
+    return std::make_shared<Assets::BooleanPropertyDefinition>(
+      key, shortDescription, longDescription, readOnly, readOptional(reader, readFlag));
+  case PropertyDefinitionKind::Integer:
+    return std::make_shared<Assets::IntegerPropertyDefinition>(
+      key,
+      shortDescription,
+      longDescription,
+      readOnly,
+      readOptional(reader, read<int>));
+  case PropertyDefinitionKind::Float:
+    return std::make_shared<Assets::FloatPropertyDefinition>(
+      key,
+      shortDescription,
+      longDescription,
+      readOnly,
+      readOptional(reader, read<float>));
+  case PropertyDefinitionKind::Choice: {
+    auto options = Assets::ChoicePropertyOption::List{};
+    const auto optionCount = readCount(reader);
+    options.reserve(optionCount);
+    for (size_t i = 0; i < optionCount; ++i)
+    {
+      auto value = readString(reader);
+      auto description = readString(reader);
+      options.emplace_back(value, description);
+    }
+    return std::make_shared<Assets::ChoicePropertyDefinition>(
+      key,
+      shortDescription,
+      longDescription,
+      options,
+      readOnly,
+      readOptional(reader, readString));
+  }
+  case PropertyDefinitionKind::Flags: {
+    auto definition = std::make_shared<Assets::FlagsPropertyDefinition>(key);
+    const auto optionCount = readCount(reader);
+    for (size_t i = 0; i < optionCount; ++i)
+    {
+      const auto value = read<int>(reader);
+      auto optionShortDescription = readString(reader);
+      auto optionLongDescription = readString(reader);
+      const auto isDefault = readFlag(reader);
+      definition->addOption(
+        value, optionShortDescription, optionLongDescription, isDefault);
+    }
+    return definition;
+  }
+  case PropertyDefinitionKind::Unknown:
+    return std::make_shared<Assets::UnknownPropertyDefinition>(
+      key,
+      shortDescription,
+      longDescription,
+      readOnly,
+      readOptional(reader, readString));
+  }
+  throw ReaderException{"Unknown property definition kind"};
+}
+
+EntityDefinitionClassType readClassType(Reader& reader)
+{
+  const auto type = static_cast<EntityDefinitionClassType>(read<std::uint8_t>(reader));
+  switch (type)
+  {
+  case EntityDefinitionClassType::PointClass:
+  case EntityDefinitionClassType::BrushClass:
+  case EntityDefinitionClassType::BaseClass:
+    return type;
+  }
+  throw ReaderException{"Unknown entity definition class type"};
+}
+
+EntityDefinitionClassInfo readClassInfo(Reader& reader)
+{
+  auto classInfo = EntityDefinitionClassInfo{};
+  classInfo.type = readClassType(reader);
+  classInfo.line = readSize(reader);
+  classInfo.column = readSize(reader);
+  classInfo.name = readString(reader);
+
+  classInfo.description = readOptional(reader, readString);
+  classInfo.color = readOptional(reader, [](auto& r) {
+    const auto red = read<float>(r);
+    const auto green = read<float>(r);
+    const auto blue = read<float>(r);
+    const auto alpha = read<float>(r);
+    return Color{red, green, blue, alpha};
+  });
+  classInfo.size = readOptional(reader, [](auto& r) {
+    auto size = vm::bbox3{};
+    for (size_t i = 0; i < 3; ++i)
+    {
+      size.min[i] = read<FloatType>(r);
+    }
+    for (size_t i = 0; i < 3; ++i)
+    {
+      size.max[i] = read<FloatType>(r);
+    }
+    return size;
+  });
+  classInfo.modelDefinition = readModelDefinition(reader);
+
+  const auto propertyDefinitionCount = readCount(reader);
+  classInfo.propertyDefinitions.reserve(propertyDefinitionCount);
+  for (size_t i = 0; i < propertyDefinitionCount; ++i)
+  {
+    classInfo.propertyDefinitions.push_back(readPropertyDefinition(reader));
+  }
+
+  const auto superClassCount = readCount(reader);
+  classInfo.superClasses.reserve(superClassCount);
+  for (size_t i = 0; i < superClassCount; ++i)
+  {
+    classInfo.superClasses.push_back(readString(reader));
+  }
+
+  return classInfo;
+}
+
+} // namespace
+
+bool operator==(const EntityDefinitionCacheKey& lhs, const EntityDefinitionCacheKey& rhs)
+{
+  return lhs.path == rhs.path && lhs.sourceSize == rhs.sourceSize
+         && lhs.sourceHash == rhs.sourceHash;
+}
+
+bool operator!=(const EntityDefinitionCacheKey& lhs, const EntityDefinitionCacheKey& rhs)
+{
+  return !(lhs == rhs);
+}
+
+EntityDefinitionCacheKey makeEntityDefinitionCacheKey(
+  const Path& path, const std::string_view source)
+{
+  return EntityDefinitionCacheKey{
+    path,
+    static_cast<std::uint64_t>(source.size()),
+    static_cast<std::uint64_t>(std::hash<std::string_view>{}(source))};
+}
+
+Path entityDefinitionCachePath(const Path& path)
+{
+  const auto pathHash = std::hash<std::string>{}(path.asString());
+  return SystemPaths::userDataDirectory() + Path{"cache/entities"}
+         + Path{kdl::str_to_string(
+           path.lastComponent().asString(), ".", pathHash, ".cache")};
+}
+
+bool writeEntityDefinitionCache(std::ostream& stream, const EntityDefinitionCache& cache)
+{
+  auto buffer = beginCache(Magic, Version);
+
+  writeSize(buffer, cache.keys.size());
+  for (const auto& key : cache.keys)
+  {
+    writeKey(buffer, key);
+  }
+
+  writeSize(buffer, cache.missingFiles.size());
+  for (const auto& missingFile : cache.missingFiles)
+  {
+    writeString(buffer, missingFile.asString("/"));
+  }
+
+  writeSize(buffer, cache.classInfos.size());
+  for (const auto& classInfo : cache.classInfos)
+  {
+    if (!writeClassInfo(buffer, classInfo))
+    {
+      return false;
+    }
+  }
+
+  writeMessages(buffer, cache.messages);
+  endCache(buffer, Magic, stream);
+  return true;
+}
+
+std::optional<EntityDefinitionCache> readEntityDefinitionCache(
+  const std::string_view cache)
+{
+  try
+  {
+    auto reader = Reader::from(cache.data(), cache.data() + cache.size());
+    if (!readHeader(reader, Magic, Version))
+    {
+      return std::nullopt;
+    }
+
+    auto result = EntityDefinitionCache{};
+
+    const auto keyCount = readCount(reader);
+    result.keys.reserve(keyCount);
+    for (size_t i = 0; i < keyCount; ++i)
+    {
+      result.keys.push_back(readKey(reader));
+    }
+
+    const auto missingFileCount = readCount(reader);
+    result.missingFiles.reserve(missingFileCount);
+    for (size_t i = 0; i < missingFileCount; ++i)
+    {
+      result.missingFiles.emplace_back(readString(reader));
+    }
+
+    const auto classInfoCount = readCount(reader);
+    result.classInfos.reserve(classInfoCount);
+    for (size_t i = 0; i < classInfoCount; ++i)
+    {
+      result.classInfos.push_back(readClassInfo(reader));
+    }
+
+    result.messages = readMessages(reader);
+
+    if (!readTrailer(reader, Magic))
+    {
+      return std::nullopt;
+    }
+
+    return result;
+  }
+  catch (const ReaderException&)
+  {
+    return std::nullopt;
+  }
+  catch (const ParserException&)
+  {
+    return std::nullopt;
+  }
+}
+} // namespace IO
+} // namespace TrenchBroom
@@ -0,0 +1,96 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/CollectingParserStatus.h"
+#include "IO/EntityDefinitionClassInfo.h"
+#include "IO/Path.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace IO
+{
+/**
+ * Identifies the contents of a file that entity definitions were parsed from. Cached
+ * class infos are only used if the keys of all files they were parsed from match the
+ * keys of the files on disk.
+ */
+struct EntityDefinitionCacheKey
+{
+  Path path;
+  std::uint64_t sourceSize;
+  std::uint64_t sourceHash;
+};
+
+bool operator==(const EntityDefinitionCacheKey& lhs, const EntityDefinitionCacheKey& rhs);
+bool operator!=(const EntityDefinitionCacheKey& lhs, const EntityDefinitionCacheKey& rhs);
+
+/**
+ * Computes the cache key for the given contents of the file at the given path.
+ */
+EntityDefinitionCacheKey makeEntityDefinitionCacheKey(
+  const Path& path, std::string_view source);
+
+/**
+ * Returns the path of the cache file for the entity definition file at the given path.
+ * Entity definition files are often stored in read only locations, so the cache files are
+ * stored in the user data directory.
+ */
+Path entityDefinitionCachePath(const Path& path);
+
+/**
+ * The class infos parsed from an entity definition file along with the messages that were
+ * logged while parsing them.
+ */
+struct EntityDefinitionCache
+{
+  /** The keys of the parsed file and of every file it includes. */
+  std::vector<EntityDefinitionCacheKey> keys;
+  /** The paths of the files that were included, but did not exist. */
+  std::vector<Path> missingFiles;
+  std::vector<EntityDefinitionClassInfo> classInfos;
+  std::vector<CollectingParserStatus::Message> messages;
+};
+
+/**
+ * Writes the given cache to the given stream in a binary format.
+ *
+ * Model definitions are stored as expression source text. If a model definition cannot
+ * be restored from its source text, nothing is written and false is returned.
+ *
+ * The cache is only meant to be read on the machine that wrote it.
+ */
+bool writeEntityDefinitionCache(std::ostream& stream, const EntityDefinitionCache& cache);
+
+/**
+ * Reads an entity definition cache.
+ *
+ * Returns an empty optional if the cache was written by a different version or if it is
+ * malformed.
+ */
+std::optional<EntityDefinitionCache> readEntityDefinitionCache(std::string_view cache);
+} // namespace IO
+} // namespace TrenchBroom
@@ -411,11 +411,11 @@ std::vector<EntityDefinitionClassInfo> resolveInheritance(
   return result;
 }
 
-std::unique_ptr<Assets::EntityDefinition> EntityDefinitionParser::createDefinition(
-  const EntityDefinitionClassInfo& classInfo) const
+static std::unique_ptr<Assets::EntityDefinition> createDefinition(
+  const EntityDefinitionClassInfo& classInfo, const Color& defaultEntityColor)
 {
   const auto& name = classInfo.name;
-  const auto color = classInfo.color.value_or(m_defaultEntityColor);
+  const auto color = classInfo.color.value_or(defaultEntityColor);
   const auto size = classInfo.size.value_or(DefaultSize);
   auto description = classInfo.description.value_or("");
   auto& attributes = classInfo.propertyDefinitions;
@@ -440,8 +440,10 @@ std::unique_ptr<Assets::EntityDefinition> EntityDefinitionParser::createDefiniti
   };
 }
 
-std::vector<Assets::EntityDefinition*> EntityDefinitionParser::createDefinitions(
-  ParserStatus& status, const std::vector<EntityDefinitionClassInfo>& classInfos) const
+std::vector<Assets::EntityDefinition*> createEntityDefinitions(
+  ParserStatus& status,
+  const std::vector<EntityDefinitionClassInfo>& classInfos,
+  const Color& defaultEntityColor)
 {
   const auto resolvedClasses =
     resolveInheritance(status, filterRedundantClasses(status, classInfos));
@@ -449,7 +451,7 @@ std::vector<Assets::EntityDefinition*> EntityDefinitionParser::createDefinitions
   std::vector<Assets::EntityDefinition*> result;
   for (const auto& classInfo : resolvedClasses)
   {
-    if (auto definition = createDefinition(classInfo))
+    if (auto definition = createDefinition(classInfo, defaultEntityColor))
     {
       result.push_back(definition.release());
     }
@@ -462,7 +464,13 @@ EntityDefinitionParser::EntityDefinitionList EntityDefinitionParser::parseDefini
   ParserStatus& status)
 {
   auto classInfos = parseClassInfos(status);
-  return createDefinitions(status, std::move(classInfos));
+  return createEntityDefinitions(status, std::move(classInfos), m_defaultEntityColor);
+}
+
+std::vector<EntityDefinitionClassInfo> EntityDefinitionParser::parseClassInfos(
+  ParserStatus& status)
+{
+  return doParseClassInfos(status);
 }
 } // namespace IO
 } // namespace TrenchBroom
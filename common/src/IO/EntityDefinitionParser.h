@@ -43,6 +43,15 @@ class ParserStatus;
 std::vector<EntityDefinitionClassInfo> resolveInheritance(
   ParserStatus& status, const std::vector<EntityDefinitionClassInfo>& classInfos);
 
+/**
+ * Resolves the inheritance of the given class infos and creates an entity definition for
+ * every class info that is not a base class.
+ */
+std::vector<Assets::EntityDefinition*> createEntityDefinitions(
+  ParserStatus& status,
+  const std::vector<EntityDefinitionClassInfo>& classInfos,
+  const Color& defaultEntityColor);
+
 class EntityDefinitionParser
 {
 private:
@@ -60,13 +69,13 @@ public:
 
   EntityDefinitionList parseDefinitions(ParserStatus& status);
 
-private:
-  std::unique_ptr<Assets::EntityDefinition> createDefinition(
-    const EntityDefinitionClassInfo& classInfo) const;
-  std::vector<Assets::EntityDefinition*> createDefinitions(
-    ParserStatus& status, const std::vector<EntityDefinitionClassInfo>& classInfos) const;
+  /**
+   * Parses the class infos without creating entity definitions from them.
+   */
+  std::vector<EntityDefinitionClassInfo> parseClassInfos(ParserStatus& status);
 
-  virtual std::vector<EntityDefinitionClassInfo> parseClassInfos(
+private:
+  virtual std::vector<EntityDefinitionClassInfo> doParseClassInfos(
     ParserStatus& status) = 0;
 };
 } // namespace IO
@@ -21,6 +21,7 @@
 
 #include "Assets/PropertyDefinition.h"
 #include "EL/ELExceptions.h"
+#include "IO/CollectingParserStatus.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/ELParser.h"
 #include "IO/EntityDefinitionClassInfo.h"
@@ -28,12 +29,14 @@
 #include "IO/LegacyModelDefinitionParser.h"
 #include "IO/ParserStatus.h"
 
+#include <kdl/parallel.h>
 #include <kdl/string_compare.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <vector>
@@ -163,6 +166,44 @@ FgdParser::FgdParser(std::string_view str, const Color& defaultEntityColor)
 {
 }
 
+FgdParser::FgdParser(
+  std::string_view str, std::shared_ptr<FileSystem> fs, std::vector<Path> paths)
+  : EntityDefinitionParser{Color{}}
+  , m_paths{std::move(paths)}
+  , m_fs{std::move(fs)}
+  , m_tokenizer{FgdTokenizer{std::move(str)}}
+{
+}
+
+const std::vector<Path>& FgdParser::includedFiles() const
+{
+  return m_includedFiles;
+}
+
+const std::vector<Path>& FgdParser::missingIncludedFiles() const
+{
+  return m_missingIncludedFiles;
+}
+
+/**
+ * An included file whose class infos are parsed after the including file has been parsed.
+ */
+struct FgdParser::Include
+{
+  /**
+   * The number of class infos of the including file that precede the included class
+   * infos.
+   */
+  size_t position;
+  size_t line;
+  std::shared_ptr<File> file;
+
+  std::vector<EntityDefinitionClassInfo> classInfos = {};
+  std::vector<Path> includedFiles = {};
+  std::vector<Path> missingIncludedFiles = {};
+  std::vector<CollectingParserStatus::Message> messages = {};
+};
+
 FgdParser::TokenNameMap FgdParser::tokenNames() const
 {
   using namespace FgdToken;
@@ -184,33 +225,12 @@ FgdParser::TokenNameMap FgdParser::tokenNames() const
   };
 }
 
-class FgdParser::PushIncludePath
-{
-private:
-  FgdParser* m_parser;
-
-public:
-  PushIncludePath(FgdParser* parser, const Path& path)
-    : m_parser{parser}
-  {
-    m_parser->pushIncludePath(path);
-  }
-
-  ~PushIncludePath() { m_parser->popIncludePath(); }
-};
-
 void FgdParser::pushIncludePath(const Path& path)
 {
   assert(!isRecursiveInclude(path));
   m_paths.push_back(path);
 }
 
-void FgdParser::popIncludePath()
-{
-  assert(!m_paths.empty());
-  m_paths.pop_back();
-}
-
 Path FgdParser::currentRoot() const
 {
   if (!m_paths.empty())
@@ -231,20 +251,23 @@ bool FgdParser::isRecursiveInclude(const Path& path) const
   });
 }
 
-std::vector<EntityDefinitionClassInfo> FgdParser::parseClassInfos(ParserStatus& status)
+std::vector<EntityDefinitionClassInfo> FgdParser::doParseClassInfos(ParserStatus& status)
 {
   auto classInfos = std::vector<EntityDefinitionClassInfo>{};
+  auto includes = std::vector<Include>{};
   auto token = m_tokenizer.peekToken();
   while (!token.hasType(FgdToken::Eof))
   {
-    parseClassInfoOrInclude(status, classInfos);
+    parseClassInfoOrInclude(status, classInfos, includes);
     token = m_tokenizer.peekToken();
   }
-  return classInfos;
+  return parseIncludedFiles(status, std::move(classInfos), includes);
 }
 
 void FgdParser::parseClassInfoOrInclude(
-  ParserStatus& status, std::vector<EntityDefinitionClassInfo>& classInfos)
+  ParserStatus& status,
+  std::vector<EntityDefinitionClassInfo>& classInfos,
+  std::vector<Include>& includes)
 {
   const auto token =
     expect(status, FgdToken::Eof | FgdToken::Word, m_tokenizer.peekToken());
@@ -255,8 +278,7 @@ void FgdParser::parseClassInfoOrInclude(
 
   if (kdl::ci::str_is_equal(token.data(), "@include"))
   {
-    auto includedClassInfos = parseInclude(status);
-    classInfos = kdl::vec_concat(classInfos, std::move(includedClassInfos));
+    parseInclude(status, classInfos.size(), includes);
   }
   else
   {
@@ -960,61 +982,118 @@ std::string FgdParser::parseString(ParserStatus& status)
   }
 }
 
-std::vector<EntityDefinitionClassInfo> FgdParser::parseInclude(ParserStatus& status)
+void FgdParser::parseInclude(
+  ParserStatus& status, const size_t position, std::vector<Include>& includes)
 {
   auto token = expect(status, FgdToken::Word, m_tokenizer.nextToken());
   assert(kdl::ci::str_is_equal(token.data(), "@include"));
 
   expect(status, FgdToken::String, token = m_tokenizer.nextToken());
   const auto path = Path(token.data());
-  return handleInclude(status, path);
-}
+  const auto line = m_tokenizer.line();
 
-std::vector<EntityDefinitionClassInfo> FgdParser::handleInclude(
-  ParserStatus& status, const Path& path)
-{
   if (!m_fs)
   {
-    status.error(
-      m_tokenizer.line(),
-      kdl::str_to_string("Cannot include file without host file path"));
-    return {};
+    status.error(line, kdl::str_to_string("Cannot include file without host file path"));
+    return;
   }
 
-  const auto snapshot = m_tokenizer.snapshotStateAndSource();
-  auto result = std::vector<EntityDefinitionClassInfo>{};
   try
   {
-    status.debug(m_tokenizer.line(), "Parsing included file '" + path.asString() + "'");
-    const auto file = m_fs->openFile(currentRoot() + path);
+    status.debug(line, "Parsing included file '" + path.asString() + "'");
+    const auto includePath = currentRoot() + path;
+    if (!m_fs->fileExists(includePath))
+    {
+      m_missingIncludedFiles.push_back(m_fs->makeAbsolute(includePath));
+    }
+
+    auto file = m_fs->openFile(includePath);
     const auto filePath = file->path();
     status.debug(
-      m_tokenizer.line(),
-      "Resolved '" + path.asString() + "' to '" + filePath.asString() + "'");
+      line, "Resolved '" + path.asString() + "' to '" + filePath.asString() + "'");
 
     if (!isRecursiveInclude(filePath))
     {
-      const auto pushIncludePath = PushIncludePath{this, filePath};
-      auto reader = file->reader().buffer();
-      m_tokenizer.replaceState(reader.stringView());
-      result = parseClassInfos(status);
+      includes.push_back(Include{position, line, std::move(file)});
     }
     else
     {
       status.error(
-        m_tokenizer.line(),
+        line,
         kdl::str_to_string(
           "Skipping recursively included file: ", path.asString(), " (", filePath, ")"));
     }
   }
   catch (const Exception& e)
   {
-    status.error(
-      m_tokenizer.line(),
-      kdl::str_to_string("Failed to parse included file: ", e.what()));
+    status.error(line, kdl::str_to_string("Failed to parse included file: ", e.what()));
+  }
+}
+
+/**
+ * Parses the included files in parallel and inserts their class infos into the given
+ * class infos at the positions of the respective include directives. The messages logged
+ * while parsing an included file are logged after those of the including file.
+ */
+std::vector<EntityDefinitionClassInfo> FgdParser::parseIncludedFiles(
+  ParserStatus& status,
+  std::vector<EntityDefinitionClassInfo> classInfos,
+  std::vector<Include>& includes)
+{
+  if (includes.empty())
+  {
+    return classInfos;
+  }
+
+  kdl::parallel_for(includes.size(), [&](const auto i) {
+    auto& include = includes[i];
+    auto includeStatus = CollectingParserStatus{status};
+    try
+    {
+      auto reader = include.file->reader().buffer();
+      auto parser = FgdParser{
+        reader.stringView(),
+        m_fs,
+        kdl::vec_concat(m_paths, std::vector<Path>{include.file->path()})};
+      include.classInfos = parser.parseClassInfos(includeStatus);
+      include.includedFiles = parser.includedFiles();
+      include.missingIncludedFiles = parser.missingIncludedFiles();
+    }
+    catch (const Exception& e)
+    {
+      includeStatus.error(
+        include.line, kdl::str_to_string("Failed to parse included file: ", e.what()));
+    }
+    include.messages = std::move(includeStatus).messages();
+  });
+
+  auto result = std::vector<EntityDefinitionClassInfo>{};
+  auto next = classInfos.begin();
+  for (auto& include : includes)
+  {
+    const auto position =
+      classInfos.begin() + static_cast<std::ptrdiff_t>(include.position);
+    result.insert(
+      result.end(), std::make_move_iterator(next), std::make_move_iterator(position));
+    result.insert(
+      result.end(),
+      std::make_move_iterator(include.classInfos.begin()),
+      std::make_move_iterator(include.classInfos.end()));
+    next = position;
+
+    CollectingParserStatus::logMessages(status, include.messages);
+
+    m_includedFiles.push_back(m_fs->makeAbsolute(include.file->path()));
+    m_includedFiles =
+      kdl::vec_concat(std::move(m_includedFiles), std::move(include.includedFiles));
+    m_missingIncludedFiles = kdl::vec_concat(
+      std::move(m_missingIncludedFiles), std::move(include.missingIncludedFiles));
   }
+  result.insert(
+    result.end(),
+    std::make_move_iterator(next),
+    std::make_move_iterator(classInfos.end()));
 
-  m_tokenizer.restoreStateAndSource(snapshot);
   return result;
 }
 } // namespace IO
@@ -80,6 +80,8 @@ private:
 
   std::vector<Path> m_paths;
   std::shared_ptr<FileSystem> m_fs;
+  std::vector<Path> m_includedFiles;
+  std::vector<Path> m_missingIncludedFiles;
 
   FgdTokenizer m_tokenizer;
 
@@ -87,10 +89,29 @@ public:
   FgdParser(std::string_view str, const Color& defaultEntityColor, const Path& path);
   FgdParser(std::string_view str, const Color& defaultEntityColor);
 
+  /**
+   * Returns the absolute paths of the files that were included by the parsed file, either
+   * directly or indirectly.
+   */
+  const std::vector<Path>& includedFiles() const;
+
+  /**
+   * Returns the absolute paths of the files that the parsed file tried to include, either
+   * directly or indirectly, but which did not exist.
+   */
+  const std::vector<Path>& missingIncludedFiles() const;
+
 private:
-  class PushIncludePath;
+  /**
+   * Creates a parser for a file included from the file at the end of the given include
+   * path stack.
+   */
+  FgdParser(
+    std::string_view str, std::shared_ptr<FileSystem> fs, std::vector<Path> paths);
+
+  struct Include;
+
   void pushIncludePath(const Path& path);
-  void popIncludePath();
 
   Path currentRoot() const;
   bool isRecursiveInclude(const Path& path) const;
@@ -98,10 +119,12 @@ private:
 private:
   TokenNameMap tokenNames() const override;
 
-  std::vector<EntityDefinitionClassInfo> parseClassInfos(ParserStatus& status) override;
+  std::vector<EntityDefinitionClassInfo> doParseClassInfos(ParserStatus& status) override;
 
   void parseClassInfoOrInclude(
-    ParserStatus& status, std::vector<EntityDefinitionClassInfo>& classInfos);
+    ParserStatus& status,
+    std::vector<EntityDefinitionClassInfo>& classInfos,
+    std::vector<Include>& includes);
 
   std::optional<EntityDefinitionClassInfo> parseClassInfo(ParserStatus& status);
   EntityDefinitionClassInfo parseSolidClassInfo(ParserStatus& status);
@@ -152,9 +175,12 @@ private:
   Color parseColor(ParserStatus& status);
   std::string parseString(ParserStatus& status);
 
-  std::vector<EntityDefinitionClassInfo> parseInclude(ParserStatus& status);
-  std::vector<EntityDefinitionClassInfo> handleInclude(
-    ParserStatus& status, const Path& path);
+  void parseInclude(
+    ParserStatus& status, size_t position, std::vector<Include>& includes);
+  std::vector<EntityDefinitionClassInfo> parseIncludedFiles(
+    ParserStatus& status,
+    std::vector<EntityDefinitionClassInfo> classInfos,
+    std::vector<Include>& includes);
 };
 } // namespace IO
 } // namespace TrenchBroom
@@ -258,6 +258,23 @@ Path FileSystem::doMakeAbsolute(const Path& path) const
   throw FileSystemException("Cannot make absolute path of '" + path.asString() + "'");
 }
 
+std::vector<std::pair<Path, bool>> FileSystem::doFindAllItems(
+  const Path& searchPath, const bool recurse) const
+{
+  auto result = std::vector<std::pair<Path, bool>>{};
+  for (const auto& itemPath : doGetDirectoryContents(searchPath))
+  {
+    const auto path = searchPath + itemPath;
+    const auto directory = doDirectoryExists(path);
+    if (directory && recurse)
+    {
+      result = kdl::vec_concat(std::move(result), doFindAllItems(path, recurse));
+    }
+    result.emplace_back(path, directory);
+  }
+  return result;
+}
+
 WritableFileSystem::WritableFileSystem() = default;
 WritableFileSystem::~WritableFileSystem() = default;
 
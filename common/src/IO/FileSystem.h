@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom
@@ -218,16 +219,11 @@ private: // private API to be used for chaining, avoids multiple checks of param
   {
     if (doDirectoryExists(searchPath))
     {
-      for (const auto& itemPath : doGetDirectoryContents(searchPath))
+      for (const auto& [itemPath, directory] : doFindAllItems(searchPath, recurse))
       {
-        const auto directory = doDirectoryExists(searchPath + itemPath);
-        if (directory && recurse)
+        if (matcher(itemPath, directory))
         {
-          doFindItems(searchPath + itemPath, matcher, recurse, result);
-        }
-        if (matcher(searchPath + itemPath, directory))
-        {
-          result.push_back(searchPath + itemPath);
+          result.push_back(itemPath);
         }
       }
     }
@@ -242,6 +238,22 @@ private: // subclassing API
 
   virtual std::vector<Path> doGetDirectoryContents(const Path& path) const = 0;
 
+  /**
+   * Returns all items at the given search path, optionally recursively, each paired with
+   * a flag indicating whether the item is a directory. The returned paths include the
+   * search path.
+   *
+   * The default implementation walks the directory tree using doGetDirectoryContents
+   * and doDirectoryExists. File systems that can enumerate their contents more
+   * efficiently should override this.
+   *
+   * @param searchPath the path of an existing directory
+   * @param recurse whether or not to recurse into sub directories
+   * @return the items and whether they are directories
+   */
+  virtual std::vector<std::pair<Path, bool>> doFindAllItems(
+    const Path& searchPath, bool recurse) const;
+
   virtual std::shared_ptr<File> doOpenFile(const Path& path) const = 0;
 };
 
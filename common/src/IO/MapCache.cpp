@@ -0,0 +1,392 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapCache.h"
+
+#include "Color.h"
+#include "IO/BinaryCache.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/MapFormat.h"
+#include "Model/ParallelTexCoordSystem.h"
+#include "Model/ParaxialTexCoordSystem.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/vec.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+
+namespace TrenchBroom
+{
+namespace IO
+{
+namespace
+{
+using namespace BinaryCache;
+
+constexpr auto Magic = std::string_view{"TBMCACHE"};
+constexpr auto Version = std::uint32_t(2);
+
+enum class ObjectType : std::uint8_t
+{
+  Entity,
+  Brush,
+  Patch,
+};
+
+// writing
+
+template <typename T, size_t S>
+void writeVec(std::string& buffer, const vm::vec<T, S>& vec)
+{
+  for (size_t i = 0; i < S; ++i)
+  {
+    write(buffer, vec[i]);
+  }
+}
+
+template <typename T>
+void writeOptional(std::string& buffer, const std::optional<T>& value)
+{
+  writeFlag(buffer, value.has_value());
+  if (value)
+  {
+    write(buffer, *value);
+  }
+}
+
+void writeParentIndex(std::string& buffer, const std::optional<size_t>& parentIndex)
+{
+  writeFlag(buffer, parentIndex.has_value());
+  if (parentIndex)
+  {
+    writeSize(buffer, *parentIndex);
+  }
+}
+
+void writeAttributes(std::string& buffer, const Model::BrushFaceAttributes& attributes)
+{
+  writeString(buffer, attributes.textureName());
+  write(buffer, attributes.xOffset());
+  write(buffer, attributes.yOffset());
+  write(buffer, attributes.rotation());
+  write(buffer, attributes.xScale());
+  write(buffer, attributes.yScale());
+  writeOptional(buffer, attributes.surfaceContents());
+  writeOptional(buffer, attributes.surfaceFlags());
+  writeOptional(buffer, attributes.surfaceValue());
+
+  const auto& color = attributes.color();
+  writeFlag(buffer, color.has_value());
+  if (color)
+  {
+    writeVec(buffer, vm::vec4f{color->r(), color->g(), color->b(), color->a()});
+  }
+}
+
+void writeFace(std::string& buffer, const Model::BrushFace& face)
+{
+  writeSize(buffer, face.lineNumber());
+  for (const auto& point : face.points())
+  {
+    writeVec(buffer, point);
+  }
+  writeAttributes(buffer, face.attributes());
+
+  // Paraxial texture coordinate systems are computed from the face points and
+  // attributes, but parallel systems store their axes.
+  const auto isParallel =
+    dynamic_cast<const Model::ParallelTexCoordSystem*>(&face.texCoordSystem()) != nullptr;
+  writeFlag(buffer, isParallel);
+  if (isParallel)
+  {
+    writeVec(buffer, face.textureXAxis());
+    writeVec(buffer, face.textureYAxis());
+  }
+}
+
+void writeObjectInfo(std::string& buffer, const MapReader::EntityInfo& entityInfo)
+{
+  write(buffer, static_cast<std::uint8_t>(ObjectType::Entity));
+  writeSize(buffer, entityInfo.startLine);
+  writeSize(buffer, entityInfo.lineCount);
+  writeSize(buffer, entityInfo.properties.size());
+  for (const auto& property : entityInfo.properties)
+  {
+    writeString(buffer, property.key());
+    writeString(buffer, property.value());
+  }
+}
+
+void writeObjectInfo(std::string& buffer, const MapReader::BrushInfo& brushInfo)
+{
+  write(buffer, static_cast<std::uint8_t>(ObjectType::Brush));
+  writeSize(buffer, brushInfo.startLine);
+  writeSize(buffer, brushInfo.lineCount);
+  writeParentIndex(buffer, brushInfo.parentIndex);
+  writeSize(buffer, brushInfo.faces.size());
+  for (const auto& face : brushInfo.faces)
+  {
+    writeFace(buffer, face);
+  }
+}
+
+void writeObjectInfo(std::string& buffer, const MapReader::PatchInfo& patchInfo)
+{
+  write(buffer, static_cast<std::uint8_t>(ObjectType::Patch));
+  writeSize(buffer, patchInfo.startLine);
+  writeSize(buffer, patchInfo.lineCount);
+  writeParentIndex(buffer, patchInfo.parentIndex);
+  writeSize(buffer, patchInfo.rowCount);
+  writeSize(buffer, patchInfo.columnCount);
+  writeSize(buffer, patchInfo.controlPoints.size());
+  for (const auto& controlPoint : patchInfo.controlPoints)
+  {
+    writeVec(buffer, controlPoint);
+  }
+  writeString(buffer, patchInfo.textureName);
+}
+
+// reading
+
+template <typename T, size_t S>
+vm::vec<T, S> readVec(Reader& reader)
+{
+  return reader.readVec<T, S>();
+}
+
+template <typename T>
+std::optional<T> readOptional(Reader& reader)
+{
+  return readFlag(reader) ? std::optional<T>{read<T>(reader)} : std::nullopt;
+}
+
+std::optional<size_t> readParentIndex(Reader& reader)
+{
+  return readFlag(reader) ? std::optional<size_t>{readSize(reader)} : std::nullopt;
+}
+
+Model::BrushFaceAttributes readAttributes(Reader& reader)
+{
+  auto attributes = Model::BrushFaceAttributes{readString(reader)};
+  attributes.setXOffset(read<float>(reader));
+  attributes.setYOffset(read<float>(reader));
+  attributes.setRotation(read<float>(reader));
+  attributes.setXScale(read<float>(reader));
+  attributes.setYScale(read<float>(reader));
+  attributes.setSurfaceContents(readOptional<int>(reader));
+  attributes.setSurfaceFlags(readOptional<int>(reader));
+  attributes.setSurfaceValue(readOptional<float>(reader));
+
+  if (readFlag(reader))
+  {
+    attributes.setColor(Color{readVec<float, 4>(reader)});
+  }
+
+  return attributes;
+}
+
+Model::BrushFace readFace(Reader& reader)
+{
+  const auto line = readSize(reader);
+  const auto p0 = readVec<FloatType, 3>(reader);
+  const auto p1 = readVec<FloatType, 3>(reader);
+  const auto p2 = readVec<FloatType, 3>(reader);
+  const auto attributes = readAttributes(reader);
+
+  auto texCoordSystem = std::unique_ptr<Model::TexCoordSystem>{};
+  if (readFlag(reader))
+  {
+    const auto xAxis = readVec<FloatType, 3>(reader);
+    const auto yAxis = readVec<FloatType, 3>(reader);
+    texCoordSystem = std::make_unique<Model::ParallelTexCoordSystem>(xAxis, yAxis);
+  }
+  else
+  {
+    texCoordSystem =
+      std::make_unique<Model::ParaxialTexCoordSystem>(p0, p1, p2, attributes);
+  }
+
+  auto result =
+    Model::BrushFace::create(p0, p1, p2, attributes, std::move(texCoordSystem));
+  if (result.is_error())
+  {
+    throw ReaderException{"Invalid brush face"};
+  }
+
+  auto face = std::move(result).value();
+  face.setFilePosition(line, 1u);
+  return face;
+}
+
+MapReader::EntityInfo readEntityInfo(Reader& reader)
+{
+  const auto startLine = readSize(reader);
+  const auto lineCount = readSize(reader);
+
+  auto properties = std::vector<Model::EntityProperty>{};
+  const auto propertyCount = readCount(reader);
+  properties.reserve(propertyCount);
+  for (size_t i = 0; i < propertyCount; ++i)
+  {
+    auto key = readString(reader);
+    auto value = readString(reader);
+    properties.emplace_back(std::move(key), std::move(value));
+  }
+
+  return MapReader::EntityInfo{std::move(properties), startLine, lineCount};
+}
+
+MapReader::BrushInfo readBrushInfo(Reader& reader)
+{
+  const auto startLine = readSize(reader);
+  const auto lineCount = readSize(reader);
+  const auto parentIndex = readParentIndex(reader);
+
+  auto faces = std::vector<Model::BrushFace>{};
+  const auto faceCount = readCount(reader);
+  faces.reserve(faceCount);
+  for (size_t i = 0; i < faceCount; ++i)
+  {
+    faces.push_back(readFace(reader));
+  }
+
+  return MapReader::BrushInfo{std::move(faces), startLine, lineCount, parentIndex};
+}
+
+MapReader::PatchInfo readPatchInfo(Reader& reader)
+{
+  const auto startLine = readSize(reader);
+  const auto lineCount = readSize(reader);
+  const auto parentIndex = readParentIndex(reader);
+  const auto rowCount = readSize(reader);
+  const auto columnCount = readSize(reader);
+
+  auto controlPoints = std::vector<Model::BezierPatch::Point>{};
+  const auto controlPointCount = readCount(reader);
+  controlPoints.reserve(controlPointCount);
+  for (size_t i = 0; i < controlPointCount; ++i)
+  {
+    controlPoints.push_back(readVec<FloatType, 5>(reader));
+  }
+
+  auto textureName = readString(reader);
+
+  return MapReader::PatchInfo{
+    rowCount,
+    columnCount,
+    std::move(controlPoints),
+    std::move(textureName),
+    startLine,
+    lineCount,
+    parentIndex};
+}
+
+MapReader::ObjectInfo readObjectInfo(Reader& reader)
+{
+  switch (static_cast<ObjectType>(read<std::uint8_t>(reader)))
+  {
+  case ObjectType::Entity:
+    return readEntityInfo(reader);
+  case ObjectType::Brush:
+    return readBrushInfo(reader);
+  case ObjectType::Patch:
+    return readPatchInfo(reader);
+  }
+  throw ReaderException{"Unknown object type"};
+}
+} // namespace
+
+MapCacheKey makeMapCacheKey(const std::string_view source, const Model::MapFormat mapFormat)
+{
+  return MapCacheKey{
+    mapFormat,
+    static_cast<std::uint64_t>(source.size()),
+    static_cast<std::uint64_t>(std::hash<std::string_view>{}(source))};
+}
+
+Path mapCachePath(const Path& mapPath)
+{
+  return mapPath.addExtension("tbcache");
+}
+
+void writeMapCache(std::ostream& stream, const MapCacheKey& key, const MapCache& cache)
+{
+  auto buffer = beginCache(Magic, Version);
+  write(buffer, static_cast<std::uint32_t>(key.mapFormat));
+  write(buffer, key.sourceSize);
+  write(buffer, key.sourceHash);
+
+  writeSize(buffer, cache.objectInfos.size());
+  for (const auto& objectInfo : cache.objectInfos)
+  {
+    std::visit([&](const auto& info) { writeObjectInfo(buffer, info); }, objectInfo);
+  }
+
+  writeMessages(buffer, cache.messages);
+  endCache(buffer, Magic, stream);
+}
+
+std::optional<MapCache> readMapCache(const std::string_view cache, const MapCacheKey& key)
+{
+  try
+  {
+    auto reader = Reader::from(cache.data(), cache.data() + cache.size());
+    if (
+      !readHeader(reader, Magic, Version)
+      || read<std::uint32_t>(reader) != static_cast<std::uint32_t>(key.mapFormat)
+      || read<std::uint64_t>(reader) != key.sourceSize
+      || read<std::uint64_t>(reader) != key.sourceHash)
+    {
+      return std::nullopt;
+    }
+
+    auto result = MapCache{};
+
+    const auto objectCount = readCount(reader);
+    result.objectInfos.reserve(objectCount);
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+      result.objectInfos.push_back(readObjectInfo(reader));
+    }
+
+    result.messages = readMessages(reader);
+
+    if (!readTrailer(reader, Magic))
+    {
+      return std::nullopt;
+    }
+
+    return result;
+  }
+  catch (const ReaderException&)
+  {
+    return std::nullopt;
+  }
+}
+} // namespace IO
+} // namespace TrenchBroom
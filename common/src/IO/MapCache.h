@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/CollectingParserStatus.h"
+#include "IO/MapReader.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Model
+{
+enum class MapFormat;
+}
+
+namespace IO
+{
+class Path;
+
+/**
+ * Identifies the map file that a map cache was created from. A cache is only used if its
+ * key matches the key of the map file being loaded.
+ */
+struct MapCacheKey
+{
+  Model::MapFormat mapFormat;
+  std::uint64_t sourceSize;
+  std::uint64_t sourceHash;
+};
+
+/**
+ * Computes the cache key for the given map file contents and map format.
+ */
+MapCacheKey makeMapCacheKey(std::string_view source, Model::MapFormat mapFormat);
+
+/**
+ * Returns the path of the cache file for the map file at the given path. The cache file
+ * is stored next to the map file.
+ */
+Path mapCachePath(const Path& mapPath);
+
+/**
+ * The objects parsed from a map file along with the messages that were logged while
+ * parsing them.
+ */
+struct MapCache
+{
+  std::vector<MapReader::ObjectInfo> objectInfos;
+  std::vector<CollectingParserStatus::Message> messages;
+};
+
+/**
+ * Writes the given cache to the given stream in a binary format.
+ *
+ * The map cache stores the objects exactly as they were parsed from a map file, that is,
+ * entity properties, brush faces with their points, attributes and texture axes, and
+ * patches, along with their file positions. Reading the cache yields the same object infos
+ * without tokenizing the map file again. The cache is only meant to be read on the machine
+ * that wrote it.
+ */
+void writeMapCache(std::ostream& stream, const MapCacheKey& key, const MapCache& cache);
+
+/**
+ * Reads a map cache.
+ *
+ * Returns an empty optional if the cache was created for a different key or if it is
+ * malformed.
+ */
+std::optional<MapCache> readMapCache(std::string_view cache, const MapCacheKey& key);
+} // namespace IO
+} // namespace TrenchBroom
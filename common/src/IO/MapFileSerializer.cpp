@@ -37,11 +37,21 @@
 #include <kdl/string_format.h>
 #include <kdl/vector_utils.h>
 
+#include <vecmath/vec.h>
+
 #include <fmt/format.h>
 
-#include <iterator> // for std::ostreambuf_iterator
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <iterator> // for std::back_inserter
+#include <limits>
 #include <memory>
-#include <sstream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -50,6 +60,55 @@ namespace TrenchBroom
 {
 namespace IO
 {
+namespace
+{
+/**
+ * Appends the given value to the given string. The output is identical to
+ * fmt::format("{}", value), which yields the shortest representation that parses back to
+ * the same value.
+ *
+ * Most values written to map files, like the plane points of brushes aligned to the
+ * grid, are integers. These are converted directly, bypassing the much more expensive
+ * shortest round trip algorithm. This is only done below 2^24 for float and 2^53 for
+ * double, where consecutive integers are representable and so every digit of an
+ * integral value is needed to round trip. Larger values as well as negative zero are
+ * left to fmt.
+ */
+template <typename T>
+void appendNumber(std::string& str, const T value)
+{
+  static_assert(std::is_floating_point_v<T>, "value must be a floating point number");
+  constexpr auto MaxFastPathValue =
+    static_cast<T>(std::uint64_t(1) << std::numeric_limits<T>::digits);
+
+  if (value > -MaxFastPathValue && value < MaxFastPathValue)
+  {
+    const auto integer = static_cast<long long>(value);
+    if (static_cast<T>(integer) == value && (integer != 0 || !std::signbit(value)))
+    {
+      char buffer[24];
+      const auto result = std::to_chars(std::begin(buffer), std::end(buffer), integer);
+      str.append(buffer, result.ptr);
+      return;
+    }
+  }
+
+  fmt::format_to(std::back_inserter(str), "{}", value);
+}
+
+template <typename T, size_t S>
+void appendVector(std::string& str, const vm::vec<T, S>& vec)
+{
+  str += "(";
+  for (size_t i = 0; i < S; ++i)
+  {
+    str += " ";
+    appendNumber(str, vec[i]);
+  }
+  str += " )";
+}
+} // namespace
+
 class QuakeFileSerializer : public MapFileSerializer
 {
 public:
@@ -59,30 +118,23 @@ public:
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override
+  void doWriteBrushFace(std::string& str, const Model::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeTextureInfo(stream, face);
-    fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+    writeFacePoints(str, face);
+    writeTextureInfo(str, face);
+    fmt::format_to(std::back_inserter(str), "\n");
   }
 
 protected:
-  void writeFacePoints(std::ostream& stream, const Model::BrushFace& face) const
+  void writeFacePoints(std::string& str, const Model::BrushFace& face) const
   {
     const Model::BrushFace::Points& points = face.points();
 
-    fmt::format_to(
-      std::ostreambuf_iterator<char>(stream),
-      "( {} {} {} ) ( {} {} {} ) ( {} {} {} )",
-      points[0].x(),
-      points[0].y(),
-      points[0].z(),
-      points[1].x(),
-      points[1].y(),
-      points[1].z(),
-      points[2].x(),
-      points[2].y(),
-      points[2].z());
+    appendVector(str, points[0]);
+    str += " ";
+    appendVector(str, points[1]);
+    str += " ";
+    appendVector(str, points[2]);
   }
 
   static bool shouldQuoteTextureName(const std::string& textureName)
@@ -96,24 +148,29 @@ protected:
     return "\"" + kdl::str_escape(textureName, "\"") + "\"";
   }
 
-  void writeTextureInfo(std::ostream& stream, const Model::BrushFace& face) const
+  void writeTextureInfo(std::string& str, const Model::BrushFace& face) const
   {
     const std::string& textureName = face.attributes().textureName().empty()
                                        ? Model::BrushFaceAttributes::NoTextureName
                                        : face.attributes().textureName();
 
-    fmt::format_to(
-      std::ostreambuf_iterator<char>(stream),
-      " {} {} {} {} {} {}",
-      shouldQuoteTextureName(textureName) ? quoteTextureName(textureName) : textureName,
-      face.attributes().xOffset(),
-      face.attributes().yOffset(),
-      face.attributes().rotation(),
-      face.attributes().xScale(),
-      face.attributes().yScale());
+    str += " ";
+    str +=
+      shouldQuoteTextureName(textureName) ? quoteTextureName(textureName) : textureName;
+
+    for (const auto value :
+         {face.attributes().xOffset(),
+          face.attributes().yOffset(),
+          face.attributes().rotation(),
+          face.attributes().xScale(),
+          face.attributes().yScale()})
+    {
+      str += " ";
+      appendNumber(str, value);
+    }
   }
 
-  void writeValveTextureInfo(std::ostream& stream, const Model::BrushFace& face) const
+  void writeValveTextureInfo(std::string& str, const Model::BrushFace& face) const
   {
     const std::string& textureName = face.attributes().textureName().empty()
                                        ? Model::BrushFaceAttributes::NoTextureName
@@ -121,24 +178,37 @@ protected:
     const vm::vec3 xAxis = face.textureXAxis();
     const vm::vec3 yAxis = face.textureYAxis();
 
-    fmt::format_to(
-      std::ostreambuf_iterator<char>(stream),
-      " {} [ {} {} {} {} ] [ {} {} {} {} ] {} {} {}",
-      shouldQuoteTextureName(textureName) ? quoteTextureName(textureName) : textureName,
-
-      xAxis.x(),
-      xAxis.y(),
-      xAxis.z(),
-      face.attributes().xOffset(),
-
-      yAxis.x(),
-      yAxis.y(),
-      yAxis.z(),
-      face.attributes().yOffset(),
-
-      face.attributes().rotation(),
-      face.attributes().xScale(),
-      face.attributes().yScale());
+    str += " ";
+    str +=
+      shouldQuoteTextureName(textureName) ? quoteTextureName(textureName) : textureName;
+
+    str += " [ ";
+    appendNumber(str, xAxis.x());
+    str += " ";
+    appendNumber(str, xAxis.y());
+    str += " ";
+    appendNumber(str, xAxis.z());
+    str += " ";
+    appendNumber(str, face.attributes().xOffset());
+
+    str += " ] [ ";
+    appendNumber(str, yAxis.x());
+    str += " ";
+    appendNumber(str, yAxis.y());
+    str += " ";
+    appendNumber(str, yAxis.z());
+    str += " ";
+    appendNumber(str, face.attributes().yOffset());
+    str += " ]";
+
+    for (const auto value :
+         {face.attributes().rotation(),
+          face.attributes().xScale(),
+          face.attributes().yScale()})
+    {
+      str += " ";
+      appendNumber(str, value);
+    }
   }
 };
 
@@ -151,24 +221,24 @@ public:
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override
+  void doWriteBrushFace(std::string& str, const Model::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeTextureInfo(stream, face);
+    writeFacePoints(str, face);
+    writeTextureInfo(str, face);
 
     if (face.attributes().hasSurfaceAttributes())
     {
-      writeSurfaceAttributes(stream, face);
+      writeSurfaceAttributes(str, face);
     }
 
-    fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+    fmt::format_to(std::back_inserter(str), "\n");
   }
 
 protected:
-  void writeSurfaceAttributes(std::ostream& stream, const Model::BrushFace& face) const
+  void writeSurfaceAttributes(std::string& str, const Model::BrushFace& face) const
   {
     fmt::format_to(
-      std::ostreambuf_iterator<char>(stream),
+      std::back_inserter(str),
       " {} {} {}",
       face.resolvedSurfaceContents(),
       face.resolvedSurfaceFlags(),
@@ -185,17 +255,17 @@ public:
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override
+  void doWriteBrushFace(std::string& str, const Model::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeValveTextureInfo(stream, face);
+    writeFacePoints(str, face);
+    writeValveTextureInfo(str, face);
 
     if (face.attributes().hasSurfaceAttributes())
     {
-      writeSurfaceAttributes(stream, face);
+      writeSurfaceAttributes(str, face);
     }
 
-    fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+    fmt::format_to(std::back_inserter(str), "\n");
   }
 };
 
@@ -212,28 +282,28 @@ public:
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override
+  void doWriteBrushFace(std::string& str, const Model::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeTextureInfo(stream, face);
+    writeFacePoints(str, face);
+    writeTextureInfo(str, face);
 
     if (face.attributes().hasSurfaceAttributes() || face.attributes().hasColor())
     {
-      writeSurfaceAttributes(stream, face);
+      writeSurfaceAttributes(str, face);
     }
     if (face.attributes().hasColor())
     {
-      writeSurfaceColor(stream, face);
+      writeSurfaceColor(str, face);
     }
 
-    fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+    fmt::format_to(std::back_inserter(str), "\n");
   }
 
 protected:
-  void writeSurfaceColor(std::ostream& stream, const Model::BrushFace& face) const
+  void writeSurfaceColor(std::string& str, const Model::BrushFace& face) const
   {
     fmt::format_to(
-      std::ostreambuf_iterator<char>(stream),
+      std::back_inserter(str),
       " {} {} {}",
       static_cast<int>(face.resolvedColor().r()),
       static_cast<int>(face.resolvedColor().g()),
@@ -250,12 +320,12 @@ public:
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override
+  void doWriteBrushFace(std::string& str, const Model::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeTextureInfo(stream, face);
+    writeFacePoints(str, face);
+    writeTextureInfo(str, face);
     fmt::format_to(
-      std::ostreambuf_iterator<char>(stream), " 0\n"); // extra value written here
+      std::back_inserter(str), " 0\n"); // extra value written here
   }
 };
 
@@ -268,11 +338,11 @@ public:
   }
 
 private:
-  void doWriteBrushFace(std::ostream& stream, const Model::BrushFace& face) const override
+  void doWriteBrushFace(std::string& str, const Model::BrushFace& face) const override
   {
-    writeFacePoints(stream, face);
-    writeValveTextureInfo(stream, face);
-    fmt::format_to(std::ostreambuf_iterator<char>(stream), "\n");
+    writeFacePoints(str, face);
+    writeValveTextureInfo(str, face);
+    fmt::format_to(std::back_inserter(str), "\n");
   }
 };
 
@@ -309,13 +379,55 @@ MapFileSerializer::MapFileSerializer(std::ostream& stream)
 {
 }
 
+namespace
+{
+/**
+ * The number of consecutive nodes that are serialized into the same chunk buffer.
+ */
+constexpr size_t PrecomputedChunkSize = 1024;
+
+/**
+ * The number of output segments that are copied into the output buffer by one task.
+ */
+constexpr size_t OutputBlockSize = 4096;
+
+using NodeToSerialize = std::variant<
+  const Model::BrushNode*,
+  const Model::PatchNode*,
+  const std::vector<Model::EntityProperty>*>;
+
+/**
+ * Estimates the number of bytes required to serialize the given node. Used to reserve
+ * the chunk buffers before the nodes are serialized.
+ */
+size_t estimateSerializedSize(const NodeToSerialize& node)
+{
+  return std::visit(
+    kdl::overload(
+      [](const Model::BrushNode* brushNode) {
+        return brushNode->brush().faceCount() * 128u;
+      },
+      [](const Model::PatchNode* patchNode) {
+        return patchNode->patch().controlPoints().size() * 64u + 64u;
+      },
+      [](const std::vector<Model::EntityProperty>* properties) {
+        auto result = size_t(0);
+        for (const auto& property : *properties)
+        {
+          result += property.key().size() + property.value().size() + 6u;
+        }
+        return result;
+      }),
+    node);
+}
+} // namespace
+
 void MapFileSerializer::doBeginFile(const std::vector<const Model::Node*>& rootNodes)
 {
   ensure(m_nodeToPrecomputedString.empty(), "MapFileSerializer may not be reused");
 
   // collect nodes
-  std::vector<std::variant<const Model::BrushNode*, const Model::PatchNode*>>
-    nodesToSerialize;
+  auto nodesToSerialize = std::vector<NodeToSerialize>{};
   nodesToSerialize.reserve(rootNodes.size());
 
   Model::Node::visitAll(
@@ -330,68 +442,176 @@ void MapFileSerializer::doBeginFile(const std::vector<const Model::Node*>& rootN
       [](auto&& thisLambda, const Model::GroupNode* group) {
         group->visitChildren(thisLambda);
       },
-      [](auto&& thisLambda, const Model::EntityNode* entity) {
+      [&](auto&& thisLambda, const Model::EntityNode* entity) {
+        nodesToSerialize.push_back(&entity->entity().properties());
         entity->visitChildren(thisLambda);
       },
       [&](const Model::BrushNode* brush) { nodesToSerialize.push_back(brush); },
       [&](const Model::PatchNode* patchNode) { nodesToSerialize.push_back(patchNode); }));
 
-  // serialize brushes to strings in parallel
-  using Entry = std::pair<const Model::Node*, PrecomputedString>;
-  std::vector<Entry> result =
-    kdl::vec_parallel_transform(std::move(nodesToSerialize), [&](const auto& node) {
-      return std::visit(
+  // serialize the nodes in parallel, each chunk of consecutive nodes into one buffer
+  struct Entry
+  {
+    NodeToSerialize node;
+    size_t offset;
+    size_t length;
+    size_t lineCount;
+  };
+
+  const auto chunkCount =
+    (nodesToSerialize.size() + PrecomputedChunkSize - 1u) / PrecomputedChunkSize;
+  auto chunkEntries = std::vector<std::vector<Entry>>(chunkCount);
+  m_precomputedChunks.resize(chunkCount);
+
+  kdl::parallel_for(chunkCount, [&](const size_t chunkIndex) {
+    const auto first = chunkIndex * PrecomputedChunkSize;
+    const auto last = std::min(first + PrecomputedChunkSize, nodesToSerialize.size());
+
+    auto& chunk = m_precomputedChunks[chunkIndex];
+    auto& entries = chunkEntries[chunkIndex];
+    entries.reserve(last - first);
+
+    auto estimatedSize = size_t(0);
+    for (auto i = first; i < last; ++i)
+    {
+      estimatedSize += estimateSerializedSize(nodesToSerialize[i]);
+    }
+    chunk.reserve(estimatedSize);
+
+    for (auto i = first; i < last; ++i)
+    {
+      const auto& node = nodesToSerialize[i];
+      const auto offset = chunk.size();
+      const auto lineCount = std::visit(
         kdl::overload(
           [&](const Model::BrushNode* brushNode) {
-            return Entry{brushNode, writeBrushFaces(brushNode->brush())};
+            return writeBrushFaces(chunk, brushNode->brush());
           },
           [&](const Model::PatchNode* patchNode) {
-            return Entry{patchNode, writePatch(patchNode->patch())};
+            return writePatch(chunk, patchNode->patch());
+          },
+          [&](const std::vector<Model::EntityProperty>* properties) {
+            return writeEntityProperties(chunk, *properties);
           }),
         node);
-    });
+      entries.push_back(Entry{node, offset, chunk.size() - offset, lineCount});
+    }
+  });
 
-  // move strings into a map
-  for (auto& entry : result)
+  // the chunks are not modified anymore, so we can refer to their contents
+  m_nodeToPrecomputedString.reserve(nodesToSerialize.size());
+  for (size_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
   {
-    m_nodeToPrecomputedString.insert(std::move(entry));
+    const auto chunk = std::string_view{m_precomputedChunks[chunkIndex]};
+    for (const auto& entry : chunkEntries[chunkIndex])
+    {
+      const auto precomputedString =
+        PrecomputedString{chunk.substr(entry.offset, entry.length), entry.lineCount};
+      std::visit(
+        kdl::overload(
+          [&](const Model::Node* node) {
+            m_nodeToPrecomputedString.emplace(node, precomputedString);
+          },
+          [&](const std::vector<Model::EntityProperty>* properties) {
+            m_propertiesToPrecomputedString.emplace(properties, precomputedString);
+          }),
+        entry.node);
+    }
   }
 }
 
-void MapFileSerializer::doEndFile() {}
+void MapFileSerializer::doEndFile()
+{
+  // compute the offset of each segment in the output
+  auto segmentOffsets = std::vector<size_t>{};
+  segmentOffsets.reserve(m_segments.size());
+
+  auto size = size_t(0);
+  auto bufferBegin = size_t(0);
+  for (const auto& segment : m_segments)
+  {
+    segmentOffsets.push_back(size);
+    size += segment.bufferEnd - bufferBegin + segment.precomputed.size();
+    bufferBegin = segment.bufferEnd;
+  }
+  const auto tailOffset = size;
+  size += m_buffer.size() - bufferBegin;
+
+  // assemble the output in parallel
+  auto output = std::string(size, '\0');
+
+  const auto blockCount = (m_segments.size() + OutputBlockSize - 1u) / OutputBlockSize;
+  kdl::parallel_for(blockCount, [&](const size_t blockIndex) {
+    const auto first = blockIndex * OutputBlockSize;
+    const auto last = std::min(first + OutputBlockSize, m_segments.size());
+    for (auto i = first; i < last; ++i)
+    {
+      const auto& segment = m_segments[i];
+      const auto segmentBufferBegin = i > 0u ? m_segments[i - 1u].bufferEnd : size_t(0);
+
+      auto* out = output.data() + segmentOffsets[i];
+      out = std::copy(
+        m_buffer.data() + segmentBufferBegin, m_buffer.data() + segment.bufferEnd, out);
+      std::copy(std::begin(segment.precomputed), std::end(segment.precomputed), out);
+    }
+  });
+  std::copy(
+    m_buffer.data() + bufferBegin,
+    m_buffer.data() + m_buffer.size(),
+    output.data() + tailOffset);
+
+  m_stream.write(output.data(), static_cast<std::streamsize>(output.size()));
+
+  m_buffer.clear();
+  m_segments.clear();
+}
 
 void MapFileSerializer::doBeginEntity(const Model::Node* /* node */)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "// entity {}\n", entityNo());
+  fmt::format_to(std::back_inserter(m_buffer), "// entity {}\n", entityNo());
   ++m_line;
   m_startLineStack.push_back(m_line);
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "{{\n");
+  fmt::format_to(std::back_inserter(m_buffer), "{{\n");
   ++m_line;
 }
 
 void MapFileSerializer::doEndEntity(const Model::Node* node)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "}}\n");
+  fmt::format_to(std::back_inserter(m_buffer), "}}\n");
   ++m_line;
   setFilePosition(node);
 }
 
+void MapFileSerializer::doEntityProperties(
+  const std::vector<Model::EntityProperty>& properties)
+{
+  // only the properties of entity nodes are precomputed, others are written here
+  const auto it = m_propertiesToPrecomputedString.find(&properties);
+  if (it != std::end(m_propertiesToPrecomputedString))
+  {
+    writePrecomputedString(it->second);
+  }
+  else
+  {
+    for (const auto& property : properties)
+    {
+      doEntityProperty(property);
+    }
+  }
+}
+
 void MapFileSerializer::doEntityProperty(const Model::EntityProperty& attribute)
 {
-  fmt::format_to(
-    std::ostreambuf_iterator<char>(m_stream),
-    "\"{}\" \"{}\"\n",
-    escapeEntityProperties(attribute.key()),
-    escapeEntityProperties(attribute.value()));
+  writeEntityProperty(m_buffer, attribute);
   ++m_line;
 }
 
 void MapFileSerializer::doBrush(const Model::BrushNode* brush)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "// brush {}\n", brushNo());
+  fmt::format_to(std::back_inserter(m_buffer), "// brush {}\n", brushNo());
   ++m_line;
   m_startLineStack.push_back(m_line);
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "{{\n");
+  fmt::format_to(std::back_inserter(m_buffer), "{{\n");
   ++m_line;
 
   // write pre-serialized brush faces
@@ -399,11 +619,9 @@ void MapFileSerializer::doBrush(const Model::BrushNode* brush)
   ensure(
     it != std::end(m_nodeToPrecomputedString),
     "attempted to serialize a brush which was not passed to doBeginFile");
-  const PrecomputedString& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  writePrecomputedString(it->second);
 
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "}}\n");
+  fmt::format_to(std::back_inserter(m_buffer), "}}\n");
   ++m_line;
   setFilePosition(brush);
 }
@@ -411,14 +629,14 @@ void MapFileSerializer::doBrush(const Model::BrushNode* brush)
 void MapFileSerializer::doBrushFace(const Model::BrushFace& face)
 {
   const size_t lines = 1u;
-  doWriteBrushFace(m_stream, face);
+  doWriteBrushFace(m_buffer, face);
   face.setFilePosition(m_line, lines);
   m_line += lines;
 }
 
 void MapFileSerializer::doPatch(const Model::PatchNode* patchNode)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "// brush {}\n", brushNo());
+  fmt::format_to(std::back_inserter(m_buffer), "// brush {}\n", brushNo());
   ++m_line;
   m_startLineStack.push_back(m_line);
 
@@ -427,13 +645,17 @@ void MapFileSerializer::doPatch(const Model::PatchNode* patchNode)
   ensure(
     it != std::end(m_nodeToPrecomputedString),
     "attempted to serialize a patch which was not passed to doBeginFile");
-  const PrecomputedString& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  writePrecomputedString(it->second);
 
   setFilePosition(patchNode);
 }
 
+void MapFileSerializer::writePrecomputedString(const PrecomputedString& precomputedString)
+{
+  m_segments.push_back(Segment{m_buffer.size(), precomputedString.string});
+  m_line += precomputedString.lineCount;
+}
+
 void MapFileSerializer::setFilePosition(const Model::Node* node)
 {
   const size_t start = startLine();
@@ -451,67 +673,87 @@ size_t MapFileSerializer::startLine()
 /**
  * Threadsafe
  */
-MapFileSerializer::PrecomputedString MapFileSerializer::writeBrushFaces(
-  const Model::Brush& brush) const
+size_t MapFileSerializer::writeBrushFaces(
+  std::string& str, const Model::Brush& brush) const
 {
-  std::stringstream stream;
   for (const Model::BrushFace& face : brush.faces())
   {
-    doWriteBrushFace(stream, face);
+    doWriteBrushFace(str, face);
   }
-  return PrecomputedString{stream.str(), brush.faces().size()};
+  return brush.faces().size();
 }
 
-MapFileSerializer::PrecomputedString MapFileSerializer::writePatch(
-  const Model::BezierPatch& patch) const
+/**
+ * Threadsafe
+ */
+size_t MapFileSerializer::writePatch(
+  std::string& str, const Model::BezierPatch& patch) const
 {
   size_t lineCount = 0u;
-  std::stringstream stream;
 
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), "{{\n");
+  fmt::format_to(std::back_inserter(str), "{{\n");
   ++lineCount;
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), "patchDef2\n");
+  fmt::format_to(std::back_inserter(str), "patchDef2\n");
   ++lineCount;
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), "{{\n");
+  fmt::format_to(std::back_inserter(str), "{{\n");
   ++lineCount;
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), "{}\n", patch.textureName());
+  fmt::format_to(std::back_inserter(str), "{}\n", patch.textureName());
   ++lineCount;
   fmt::format_to(
-    std::ostreambuf_iterator<char>(stream),
+    std::back_inserter(str),
     "( {} {} 0 0 0 )\n",
     patch.pointRowCount(),
     patch.pointColumnCount());
   ++lineCount;
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), "(\n");
+  fmt::format_to(std::back_inserter(str), "(\n");
   ++lineCount;
 
   for (size_t row = 0u; row < patch.pointRowCount(); ++row)
   {
-    fmt::format_to(std::ostreambuf_iterator<char>(stream), "( ");
+    fmt::format_to(std::back_inserter(str), "( ");
     for (size_t col = 0u; col < patch.pointColumnCount(); ++col)
     {
-      const auto& p = patch.controlPoint(row, col);
-      fmt::format_to(
-        std::ostreambuf_iterator<char>(stream),
-        "( {} {} {} {} {} ) ",
-        p[0],
-        p[1],
-        p[2],
-        p[3],
-        p[4]);
+      appendVector(str, patch.controlPoint(row, col));
+      str += " ";
     }
-    fmt::format_to(std::ostreambuf_iterator<char>(stream), ")\n");
+    fmt::format_to(std::back_inserter(str), ")\n");
     ++lineCount;
   }
 
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), ")\n");
+  fmt::format_to(std::back_inserter(str), ")\n");
   ++lineCount;
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), "}}\n");
+  fmt::format_to(std::back_inserter(str), "}}\n");
   ++lineCount;
-  fmt::format_to(std::ostreambuf_iterator<char>(stream), "}}\n");
+  fmt::format_to(std::back_inserter(str), "}}\n");
   ++lineCount;
 
-  return PrecomputedString{stream.str(), lineCount};
+  return lineCount;
+}
+
+/**
+ * Threadsafe
+ */
+size_t MapFileSerializer::writeEntityProperties(
+  std::string& str, const std::vector<Model::EntityProperty>& properties) const
+{
+  for (const auto& property : properties)
+  {
+    writeEntityProperty(str, property);
+  }
+  return properties.size();
+}
+
+/**
+ * Threadsafe
+ */
+void MapFileSerializer::writeEntityProperty(
+  std::string& str, const Model::EntityProperty& property) const
+{
+  fmt::format_to(
+    std::back_inserter(str),
+    "\"{}\" \"{}\"\n",
+    escapeEntityProperties(property.key()),
+    escapeEntityProperties(property.value()));
 }
 } // namespace IO
 } // namespace TrenchBroom
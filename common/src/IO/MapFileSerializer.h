@@ -24,6 +24,9 @@
 
 #include <iosfwd>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
@@ -41,6 +44,15 @@ class PatchNode;
 
 namespace IO
 {
+/**
+ * Serializes nodes to the text based map formats.
+ *
+ * The brushes, patches and entity properties of all nodes passed to beginFile are
+ * serialized in parallel up front, in chunks of consecutive nodes that share one buffer.
+ * The remaining structure of the file is written serially into a separate buffer, and the
+ * precomputed strings are spliced in by reference. The output is assembled in parallel
+ * into a single buffer of the exact final size and written to the stream in endFile.
+ */
 class MapFileSerializer : public NodeSerializer
 {
 private:
@@ -51,10 +63,25 @@ private:
 
   struct PrecomputedString
   {
-    std::string string;
+    std::string_view string;
     size_t lineCount;
   };
+  std::vector<std::string> m_precomputedChunks;
   std::unordered_map<const Model::Node*, PrecomputedString> m_nodeToPrecomputedString;
+  std::unordered_map<const std::vector<Model::EntityProperty>*, PrecomputedString>
+    m_propertiesToPrecomputedString;
+
+  /**
+   * The output consists of the text in m_buffer up to bufferEnd, followed by the
+   * precomputed string, for each segment in order, followed by the remainder of m_buffer.
+   */
+  struct Segment
+  {
+    size_t bufferEnd;
+    std::string_view precomputed;
+  };
+  std::string m_buffer;
+  std::vector<Segment> m_segments;
 
 public:
   static std::unique_ptr<NodeSerializer> create(
@@ -69,6 +96,7 @@ private:
 
   void doBeginEntity(const Model::Node* node) override;
   void doEndEntity(const Model::Node* node) override;
+  void doEntityProperties(const std::vector<Model::EntityProperty>& properties) override;
   void doEntityProperty(const Model::EntityProperty& attribute) override;
   void doBrush(const Model::BrushNode* brush) override;
   void doBrushFace(const Model::BrushFace& face) override;
@@ -76,14 +104,17 @@ private:
   void doPatch(const Model::PatchNode* patchNode) override;
 
 private:
+  void writePrecomputedString(const PrecomputedString& precomputedString);
   void setFilePosition(const Model::Node* node);
   size_t startLine();
 
 private: // threadsafe
-  virtual void doWriteBrushFace(
-    std::ostream& stream, const Model::BrushFace& face) const = 0;
-  PrecomputedString writeBrushFaces(const Model::Brush& brush) const;
-  PrecomputedString writePatch(const Model::BezierPatch& patch) const;
+  virtual void doWriteBrushFace(std::string& str, const Model::BrushFace& face) const = 0;
+  size_t writeBrushFaces(std::string& str, const Model::Brush& brush) const;
+  size_t writePatch(std::string& str, const Model::BezierPatch& patch) const;
+  size_t writeEntityProperties(
+    std::string& str, const std::vector<Model::EntityProperty>& properties) const;
+  void writeEntityProperty(std::string& str, const Model::EntityProperty& property) const;
 };
 } // namespace IO
 } // namespace TrenchBroom
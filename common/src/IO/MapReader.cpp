@@ -19,6 +19,8 @@
 
 #include "MapReader.h"
 
+#include "IO/CollectingParserStatus.h"
+#include "IO/MapCache.h"
 #include "IO/ParserStatus.h"
 #include "Model/BrushError.h"
 #include "Model/BrushFace.h"
@@ -75,6 +77,76 @@ void MapReader::readEntities(const vm::bbox3& worldBounds, ParserStatus& status)
   createNodes(status);
 }
 
+namespace
+{
+/**
+ * Collects the messages logged while parsing so that they can be stored in a map cache.
+ * The progress is forwarded to the given status.
+ */
+class CachingParserStatus : public CollectingParserStatus
+{
+private:
+  ParserStatus& m_status;
+
+public:
+  explicit CachingParserStatus(ParserStatus& status)
+    : CollectingParserStatus{status}
+    , m_status{status}
+  {
+  }
+
+private:
+  void doProgress(const double progress) override { m_status.progress(progress); }
+};
+} // namespace
+
+void MapReader::readEntities(
+  const vm::bbox3& worldBounds,
+  const MapCacheKey& cacheKey,
+  std::ostream& cacheStream,
+  ParserStatus& status)
+{
+  m_worldBounds = worldBounds;
+
+  auto cachingStatus = CachingParserStatus{status};
+  try
+  {
+    parseEntities(cachingStatus);
+  }
+  catch (...)
+  {
+    CollectingParserStatus::logMessages(status, cachingStatus.messages());
+    throw;
+  }
+
+  auto cache = MapCache{std::move(m_objectInfos), std::move(cachingStatus).messages()};
+  CollectingParserStatus::logMessages(status, cache.messages);
+  writeMapCache(cacheStream, cacheKey, cache);
+  m_objectInfos = std::move(cache.objectInfos);
+
+  createNodes(status);
+}
+
+bool MapReader::readCachedEntities(
+  const std::string_view cache,
+  const MapCacheKey& cacheKey,
+  const vm::bbox3& worldBounds,
+  ParserStatus& status)
+{
+  auto mapCache = readMapCache(cache, cacheKey);
+  if (!mapCache)
+  {
+    return false;
+  }
+
+  CollectingParserStatus::logMessages(status, mapCache->messages);
+
+  m_worldBounds = worldBounds;
+  m_objectInfos = std::move(mapCache->objectInfos);
+  createNodes(status);
+  return true;
+}
+
 void MapReader::readBrushes(const vm::bbox3& worldBounds, ParserStatus& status)
 {
   m_worldBounds = worldBounds;
@@ -32,6 +32,7 @@
 #include <vecmath/bbox.h>
 #include <vecmath/forward.h>
 
+#include <iosfwd>
 #include <optional>
 #include <string_view>
 #include <variant>
@@ -54,6 +55,7 @@ class WorldNode;
 
 namespace IO
 {
+struct MapCacheKey;
 class ParserStatus;
 
 /**
@@ -138,6 +140,30 @@ protected:
    * @throws ParserException if parsing fails
    */
   void readEntities(const vm::bbox3& worldBounds, ParserStatus& status);
+  /**
+   * Attempts to parse as one or more entities and writes a map cache of the parsed
+   * objects and of the messages logged while parsing them to the given stream before the
+   * nodes are created. Nothing is written if parsing fails.
+   *
+   * @throws ParserException if parsing fails
+   */
+  void readEntities(
+    const vm::bbox3& worldBounds,
+    const MapCacheKey& cacheKey,
+    std::ostream& cacheStream,
+    ParserStatus& status);
+  /**
+   * Reads the entities from the given map cache instead of parsing them. The messages
+   * stored in the cache are logged to the given status.
+   *
+   * Returns false and does not create any nodes if the cache is malformed or if it was
+   * created for a different key.
+   */
+  bool readCachedEntities(
+    std::string_view cache,
+    const MapCacheKey& cacheKey,
+    const vm::bbox3& worldBounds,
+    ParserStatus& status);
   /**
    * Attempts to parse as one or more brushes without any enclosing entity.
    *
@@ -228,10 +228,7 @@ void NodeSerializer::endEntity(const Model::Node* node)
 void NodeSerializer::entityProperties(
   const std::vector<Model::EntityProperty>& properties)
 {
-  for (const auto& property : properties)
-  {
-    entityProperty(property);
-  }
+  doEntityProperties(properties);
 }
 
 void NodeSerializer::entityProperty(const Model::EntityProperty& property)
@@ -401,5 +398,14 @@ std::string NodeSerializer::escapeEntityProperties(const std::string& str) const
   }
   return kdl::str_escape_if_necessary(str, "\"");
 }
+
+void NodeSerializer::doEntityProperties(
+  const std::vector<Model::EntityProperty>& properties)
+{
+  for (const auto& property : properties)
+  {
+    entityProperty(property);
+  }
+}
 } // namespace IO
 } // namespace TrenchBroom
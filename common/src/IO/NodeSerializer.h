@@ -149,6 +149,7 @@ private:
 
   virtual void doBeginEntity(const Model::Node* node) = 0;
   virtual void doEndEntity(const Model::Node* node) = 0;
+  virtual void doEntityProperties(const std::vector<Model::EntityProperty>& properties);
   virtual void doEntityProperty(const Model::EntityProperty& property) = 0;
 
   virtual void doBrush(const Model::BrushNode* brushNode) = 0;
@@ -74,6 +74,8 @@ private:
 private:
   virtual void doProgress(double progress) = 0;
   virtual void doLog(LogLevel level, const std::string& str);
+
+  friend class CollectingParserStatus;
 };
 } // namespace IO
 } // namespace TrenchBroom
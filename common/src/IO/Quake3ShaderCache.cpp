@@ -0,0 +1,231 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Quake3ShaderCache.h"
+
+#include "Assets/Quake3Shader.h"
+#include "IO/BinaryCache.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+
+#include <functional>
+#include <string>
+
+namespace TrenchBroom
+{
+namespace IO
+{
+namespace
+{
+using namespace BinaryCache;
+
+constexpr auto Magic = std::string_view{"TBSCACHE"};
+constexpr auto Version = std::uint32_t(2);
+
+// writing
+
+void writePath(std::string& buffer, const Path& path)
+{
+  writeString(buffer, path.asString("/"));
+}
+
+void writeShader(std::string& buffer, const Assets::Quake3Shader& shader)
+{
+  writePath(buffer, shader.shaderPath);
+  writePath(buffer, shader.editorImage);
+  writePath(buffer, shader.lightImage);
+  write(buffer, static_cast<std::uint8_t>(shader.culling));
+
+  writeSize(buffer, shader.surfaceParms.size());
+  for (const auto& surfaceParm : shader.surfaceParms)
+  {
+    writeString(buffer, surfaceParm);
+  }
+
+  writeSize(buffer, shader.stages.size());
+  for (const auto& stage : shader.stages)
+  {
+    writePath(buffer, stage.map);
+    writeString(buffer, stage.blendFunc.srcFactor);
+    writeString(buffer, stage.blendFunc.destFactor);
+  }
+}
+
+void writeEntry(std::string& buffer, const Quake3ShaderCacheEntry& entry)
+{
+  writePath(buffer, entry.path);
+  write(buffer, entry.key.sourceSize);
+  write(buffer, entry.key.sourceHash);
+
+  writeFlag(buffer, entry.shaders.has_value());
+  if (entry.shaders)
+  {
+    writeSize(buffer, entry.shaders->size());
+    for (const auto& shader : *entry.shaders)
+    {
+      writeShader(buffer, shader);
+    }
+  }
+
+  writeMessages(buffer, entry.messages);
+  writeString(buffer, entry.error);
+}
+
+// reading
+
+Path readPath(Reader& reader)
+{
+  return Path{readString(reader)};
+}
+
+Assets::Quake3Shader::Culling readCulling(Reader& reader)
+{
+  const auto culling =
+    static_cast<Assets::Quake3Shader::Culling>(read<std::uint8_t>(reader));
+  switch (culling)
+  {
+  case Assets::Quake3Shader::Culling::Front:
+  case Assets::Quake3Shader::Culling::Back:
+  case Assets::Quake3Shader::Culling::None:
+    return culling;
+  }
+  throw ReaderException{"Unknown culling mode"};
+}
+
+Assets::Quake3Shader readShader(Reader& reader)
+{
+  auto shader = Assets::Quake3Shader();
+  shader.shaderPath = readPath(reader);
+  shader.editorImage = readPath(reader);
+  shader.lightImage = readPath(reader);
+  shader.culling = readCulling(reader);
+
+  const auto surfaceParmCount = readCount(reader);
+  for (size_t i = 0; i < surfaceParmCount; ++i)
+  {
+    shader.surfaceParms.insert(readString(reader));
+  }
+
+  const auto stageCount = readCount(reader);
+  shader.stages.reserve(stageCount);
+  for (size_t i = 0; i < stageCount; ++i)
+  {
+    auto& stage = shader.addStage();
+    stage.map = readPath(reader);
+    stage.blendFunc.srcFactor = readString(reader);
+    stage.blendFunc.destFactor = readString(reader);
+  }
+
+  return shader;
+}
+
+Quake3ShaderCacheEntry readEntry(Reader& reader)
+{
+  auto path = readPath(reader);
+  const auto sourceSize = read<std::uint64_t>(reader);
+  const auto sourceHash = read<std::uint64_t>(reader);
+
+  auto shaders = std::optional<std::vector<Assets::Quake3Shader>>{};
+  if (readFlag(reader))
+  {
+    shaders = std::vector<Assets::Quake3Shader>{};
+    const auto shaderCount = readCount(reader);
+    shaders->reserve(shaderCount);
+    for (size_t i = 0; i < shaderCount; ++i)
+    {
+      shaders->push_back(readShader(reader));
+    }
+  }
+
+  auto messages = readMessages(reader);
+  auto error = readString(reader);
+
+  return Quake3ShaderCacheEntry{
+    std::move(path),
+    Quake3ShaderCacheKey{sourceSize, sourceHash},
+    std::move(shaders),
+    std::move(messages),
+    std::move(error)};
+}
+} // namespace
+
+bool operator==(const Quake3ShaderCacheKey& lhs, const Quake3ShaderCacheKey& rhs)
+{
+  return lhs.sourceSize == rhs.sourceSize && lhs.sourceHash == rhs.sourceHash;
+}
+
+bool operator!=(const Quake3ShaderCacheKey& lhs, const Quake3ShaderCacheKey& rhs)
+{
+  return !(lhs == rhs);
+}
+
+Quake3ShaderCacheKey makeQuake3ShaderCacheKey(const std::string_view source)
+{
+  return Quake3ShaderCacheKey{
+    static_cast<std::uint64_t>(source.size()),
+    static_cast<std::uint64_t>(std::hash<std::string_view>{}(source))};
+}
+
+void writeQuake3ShaderCache(
+  std::ostream& stream, const std::vector<Quake3ShaderCacheEntry>& entries)
+{
+  auto buffer = beginCache(Magic, Version);
+
+  writeSize(buffer, entries.size());
+  for (const auto& entry : entries)
+  {
+    writeEntry(buffer, entry);
+  }
+
+  endCache(buffer, Magic, stream);
+}
+
+std::optional<std::vector<Quake3ShaderCacheEntry>> readQuake3ShaderCache(
+  const std::string_view cache)
+{
+  try
+  {
+    auto reader = Reader::from(cache.data(), cache.data() + cache.size());
+    if (!readHeader(reader, Magic, Version))
+    {
+      return std::nullopt;
+    }
+
+    auto entries = std::vector<Quake3ShaderCacheEntry>{};
+    const auto entryCount = readCount(reader);
+    entries.reserve(entryCount);
+    for (size_t i = 0; i < entryCount; ++i)
+    {
+      entries.push_back(readEntry(reader));
+    }
+
+    if (!readTrailer(reader, Magic))
+    {
+      return std::nullopt;
+    }
+
+    return entries;
+  }
+  catch (const ReaderException&)
+  {
+    return std::nullopt;
+  }
+}
+} // namespace IO
+} // namespace TrenchBroom
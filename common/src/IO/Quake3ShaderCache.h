@@ -0,0 +1,91 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/CollectingParserStatus.h"
+#include "IO/Path.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Assets
+{
+class Quake3Shader;
+}
+
+namespace IO
+{
+/**
+ * Identifies the contents of a shader script. Cached shaders are only used if the key of
+ * the cache entry matches the key of the shader script being loaded.
+ */
+struct Quake3ShaderCacheKey
+{
+  std::uint64_t sourceSize;
+  std::uint64_t sourceHash;
+};
+
+bool operator==(const Quake3ShaderCacheKey& lhs, const Quake3ShaderCacheKey& rhs);
+bool operator!=(const Quake3ShaderCacheKey& lhs, const Quake3ShaderCacheKey& rhs);
+
+/**
+ * Computes the cache key for the given shader script contents.
+ */
+Quake3ShaderCacheKey makeQuake3ShaderCacheKey(std::string_view source);
+
+/**
+ * The result of parsing the shader script at the given path along with the messages that
+ * were logged while parsing it.
+ */
+struct Quake3ShaderCacheEntry
+{
+  Path path;
+  Quake3ShaderCacheKey key;
+  /** The shaders, or nothing if the script is malformed. */
+  std::optional<std::vector<Assets::Quake3Shader>> shaders;
+  std::vector<CollectingParserStatus::Message> messages;
+  /** The reason why the script could not be parsed. */
+  std::string error;
+};
+
+/**
+ * Writes the given cache entries to the given stream in a binary format.
+ *
+ * The cache is only meant to be read on the machine that wrote it.
+ */
+void writeQuake3ShaderCache(
+  std::ostream& stream, const std::vector<Quake3ShaderCacheEntry>& entries);
+
+/**
+ * Reads the cache entries from the given shader cache.
+ *
+ * Returns an empty optional if the cache was written by a different version or if it is
+ * malformed.
+ */
+std::optional<std::vector<Quake3ShaderCacheEntry>> readQuake3ShaderCache(
+  std::string_view cache);
+} // namespace IO
+} // namespace TrenchBroom
@@ -20,30 +20,167 @@
 #include "Quake3ShaderFileSystem.h"
 
 #include "Assets/Quake3Shader.h"
+#include "Exceptions.h"
+#include "IO/CollectingParserStatus.h"
+#include "IO/DiskIO.h"
 #include "IO/File.h"
 #include "IO/FileMatcher.h"
+#include "IO/Quake3ShaderCache.h"
 #include "IO/Quake3ShaderParser.h"
-#include "IO/SimpleParserStatus.h"
 #include "Logger.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
 {
 namespace IO
 {
+namespace
+{
+struct ShaderScript
+{
+  Path path;
+  Path filePath;
+  std::string source;
+  Quake3ShaderCacheKey key;
+
+  /** Whether the shaders were taken from the shader cache. */
+  bool cached = false;
+  /** The shaders, or nothing if the script is malformed. */
+  std::optional<std::vector<Assets::Quake3Shader>> shaders = std::nullopt;
+  /** The messages logged while parsing the script. */
+  std::vector<CollectingParserStatus::Message> messages = {};
+  /** The reason why the script could not be parsed. */
+  std::string error = {};
+};
+
+std::vector<ShaderScript> readShaderScripts(
+  const FileSystem& fs, const std::vector<Path>& paths)
+{
+  return kdl::vec_transform(paths, [&](const auto& path) {
+    const auto file = fs.openFile(path);
+    auto bufferedReader = file->reader().buffer();
+    auto source = std::string{bufferedReader.stringView()};
+    const auto key = makeQuake3ShaderCacheKey(source);
+    return ShaderScript{path, file->path(), std::move(source), key};
+  });
+}
+
+std::vector<Quake3ShaderCacheEntry> readShaderCache(const Path& cachePath, Logger& logger)
+{
+  if (Disk::fileExists(cachePath))
+  {
+    try
+    {
+      const auto file = Disk::openFile(cachePath);
+      auto bufferedReader = file->reader().buffer();
+      if (auto entries = readQuake3ShaderCache(bufferedReader.stringView()))
+      {
+        return std::move(*entries);
+      }
+    }
+    catch (const Exception& e)
+    {
+      logger.warn() << "Could not read shader cache " << cachePath.asString() << ": "
+                    << e.what();
+    }
+  }
+
+  return {};
+}
+
+void writeShaderCache(
+  const Path& cachePath, const std::vector<ShaderScript>& scripts, Logger& logger)
+{
+  const auto entries = kdl::vec_transform(scripts, [](const auto& script) {
+    return Quake3ShaderCacheEntry{
+      script.path, script.key, script.shaders, script.messages, script.error};
+  });
+
+  try
+  {
+    auto stream = std::ostringstream{};
+    writeQuake3ShaderCache(stream, entries);
+    Disk::createFileAtomically(cachePath, stream.str());
+  }
+  catch (const Exception& e)
+  {
+    logger.warn() << "Could not write shader cache " << cachePath.asString() << ": "
+                  << e.what();
+  }
+}
+
+/**
+ * Takes the results of the scripts whose keys match the given cache entries from the
+ * cache. Returns whether the cache contains exactly the given scripts and need not be
+ * written again.
+ */
+bool useCachedShaders(
+  std::vector<ShaderScript>& scripts, std::vector<Quake3ShaderCacheEntry> entries)
+{
+  auto entriesByPath = std::unordered_map<std::string, Quake3ShaderCacheEntry*>{};
+  for (auto& entry : entries)
+  {
+    entriesByPath.emplace(entry.path.asString("/"), &entry);
+  }
+
+  auto cachedCount = size_t(0);
+  for (auto& script : scripts)
+  {
+    const auto it = entriesByPath.find(script.path.asString("/"));
+    if (it != entriesByPath.end() && it->second->key == script.key)
+    {
+      script.shaders = std::move(it->second->shaders);
+      script.messages = std::move(it->second->messages);
+      script.error = std::move(it->second->error);
+      script.cached = true;
+      ++cachedCount;
+    }
+  }
+
+  return cachedCount == scripts.size() && entries.size() == scripts.size();
+}
+
+void parseShaderScripts(std::vector<ShaderScript>& scripts, Logger& logger)
+{
+  kdl::parallel_for(scripts.size(), [&](const size_t i) {
+    auto& script = scripts[i];
+    if (!script.cached)
+    {
+      auto status = CollectingParserStatus{logger, script.filePath.asString()};
+      try
+      {
+        auto parser = Quake3ShaderParser{script.source};
+        script.shaders = parser.parse(status);
+      }
+      catch (const ParserException& e)
+      {
+        script.error = e.what();
+      }
+      script.messages = std::move(status).messages();
+    }
+  });
+}
+} // namespace
+
 Quake3ShaderFileSystem::Quake3ShaderFileSystem(
   std::shared_ptr<FileSystem> fs,
   Path shaderSearchPath,
   std::vector<Path> textureSearchPaths,
-  Logger& logger)
+  Logger& logger,
+  std::optional<Path> cachePath)
   : ImageFileSystemBase(std::move(fs), Path())
   , m_shaderSearchPath(std::move(shaderSearchPath))
   , m_textureSearchPaths(std::move(textureSearchPaths))
+  , m_cachePath(std::move(cachePath))
   , m_logger(logger)
 {
   initialize();
@@ -66,20 +203,38 @@ std::vector<Assets::Quake3Shader> Quake3ShaderFileSystem::loadShaders() const
   {
     const auto paths =
       next().findItems(m_shaderSearchPath, FileExtensionMatcher("shader"));
-    for (const auto& path : paths)
+    auto scripts = readShaderScripts(next(), paths);
+
+    auto cacheIsUpToDate = false;
+    if (m_cachePath)
     {
-      const auto file = next().openFile(path);
-      auto bufferedReader = file->reader().buffer();
+      cacheIsUpToDate =
+        useCachedShaders(scripts, readShaderCache(*m_cachePath, m_logger));
+    }
 
-      try
+    // the scripts are parsed in parallel, and the messages are logged afterwards
+    parseShaderScripts(scripts, m_logger);
+
+    if (m_cachePath && !cacheIsUpToDate)
+    {
+      writeShaderCache(*m_cachePath, scripts, m_logger);
+    }
+
+    for (auto& script : scripts)
+    {
+      for (const auto& [level, message] : script.messages)
       {
-        Quake3ShaderParser parser(bufferedReader.stringView());
-        SimpleParserStatus status(m_logger, file->path().asString());
-        result = kdl::vec_concat(std::move(result), parser.parse(status));
+        m_logger.log(level, message);
       }
-      catch (const ParserException& e)
+
+      if (script.shaders)
       {
-        m_logger.warn() << "Skipping malformed shader file " << path << ": " << e.what();
+        result = kdl::vec_concat(std::move(result), std::move(*script.shaders));
+      }
+      else
+      {
+        m_logger.warn() << "Skipping malformed shader file " << script.path << ": "
+                        << script.error;
       }
     }
   }
@@ -112,6 +267,16 @@ void Quake3ShaderFileSystem::linkTextures(
   const std::vector<Path>& textures, std::vector<Assets::Quake3Shader>& shaders)
 {
   m_logger.debug() << "Linking textures...";
+
+  // If several shaders have the same path, only the first one is linked to a texture.
+  auto shaderIndices = std::unordered_map<std::string, size_t>{};
+  shaderIndices.reserve(shaders.size());
+  for (size_t i = 0; i < shaders.size(); ++i)
+  {
+    shaderIndices.emplace(shaders[i].shaderPath.asString("/"), i);
+  }
+
+  auto linked = std::vector<bool>(shaders.size(), false);
   for (const auto& texture : textures)
   {
     const auto shaderPath = texture.deleteExtension();
@@ -119,22 +284,18 @@ void Quake3ShaderFileSystem::linkTextures(
     // Only link a shader if it has not been linked yet.
     if (!fileExists(shaderPath))
     {
-      const auto shaderIt = std::find_if(
-        std::begin(shaders), std::end(shaders), [&shaderPath](const auto& shader) {
-          return shaderPath == shader.shaderPath;
-        });
-
-      if (shaderIt != std::end(shaders))
+      const auto shaderIt = shaderIndices.find(shaderPath.asString("/"));
+      if (shaderIt != std::end(shaderIndices))
       {
         // Found a matching shader.
-        auto& shader = *shaderIt;
+        const auto shaderIndex = shaderIt->second;
+        auto& shader = shaders[shaderIndex];
 
         auto shaderFile =
           std::make_shared<ObjectFile<Assets::Quake3Shader>>(shaderPath, shader);
         m_root.addFile(shaderPath, shaderFile);
 
-        // Remove the shader so that we don't revisit it when linking standalone shaders.
-        shaders.erase(shaderIt);
+        linked[shaderIndex] = true;
       }
       else
       {
@@ -149,6 +310,19 @@ void Quake3ShaderFileSystem::linkTextures(
       }
     }
   }
+
+  // Remove the linked shaders so that we don't revisit them when linking standalone
+  // shaders.
+  auto unlinkedShaders = std::vector<Assets::Quake3Shader>{};
+  unlinkedShaders.reserve(shaders.size());
+  for (size_t i = 0; i < shaders.size(); ++i)
+  {
+    if (!linked[i])
+    {
+      unlinkedShaders.push_back(std::move(shaders[i]));
+    }
+  }
+  shaders = std::move(unlinkedShaders);
 }
 
 void Quake3ShaderFileSystem::linkStandaloneShaders(
@@ -21,6 +21,7 @@
 
 #include "IO/ImageFileSystem.h"
 
+#include <optional>
 #include <vector>
 
 namespace TrenchBroom
@@ -46,6 +47,7 @@ class Quake3ShaderFileSystem : public ImageFileSystemBase
 private:
   Path m_shaderSearchPath;
   std::vector<Path> m_textureSearchPaths;
+  std::optional<Path> m_cachePath;
   Logger& m_logger;
 
 public:
@@ -56,17 +58,23 @@ public:
    * any texture found that does not have a corresponding shader will have a shader
    * generated for it.
    *
+   * If a cache path is given, the shaders parsed from each shader script are cached in a
+   * file at that path, and shader scripts whose contents have not changed are not parsed
+   * again.
+   *
    * @param fs the filesystem to use when searching for shaders and linking image
    * resources
    * @param shaderSearchPath the path at which to search for shader scripts
    * @param textureSearchPaths the paths at which to search for texture images
    * @param logger the logger to use
+   * @param cachePath the absolute path of the shader cache file, if any
    */
   Quake3ShaderFileSystem(
     std::shared_ptr<FileSystem> fs,
     Path shaderSearchPath,
     std::vector<Path> textureSearchPaths,
-    Logger& logger);
+    Logger& logger,
+    std::optional<Path> cachePath = std::nullopt);
 
 private:
   void doReadDirectory() override;
@@ -20,6 +20,8 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
+#include <optional>
 #include <string>
 
 #include <kdl/string_utils.h>
@@ -88,14 +90,115 @@ public:
   template <typename T>
   T toFloat() const
   {
+    if (const auto value = parseSimpleDecimal(m_begin, m_end))
+    {
+      return static_cast<T>(*value);
+    }
     return static_cast<T>(kdl::str_to_double(std::string(m_begin, m_end)).value_or(0.0));
   }
 
   template <typename T>
   T toInteger() const
   {
+    if (const auto value = parseSimpleInteger(m_begin, m_end))
+    {
+      return static_cast<T>(*value);
+    }
     return static_cast<T>(kdl::str_to_long(std::string(m_begin, m_end)).value_or(0l));
   }
+
+private:
+  static bool isDigit(const char c) { return c >= '0' && c <= '9'; }
+
+  /**
+   * Parses a decimal number without an exponent if its digits fit into the mantissa of a
+   * double and it has at most 22 fractional digits. Then both the digits and the
+   * corresponding power of ten are exactly representable, and a single division yields
+   * the correctly rounded result, which is what str_to_double returns, too.
+   *
+   * Returns an empty optional for any other string.
+   */
+  static std::optional<double> parseSimpleDecimal(const char* begin, const char* end)
+  {
+    static constexpr double PowersOfTen[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    constexpr auto MaxMantissa = std::uint64_t(1) << 53;
+    constexpr auto MaxFractionDigits = sizeof(PowersOfTen) / sizeof(double) - 1u;
+
+    const auto* cur = begin;
+    const auto negative = cur != end && *cur == '-';
+    if (cur != end && (*cur == '-' || *cur == '+'))
+    {
+      ++cur;
+    }
+
+    auto mantissa = std::uint64_t(0);
+    auto digitCount = size_t(0);
+    auto fractionDigitCount = size_t(0);
+    for (; cur != end && isDigit(*cur); ++cur, ++digitCount)
+    {
+      mantissa = mantissa * 10u + static_cast<std::uint64_t>(*cur - '0');
+      if (mantissa > MaxMantissa)
+      {
+        return std::nullopt;
+      }
+    }
+
+    if (cur != end && *cur == '.')
+    {
+      ++cur;
+      for (; cur != end && isDigit(*cur); ++cur, ++digitCount, ++fractionDigitCount)
+      {
+        mantissa = mantissa * 10u + static_cast<std::uint64_t>(*cur - '0');
+        if (mantissa > MaxMantissa)
+        {
+          return std::nullopt;
+        }
+      }
+    }
+
+    if (cur != end || digitCount == 0u || fractionDigitCount > MaxFractionDigits)
+    {
+      return std::nullopt;
+    }
+
+    const auto value = static_cast<double>(mantissa) / PowersOfTen[fractionDigitCount];
+    return negative ? -value : value;
+  }
+
+  /**
+   * Parses an optionally signed integer with at most 9 digits, which fits into a long on
+   * every platform. Returns an empty optional for any other string.
+   */
+  static std::optional<long> parseSimpleInteger(const char* begin, const char* end)
+  {
+    constexpr auto MaxDigitCount = size_t(9);
+
+    const auto* cur = begin;
+    const auto negative = cur != end && *cur == '-';
+    if (cur != end && (*cur == '-' || *cur == '+'))
+    {
+      ++cur;
+    }
+
+    if (cur == end || static_cast<size_t>(end - cur) > MaxDigitCount)
+    {
+      return std::nullopt;
+    }
+
+    auto value = 0l;
+    for (; cur != end; ++cur)
+    {
+      if (!isDigit(*cur))
+      {
+        return std::nullopt;
+      }
+      value = value * 10 + (*cur - '0');
+    }
+
+    return negative ? -value : value;
+  }
 };
 } // namespace IO
 } // namespace TrenchBroom
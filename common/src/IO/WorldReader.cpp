@@ -20,6 +20,7 @@
 #include "WorldReader.h"
 
 #include "Color.h"
+#include "IO/MapCache.h"
 #include "IO/ParserStatus.h"
 #include "Model/BrushNode.h"
 #include "Model/Entity.h"
@@ -69,11 +70,8 @@ WorldReader::WorldReader(
   const Model::MapFormat sourceAndTargetMapFormat,
   const Model::EntityPropertyConfig& entityPropertyConfig)
   : MapReader(
-    std::move(str),
-    sourceAndTargetMapFormat,
-    sourceAndTargetMapFormat,
-    entityPropertyConfig,
-    {})
+    str, sourceAndTargetMapFormat, sourceAndTargetMapFormat, entityPropertyConfig, {})
+  , m_str(str)
   , m_world(std::make_unique<Model::WorldNode>(
       entityPropertyConfig, Model::Entity{}, sourceAndTargetMapFormat))
 {
@@ -124,6 +122,30 @@ std::unique_ptr<Model::WorldNode> WorldReader::read(
   const vm::bbox3& worldBounds, ParserStatus& status)
 {
   readEntities(worldBounds, status);
+  return finishWorld(status);
+}
+
+std::unique_ptr<Model::WorldNode> WorldReader::read(
+  const vm::bbox3& worldBounds, std::ostream& cacheStream, ParserStatus& status)
+{
+  readEntities(
+    worldBounds, makeMapCacheKey(m_str, m_world->mapFormat()), cacheStream, status);
+  return finishWorld(status);
+}
+
+std::unique_ptr<Model::WorldNode> WorldReader::readFromCache(
+  const std::string_view cache, const vm::bbox3& worldBounds, ParserStatus& status)
+{
+  if (!readCachedEntities(
+        cache, makeMapCacheKey(m_str, m_world->mapFormat()), worldBounds, status))
+  {
+    return nullptr;
+  }
+  return finishWorld(status);
+}
+
+std::unique_ptr<Model::WorldNode> WorldReader::finishWorld(ParserStatus& status)
+{
   sanitizeLayerSortIndicies(status);
   m_world->rebuildNodeTree();
   m_world->enableNodeTreeUpdates();
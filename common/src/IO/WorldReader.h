@@ -22,8 +22,10 @@
 #include "Exceptions.h"
 #include "IO/MapReader.h"
 
+#include <iosfwd>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -52,6 +54,7 @@ public:
  */
 class WorldReader : public MapReader
 {
+  std::string_view m_str;
   std::unique_ptr<Model::WorldNode> m_world;
 
 public:
@@ -63,6 +66,25 @@ public:
   std::unique_ptr<Model::WorldNode> read(
     const vm::bbox3& worldBounds, ParserStatus& status);
 
+  /**
+   * Reads the world like read(), and additionally writes a map cache for the parsed
+   * objects to the given stream.
+   *
+   * @throws ParserException if parsing fails
+   */
+  std::unique_ptr<Model::WorldNode> read(
+    const vm::bbox3& worldBounds, std::ostream& cacheStream, ParserStatus& status);
+
+  /**
+   * Reads the world from the given map cache instead of parsing the string passed to the
+   * constructor.
+   *
+   * Returns null if the cache was not created from the same string and map format or if
+   * it is malformed. In that case, the world can still be read by calling read().
+   */
+  std::unique_ptr<Model::WorldNode> readFromCache(
+    std::string_view cache, const vm::bbox3& worldBounds, ParserStatus& status);
+
   /**
    * Try to parse the given string as the given map formats, in order.
    * Returns the world if parsing is successful, otherwise throws an exception.
@@ -82,6 +104,7 @@ public:
     ParserStatus& status);
 
 private:
+  std::unique_ptr<Model::WorldNode> finishWorld(ParserStatus& status);
   void sanitizeLayerSortIndicies(ParserStatus& status);
 
 private: // implement MapReader interface
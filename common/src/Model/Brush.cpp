@@ -47,6 +47,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom
@@ -1150,18 +1151,34 @@ std::vector<kdl::result<Brush, BrushError>> Brush::subtract(
   const std::vector<const Brush*>& subtrahends) const
 {
   auto result = std::vector<BrushGeometry>{*m_geometry};
+  auto nextResults = std::vector<BrushGeometry>{};
 
   for (const auto* subtrahend : subtrahends)
   {
-    auto nextResults = std::vector<BrushGeometry>{};
+    // Subtracting a disjoint subtrahend returns the fragment unchanged, so such fragments
+    // are skipped. The bounds are enlarged to leave fragments that are within the
+    // polyhedron's epsilon of the subtrahend to the exact test.
+    const auto subtrahendBounds = subtrahend->bounds().expand(1.0);
 
-    for (const BrushGeometry& fragment : result)
+    for (BrushGeometry& fragment : result)
     {
-      auto subFragments = fragment.subtract(*subtrahend->m_geometry);
-      nextResults = kdl::vec_concat(std::move(nextResults), std::move(subFragments));
+      if (!fragment.bounds().intersects(subtrahendBounds))
+      {
+        nextResults.push_back(std::move(fragment));
+      }
+      else
+      {
+        auto subFragments = fragment.subtract(*subtrahend->m_geometry);
+        nextResults.insert(
+          std::end(nextResults),
+          std::make_move_iterator(std::begin(subFragments)),
+          std::make_move_iterator(std::end(subFragments)));
+      }
     }
 
-    result = std::move(nextResults);
+    // keep the allocated capacity of both lists for the next subtrahend
+    std::swap(result, nextResults);
+    nextResults.clear();
   }
 
   return kdl::vec_transform(result, [&](const auto& geometry) {
@@ -86,7 +86,7 @@ BrushFace::BrushFace(BrushFace&& other) noexcept
   : Taggable(other)
   , m_points(std::move(other.m_points))
   , m_boundary(std::move(other.m_boundary))
-  , m_attributes(std::move(other.m_attributes))
+  , m_attributes(other.m_attributes)
   , m_textureReference(std::move(other.m_textureReference))
   , m_texCoordSystem(std::move(other.m_texCoordSystem))
   , m_geometry(other.m_geometry)
@@ -232,7 +232,7 @@ BrushFace::BrushFace(
   std::unique_ptr<TexCoordSystem> texCoordSystem)
   : m_points(points)
   , m_boundary(boundary)
-  , m_attributes(attributes)
+  , m_attributes(std::make_shared<const BrushFaceAttributes>(attributes))
   , m_texCoordSystem(std::move(texCoordSystem))
   , m_geometry(nullptr)
   , m_lineNumber(0)
@@ -301,16 +301,18 @@ void BrushFace::copyTexCoordSystemFromFace(
     m_texCoordSystem->getTexCoords(refPoint, attributes, vm::vec2f::one());
 
   m_texCoordSystem->updateNormal(
-    sourceFacePlane.normal, m_boundary.normal, m_attributes, wrapStyle);
+    sourceFacePlane.normal, m_boundary.normal, *m_attributes, wrapStyle);
 
   // Adjust the offset on this face so that the texture coordinates at the refPoint stay
   // the same
   if (!vm::is_zero(seam.direction, vm::C::almost_zero()))
   {
     const auto currentCoords =
-      m_texCoordSystem->getTexCoords(refPoint, m_attributes, vm::vec2f::one());
+      m_texCoordSystem->getTexCoords(refPoint, *m_attributes, vm::vec2f::one());
     const auto offsetChange = desriedCoords - currentCoords;
-    m_attributes.setOffset(correct(modOffset(m_attributes.offset() + offsetChange), 4));
+    updateAttributes([&](auto& attributes) {
+      attributes.setOffset(correct(modOffset(attributes.offset() + offsetChange), 4));
+    });
   }
 }
 
@@ -418,36 +420,38 @@ bool BrushFace::coplanarWith(const vm::plane3d& plane) const
 
 const BrushFaceAttributes& BrushFace::attributes() const
 {
-  return m_attributes;
+  return *m_attributes;
 }
 
 void BrushFace::setAttributes(const BrushFaceAttributes& attributes)
 {
-  const float oldRotation = m_attributes.rotation();
-  m_attributes = attributes;
-  m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
+  const float oldRotation = m_attributes->rotation();
+  updateAttributes([&](auto& currentAttributes) { currentAttributes = attributes; });
+  m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes->rotation());
 }
 
 bool BrushFace::setAttributes(const BrushFace& other)
 {
   auto result = false;
-  result |= m_attributes.setTextureName(other.attributes().textureName());
-  result |= m_attributes.setXOffset(other.attributes().xOffset());
-  result |= m_attributes.setYOffset(other.attributes().yOffset());
-  result |= m_attributes.setRotation(other.attributes().rotation());
-  result |= m_attributes.setXScale(other.attributes().xScale());
-  result |= m_attributes.setYScale(other.attributes().yScale());
-  result |= m_attributes.setSurfaceContents(other.attributes().surfaceContents());
-  result |= m_attributes.setSurfaceFlags(other.attributes().surfaceFlags());
-  result |= m_attributes.setSurfaceValue(other.attributes().surfaceValue());
+  updateAttributes([&](auto& attributes) {
+    result |= attributes.setTextureName(other.attributes().textureName());
+    result |= attributes.setXOffset(other.attributes().xOffset());
+    result |= attributes.setYOffset(other.attributes().yOffset());
+    result |= attributes.setRotation(other.attributes().rotation());
+    result |= attributes.setXScale(other.attributes().xScale());
+    result |= attributes.setYScale(other.attributes().yScale());
+    result |= attributes.setSurfaceContents(other.attributes().surfaceContents());
+    result |= attributes.setSurfaceFlags(other.attributes().surfaceFlags());
+    result |= attributes.setSurfaceValue(other.attributes().surfaceValue());
+  });
   return result;
 }
 
 int BrushFace::resolvedSurfaceContents() const
 {
-  if (m_attributes.surfaceContents())
+  if (m_attributes->surfaceContents())
   {
-    return *m_attributes.surfaceContents();
+    return *m_attributes->surfaceContents();
   }
   if (texture())
   {
@@ -461,9 +465,9 @@ int BrushFace::resolvedSurfaceContents() const
 
 int BrushFace::resolvedSurfaceFlags() const
 {
-  if (m_attributes.surfaceFlags())
+  if (m_attributes->surfaceFlags())
   {
-    return *m_attributes.surfaceFlags();
+    return *m_attributes->surfaceFlags();
   }
   if (texture())
   {
@@ -477,9 +481,9 @@ int BrushFace::resolvedSurfaceFlags() const
 
 float BrushFace::resolvedSurfaceValue() const
 {
-  if (m_attributes.surfaceValue())
+  if (m_attributes->surfaceValue())
   {
-    return *m_attributes.surfaceValue();
+    return *m_attributes->surfaceValue();
   }
   if (texture())
   {
@@ -493,14 +497,14 @@ float BrushFace::resolvedSurfaceValue() const
 
 Color BrushFace::resolvedColor() const
 {
-  return m_attributes.color().value_or(Color{});
+  return m_attributes->color().value_or(Color{});
 }
 
 void BrushFace::resetTexCoordSystemCache()
 {
   if (m_texCoordSystem != nullptr)
   {
-    m_texCoordSystem->resetCache(m_points[0], m_points[1], m_points[2], m_attributes);
+    m_texCoordSystem->resetCache(m_points[0], m_points[1], m_points[2], *m_attributes);
   }
 }
 
@@ -528,7 +532,7 @@ vm::vec2f BrushFace::textureSize() const
 
 vm::vec2f BrushFace::modOffset(const vm::vec2f& offset) const
 {
-  return m_attributes.modOffset(offset, textureSize());
+  return m_attributes->modOffset(offset, textureSize());
 }
 
 bool BrushFace::setTexture(Assets::Texture* texture)
@@ -565,32 +569,36 @@ void BrushFace::resetTextureAxesToParaxial()
 void BrushFace::convertToParaxial()
 {
   auto [newTexCoordSystem, newAttributes] =
-    m_texCoordSystem->toParaxial(m_points[0], m_points[1], m_points[2], m_attributes);
+    m_texCoordSystem->toParaxial(m_points[0], m_points[1], m_points[2], *m_attributes);
 
-  m_attributes = newAttributes;
+  updateAttributes([&](auto& attributes) { attributes = newAttributes; });
   m_texCoordSystem = std::move(newTexCoordSystem);
 }
 
 void BrushFace::convertToParallel()
 {
   auto [newTexCoordSystem, newAttributes] =
-    m_texCoordSystem->toParallel(m_points[0], m_points[1], m_points[2], m_attributes);
+    m_texCoordSystem->toParallel(m_points[0], m_points[1], m_points[2], *m_attributes);
 
-  m_attributes = newAttributes;
+  updateAttributes([&](auto& attributes) { attributes = newAttributes; });
   m_texCoordSystem = std::move(newTexCoordSystem);
 }
 
 void BrushFace::moveTexture(
   const vm::vec3& up, const vm::vec3& right, const vm::vec2f& offset)
 {
-  m_texCoordSystem->moveTexture(m_boundary.normal, up, right, offset, m_attributes);
+  updateAttributes([&](auto& attributes) {
+    m_texCoordSystem->moveTexture(m_boundary.normal, up, right, offset, attributes);
+  });
 }
 
 void BrushFace::rotateTexture(const float angle)
 {
-  const float oldRotation = m_attributes.rotation();
-  m_texCoordSystem->rotateTexture(m_boundary.normal, angle, m_attributes);
-  m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes.rotation());
+  const float oldRotation = m_attributes->rotation();
+  updateAttributes([&](auto& attributes) {
+    m_texCoordSystem->rotateTexture(m_boundary.normal, angle, attributes);
+  });
+  m_texCoordSystem->setRotation(m_boundary.normal, oldRotation, m_attributes->rotation());
 }
 
 void BrushFace::shearTexture(const vm::vec2f& factors)
@@ -634,14 +642,16 @@ void BrushFace::flipTexture(
     flipTextureX = !flipTextureX;
   }
 
-  if (flipTextureX)
-  {
-    m_attributes.setXScale(-1.0f * m_attributes.xScale());
-  }
-  else
-  {
-    m_attributes.setYScale(-1.0f * m_attributes.yScale());
-  }
+  updateAttributes([&](auto& attributes) {
+    if (flipTextureX)
+    {
+      attributes.setXScale(-1.0f * attributes.xScale());
+    }
+    else
+    {
+      attributes.setYScale(-1.0f * attributes.yScale());
+    }
+  });
 }
 
 kdl::result<void, BrushError> BrushFace::transform(
@@ -666,14 +676,16 @@ kdl::result<void, BrushError> BrushFace::transform(
   }
 
   return setPoints(m_points[0], m_points[1], m_points[2]).transform([&]() {
-    m_texCoordSystem->transform(
-      oldBoundary,
-      m_boundary,
-      transform,
-      m_attributes,
-      textureSize(),
-      lockTexture,
-      invariant);
+    updateAttributes([&](auto& attributes) {
+      m_texCoordSystem->transform(
+        oldBoundary,
+        m_boundary,
+        transform,
+        attributes,
+        textureSize(),
+        lockTexture,
+        invariant);
+    });
   });
 }
 
@@ -706,18 +718,19 @@ kdl::result<void, BrushError> BrushFace::updatePointsFromVertices()
         // Get the texcoords at the refPoint using the old face's attribs and tex coord
         // system
         const auto desriedCoords =
-          m_texCoordSystem->getTexCoords(refPoint, m_attributes, vm::vec2f::one());
+          m_texCoordSystem->getTexCoords(refPoint, *m_attributes, vm::vec2f::one());
 
         m_texCoordSystem->updateNormal(
-          oldPlane.normal, m_boundary.normal, m_attributes, WrapStyle::Projection);
+          oldPlane.normal, m_boundary.normal, *m_attributes, WrapStyle::Projection);
 
         // Adjust the offset on this face so that the texture coordinates at the refPoint
         // stay the same
         const auto currentCoords =
-          m_texCoordSystem->getTexCoords(refPoint, m_attributes, vm::vec2f::one());
+          m_texCoordSystem->getTexCoords(refPoint, *m_attributes, vm::vec2f::one());
         const auto offsetChange = desriedCoords - currentCoords;
-        m_attributes.setOffset(
-          correct(modOffset(m_attributes.offset() + offsetChange), 4));
+        updateAttributes([&](auto& attributes) {
+          attributes.setOffset(correct(modOffset(attributes.offset() + offsetChange), 4));
+        });
       }
     });
 }
@@ -763,7 +776,7 @@ vm::mat4x4 BrushFace::fromTexCoordSystemMatrix(
 float BrushFace::measureTextureAngle(
   const vm::vec2f& center, const vm::vec2f& point) const
 {
-  return m_texCoordSystem->measureAngle(m_attributes.rotation(), center, point);
+  return m_texCoordSystem->measureAngle(m_attributes->rotation(), center, point);
 }
 
 size_t BrushFace::vertexCount() const
@@ -842,7 +855,7 @@ void BrushFace::deselect()
 
 vm::vec2f BrushFace::textureCoords(const vm::vec3& point) const
 {
-  return m_texCoordSystem->getTexCoords(point, m_attributes, textureSize());
+  return m_texCoordSystem->getTexCoords(point, *m_attributes, textureSize());
 }
 
 FloatType BrushFace::intersectWithRay(const vm::ray3& ray) const
@@ -893,6 +906,17 @@ void BrushFace::correctPoints()
   }
 }
 
+void BrushFace::updateAttributes(
+  const std::function<void(BrushFaceAttributes&)>& update)
+{
+  auto attributes = *m_attributes;
+  update(attributes);
+  if (attributes != *m_attributes)
+  {
+    m_attributes = std::make_shared<const BrushFaceAttributes>(std::move(attributes));
+  }
+}
+
 void BrushFace::setMarked(const bool marked) const
 {
   m_markedToRenderFace = marked;
@@ -35,6 +35,7 @@
 #include <vecmath/vec.h>
 
 #include <array>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -93,7 +94,8 @@ public:
 private:
   BrushFace::Points m_points;
   vm::plane3 m_boundary;
-  BrushFaceAttributes m_attributes;
+  // shared with the copies of this face until either of them changes its attributes
+  std::shared_ptr<const BrushFaceAttributes> m_attributes;
 
   Assets::AssetReference<Assets::Texture> m_textureReference;
   std::unique_ptr<TexCoordSystem> m_texCoordSystem;
@@ -115,7 +117,7 @@ public:
 
   ~BrushFace();
 
-  kdl_reflect_decl(BrushFace, m_points, m_boundary, m_attributes, m_textureReference);
+  kdl_reflect_decl(BrushFace, m_points, m_boundary, *m_attributes, m_textureReference);
 
   /**
    * Creates a face using TB's default texture projection for the given map format and the
@@ -274,6 +276,13 @@ private:
     const vm::vec3& point0, const vm::vec3& point1, const vm::vec3& point2);
   void correctPoints();
 
+  /**
+   * Applies the given function to a copy of the attributes of this face. The attributes
+   * are only replaced if the function changed them, so that an unchanged face keeps
+   * sharing its attributes with the faces it was copied from or to.
+   */
+  void updateAttributes(const std::function<void(BrushFaceAttributes&)>& update);
+
 public: // brush renderer
   /**
    * This is used to cache results of evaluating the BrushRenderer Filter.
@@ -205,6 +205,22 @@ Assets::ModelSpecification Entity::modelSpecification() const
   }
 }
 
+Assets::ModelSpecification Entity::modelSpecification(
+  Assets::ModelSpecificationCache& cache) const
+{
+  if (
+    const auto* pointDefinition =
+      dynamic_cast<const Assets::PointEntityDefinition*>(m_definition.get()))
+  {
+    const auto variableStore = EntityPropertiesVariableStore{*this};
+    return cache.modelSpecification(pointDefinition->modelDefinition(), variableStore);
+  }
+  else
+  {
+    return Assets::ModelSpecification{};
+  }
+}
+
 const vm::mat4x4& Entity::modelTransformation() const
 {
   return m_cachedProperties.modelTransformation;
@@ -38,6 +38,7 @@ namespace Assets
 class EntityDefinition;
 class EntityModelFrame;
 struct ModelSpecification;
+class ModelSpecificationCache;
 } // namespace Assets
 
 namespace Model
@@ -159,6 +160,13 @@ public:
     const EntityPropertyConfig& propertyConfig, const Assets::EntityModelFrame* model);
 
   Assets::ModelSpecification modelSpecification() const;
+
+  /**
+   * Returns the model specification of this entity, using the given cache to avoid
+   * evaluating the model expression again for entities whose relevant properties match.
+   */
+  Assets::ModelSpecification modelSpecification(
+    Assets::ModelSpecificationCache& cache) const;
   const vm::mat4x4& modelTransformation() const;
 
   void unsetEntityDefinitionAndModel();
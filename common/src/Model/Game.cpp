@@ -110,6 +110,11 @@ void Game::writeMap(WorldNode& world, const IO::Path& path) const
   doWriteMap(world, path);
 }
 
+void Game::writeMap(WorldNode& world, std::ostream& stream) const
+{
+  doWriteMap(world, stream);
+}
+
 void Game::exportMap(WorldNode& world, const IO::ExportOptions& options) const
 {
   doExportMap(world, options);
@@ -29,6 +29,7 @@
 #include <vecmath/bbox.h>
 #include <vecmath/forward.h>
 
+#include <iosfwd>
 #include <map>
 #include <memory>
 #include <optional>
@@ -116,6 +117,7 @@ public: // loading and writing map files
     const IO::Path& path,
     Logger& logger) const;
   void writeMap(WorldNode& world, const IO::Path& path) const;
+  void writeMap(WorldNode& world, std::ostream& stream) const;
   void exportMap(WorldNode& world, const IO::ExportOptions& options) const;
 
 public: // parsing and serializing objects
@@ -197,6 +199,7 @@ private: // subclassing interface
     const IO::Path& path,
     Logger& logger) const = 0;
   virtual void doWriteMap(WorldNode& world, const IO::Path& path) const = 0;
+  virtual void doWriteMap(WorldNode& world, std::ostream& stream) const = 0;
   virtual void doExportMap(WorldNode& world, const IO::ExportOptions& options) const = 0;
 
   virtual std::vector<Node*> doParseNodes(
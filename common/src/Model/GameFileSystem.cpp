@@ -197,8 +197,14 @@ void GameFileSystem::addShaderFileSystem(const GameConfig& config, Logger& logge
     auto shaderSearchPath = textureConfig.shaderSearchPath;
     auto textureSearchPaths =
       std::vector<IO::Path>{getRootDirectory(textureConfig.package), IO::Path("models")};
+    auto cachePath = IO::SystemPaths::userDataDirectory() + IO::Path{"cache/shaders"}
+                     + IO::Path{config.name + ".cache"};
     auto shaderFS = std::make_shared<IO::Quake3ShaderFileSystem>(
-      m_next, std::move(shaderSearchPath), std::move(textureSearchPaths), logger);
+      m_next,
+      std::move(shaderSearchPath),
+      std::move(textureSearchPaths),
+      logger,
+      std::move(cachePath));
     m_shaderFS = shaderFS.get();
     m_next = std::move(shaderFS);
   }
@@ -28,11 +28,14 @@
 #include "IO/AssimpParser.h"
 #include "IO/BrushFaceReader.h"
 #include "IO/Bsp29Parser.h"
+#include "IO/CollectingParserStatus.h"
 #include "IO/DefParser.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
 #include "IO/DkmParser.h"
 #include "IO/EntParser.h"
+#include "IO/EntityDefinitionCache.h"
+#include "IO/EntityDefinitionClassInfo.h"
 #include "IO/ExportOptions.h"
 #include "IO/FgdParser.h"
 #include "IO/File.h"
@@ -40,6 +43,7 @@
 #include "IO/GameConfigParser.h"
 #include "IO/IOUtils.h"
 #include "IO/ImageSpriteParser.h"
+#include "IO/MapCache.h"
 #include "IO/Md2Parser.h"
 #include "IO/Md3Parser.h"
 #include "IO/MdlParser.h"
@@ -63,6 +67,8 @@
 #include "Model/GameConfig.h"
 #include "Model/LayerNode.h"
 #include "Model/WorldNode.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
 
 #include <kdl/overload.h>
 #include <kdl/result.h>
@@ -73,8 +79,13 @@
 
 #include <vecmath/vec_io.h>
 
+#include <algorithm>
 #include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace TrenchBroom
@@ -206,6 +217,65 @@ std::unique_ptr<WorldNode> GameImpl::doNewMap(
   return worldNode;
 }
 
+/**
+ * Reads the world from the map cache next to the given map file if the cache is up to
+ * date. Otherwise, parses the map file and writes a new cache once parsing succeeded.
+ */
+static std::unique_ptr<WorldNode> readWorldUsingCache(
+  const std::string_view source,
+  const MapFormat format,
+  const EntityPropertyConfig& entityPropertyConfig,
+  const vm::bbox3& worldBounds,
+  const IO::Path& path,
+  IO::ParserStatus& parserStatus,
+  Logger& logger)
+{
+  const auto cachePath = IO::mapCachePath(path);
+  if (IO::Disk::fileExists(cachePath))
+  {
+    try
+    {
+      auto cacheFile = IO::Disk::openFile(cachePath);
+      auto cacheReader = cacheFile->reader().buffer();
+
+      // the messages are only logged if the cache can be used, otherwise they would be
+      // logged again when the map file is parsed
+      auto cacheStatus = IO::CollectingParserStatus{parserStatus};
+      auto worldReader = IO::WorldReader{source, format, entityPropertyConfig};
+      if (
+        auto worldNode =
+          worldReader.readFromCache(cacheReader.stringView(), worldBounds, cacheStatus))
+      {
+        IO::CollectingParserStatus::logMessages(parserStatus, cacheStatus.messages());
+        logger.info() << "Loaded map from cache " << cachePath.asString();
+        return worldNode;
+      }
+    }
+    catch (const Exception& e)
+    {
+      logger.warn() << "Could not read map cache " << cachePath.asString() << ": "
+                    << e.what();
+    }
+  }
+
+  // use a new reader so that none of the nodes read from a broken cache are kept
+  auto worldReader = IO::WorldReader{source, format, entityPropertyConfig};
+  auto cacheStream = std::ostringstream{};
+  auto worldNode = worldReader.read(worldBounds, cacheStream, parserStatus);
+
+  try
+  {
+    IO::Disk::createFileAtomically(cachePath, cacheStream.str());
+  }
+  catch (const Exception& e)
+  {
+    logger.warn() << "Could not write map cache " << cachePath.asString() << ": "
+                  << e.what();
+  }
+
+  return worldNode;
+}
+
 std::unique_ptr<WorldNode> GameImpl::doLoadMap(
   const MapFormat format,
   const vm::bbox3& worldBounds,
@@ -231,6 +301,18 @@ std::unique_ptr<WorldNode> GameImpl::doLoadMap(
   }
   else
   {
+    if (pref(Preferences::UseMapCache))
+    {
+      return readWorldUsingCache(
+        fileReader.stringView(),
+        format,
+        entityPropertyConfig(),
+        worldBounds,
+        IO::Disk::fixPath(path),
+        parserStatus,
+        logger);
+    }
+
     auto worldReader =
       IO::WorldReader{fileReader.stringView(), format, entityPropertyConfig()};
     return worldReader.read(worldBounds, parserStatus);
@@ -238,20 +320,25 @@ std::unique_ptr<WorldNode> GameImpl::doLoadMap(
 }
 
 void GameImpl::doWriteMap(
-  WorldNode& world, const IO::Path& path, const bool exporting) const
+  WorldNode& world, std::ostream& stream, const bool exporting) const
 {
   const auto mapFormatName = formatName(world.mapFormat());
+  IO::writeGameComment(stream, gameName(), mapFormatName);
 
+  auto writer = IO::NodeWriter{world, stream};
+  writer.setExporting(exporting);
+  writer.writeMap();
+}
+
+void GameImpl::doWriteMap(
+  WorldNode& world, const IO::Path& path, const bool exporting) const
+{
   auto file = openPathAsOutputStream(path);
   if (!file)
   {
     throw FileSystemException{"Cannot open file: " + path.asString()};
   }
-  IO::writeGameComment(file, gameName(), mapFormatName);
-
-  auto writer = IO::NodeWriter{world, file};
-  writer.setExporting(exporting);
-  writer.writeMap();
+  doWriteMap(world, file, exporting);
 }
 
 void GameImpl::doWriteMap(WorldNode& world, const IO::Path& path) const
@@ -259,6 +346,11 @@ void GameImpl::doWriteMap(WorldNode& world, const IO::Path& path) const
   doWriteMap(world, path, false);
 }
 
+void GameImpl::doWriteMap(WorldNode& world, std::ostream& stream) const
+{
+  doWriteMap(world, stream, false);
+}
+
 void GameImpl::doExportMap(WorldNode& world, const IO::ExportOptions& options) const
 {
   std::visit(
@@ -446,37 +538,169 @@ bool GameImpl::doIsEntityDefinitionFile(const IO::Path& path) const
   });
 }
 
-std::vector<Assets::EntityDefinition*> GameImpl::doLoadEntityDefinitions(
-  IO::ParserStatus& status, const IO::Path& path) const
+/**
+ * Parses the class infos from the given entity definition file. The absolute paths of the
+ * files included by the definition file are added to the given vectors, depending on
+ * whether they exist.
+ */
+static std::vector<IO::EntityDefinitionClassInfo> parseEntityDefinitionClassInfos(
+  IO::ParserStatus& status,
+  const std::string_view source,
+  const IO::Path& path,
+  const Color& defaultColor,
+  std::vector<IO::Path>& includedFiles,
+  std::vector<IO::Path>& missingIncludedFiles)
 {
   const auto extension = path.extension();
-  const auto& defaultColor = m_config.entityConfig.defaultColor;
-
   if (kdl::ci::str_is_equal("fgd", extension))
   {
-    auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
-    auto reader = file->reader().buffer();
-    auto parser = IO::FgdParser{reader.stringView(), defaultColor, file->path()};
-    return parser.parseDefinitions(status);
+    auto parser = IO::FgdParser{source, defaultColor, path};
+    auto classInfos = parser.parseClassInfos(status);
+    includedFiles = parser.includedFiles();
+    missingIncludedFiles = parser.missingIncludedFiles();
+    return classInfos;
   }
   if (kdl::ci::str_is_equal("def", extension))
   {
-    auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
-    auto reader = file->reader().buffer();
-    auto parser = IO::DefParser{reader.stringView(), defaultColor};
-    return parser.parseDefinitions(status);
+    auto parser = IO::DefParser{source, defaultColor};
+    return parser.parseClassInfos(status);
   }
   if (kdl::ci::str_is_equal("ent", extension))
   {
-    auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
-    auto reader = file->reader().buffer();
-    auto parser = IO::EntParser{reader.stringView(), defaultColor};
-    return parser.parseDefinitions(status);
+    auto parser = IO::EntParser{source, defaultColor};
+    return parser.parseClassInfos(status);
   }
 
   throw GameException{"Unknown entity definition format: '" + path.asString() + "'"};
 }
 
+/**
+ * Checks whether the keys of the given cache match the current contents of the files they
+ * refer to, and whether the files that were missing when the cache was written are still
+ * missing. The first key refers to the entity definition file itself.
+ */
+static bool isEntityDefinitionCacheUpToDate(
+  const IO::EntityDefinitionCache& cache,
+  const IO::Path& path,
+  const std::string_view source)
+{
+  const auto& keys = cache.keys;
+  if (keys.empty() || keys.front() != IO::makeEntityDefinitionCacheKey(path, source))
+  {
+    return false;
+  }
+
+  if (std::any_of(
+        cache.missingFiles.begin(),
+        cache.missingFiles.end(),
+        [](const auto& missingFile) { return IO::Disk::fileExists(missingFile); }))
+  {
+    return false;
+  }
+
+  return std::all_of(std::next(keys.begin()), keys.end(), [](const auto& key) {
+    if (!IO::Disk::fileExists(key.path))
+    {
+      return false;
+    }
+    auto file = IO::Disk::openFile(key.path);
+    auto reader = file->reader().buffer();
+    return key == IO::makeEntityDefinitionCacheKey(key.path, reader.stringView());
+  });
+}
+
+/**
+ * Reads the class infos from the entity definition cache if none of the files they were
+ * parsed from have changed. Otherwise, parses the entity definition file and writes a new
+ * cache.
+ */
+static std::vector<IO::EntityDefinitionClassInfo> readClassInfosUsingCache(
+  IO::ParserStatus& status, const IO::Path& path, const Color& defaultColor)
+{
+  auto file = IO::Disk::openFile(path);
+  auto reader = file->reader().buffer();
+  const auto source = reader.stringView();
+
+  const auto cachePath = IO::entityDefinitionCachePath(path);
+  if (IO::Disk::fileExists(cachePath))
+  {
+    try
+    {
+      auto cacheFile = IO::Disk::openFile(cachePath);
+      auto cacheReader = cacheFile->reader().buffer();
+      if (auto cache = IO::readEntityDefinitionCache(cacheReader.stringView()))
+      {
+        if (isEntityDefinitionCacheUpToDate(*cache, path, source))
+        {
+          status.debug("Loaded entity definitions from cache " + cachePath.asString());
+          IO::CollectingParserStatus::logMessages(status, cache->messages);
+          return std::move(cache->classInfos);
+        }
+      }
+    }
+    catch (const Exception& e)
+    {
+      status.debug(kdl::str_to_string(
+        "Could not read entity definition cache ", cachePath, ": ", e.what()));
+    }
+  }
+
+  // the messages are stored in the cache unless parsing fails
+  auto collectingStatus = IO::CollectingParserStatus{status};
+  auto includedFiles = std::vector<IO::Path>{};
+  auto cache = IO::EntityDefinitionCache{};
+  try
+  {
+    cache.classInfos = parseEntityDefinitionClassInfos(
+      collectingStatus, source, path, defaultColor, includedFiles, cache.missingFiles);
+  }
+  catch (...)
+  {
+    IO::CollectingParserStatus::logMessages(status, collectingStatus.messages());
+    throw;
+  }
+  cache.messages = std::move(collectingStatus).messages();
+  IO::CollectingParserStatus::logMessages(status, cache.messages);
+
+  try
+  {
+    cache.keys.push_back(IO::makeEntityDefinitionCacheKey(path, source));
+    for (const auto& includedFile : includedFiles)
+    {
+      auto includedFileHandle = IO::Disk::openFile(includedFile);
+      auto includedFileReader = includedFileHandle->reader().buffer();
+      cache.keys.push_back(
+        IO::makeEntityDefinitionCacheKey(includedFile, includedFileReader.stringView()));
+    }
+
+    auto cacheStream = std::ostringstream{};
+    if (IO::writeEntityDefinitionCache(cacheStream, cache))
+    {
+      IO::Disk::createFileAtomically(cachePath, cacheStream.str());
+    }
+    else
+    {
+      status.debug("Could not write entity definition cache " + cachePath.asString());
+    }
+  }
+  catch (const Exception& e)
+  {
+    status.debug(kdl::str_to_string(
+      "Could not write entity definition cache ", cachePath, ": ", e.what()));
+  }
+
+  return std::move(cache.classInfos);
+}
+
+std::vector<Assets::EntityDefinition*> GameImpl::doLoadEntityDefinitions(
+  IO::ParserStatus& status, const IO::Path& path) const
+{
+  const auto& defaultColor = m_config.entityConfig.defaultColor;
+  const auto classInfos =
+    readClassInfosUsingCache(status, IO::Disk::fixPath(path), defaultColor);
+  return IO::createEntityDefinitions(status, classInfos, defaultColor);
+}
+
 std::vector<Assets::EntityDefinitionFileSpec> GameImpl::doAllEntityDefinitionFiles() const
 {
   return kdl::vec_transform(m_config.entityConfig.defFilePaths, [](const auto& path) {
@@ -81,8 +81,10 @@ private:
     const vm::bbox3& worldBounds,
     const IO::Path& path,
     Logger& logger) const override;
+  void doWriteMap(WorldNode& world, std::ostream& stream, bool exporting) const;
   void doWriteMap(WorldNode& world, const IO::Path& path, bool exporting) const;
   void doWriteMap(WorldNode& world, const IO::Path& path) const override;
+  void doWriteMap(WorldNode& world, std::ostream& stream) const override;
   void doExportMap(WorldNode& world, const IO::ExportOptions& options) const override;
 
   std::vector<Node*> doParseNodes(
@@ -44,7 +44,9 @@
 
 #include <vecmath/ray.h>
 
+#include <atomic>
 #include <functional>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -79,126 +81,150 @@ static std::vector<const Node*> collectNodesToCloneAndTransform(const Node& node
 }
 
 /**
- * Given a node, clones its children recursively and applies the given transform.
+ * Given a node, clones its children recursively once for each of the given
+ * transformations and applies the transformation to the clones.
  *
- * Returns a vector of the cloned direct children of `node`.
+ * Returns one vector of the cloned direct children of `node` per transformation.
  */
-static kdl::result<std::vector<std::unique_ptr<Node>>, UpdateLinkedGroupsError>
-cloneAndTransformChildren(
-  const Node& node, const vm::bbox3& worldBounds, const vm::mat4x4& transformation)
-{
-  auto nodesToClone = collectNodesToCloneAndTransform(node);
-
-  using TransformResult = kdl::result<std::pair<const Node*, NodeContents>, BrushError>;
+static kdl::
+  result<std::vector<std::vector<std::unique_ptr<Node>>>, UpdateLinkedGroupsError>
+  cloneAndTransformChildren(
+    const Node& node,
+    const vm::bbox3& worldBounds,
+    const std::vector<vm::mat4x4>& transformations)
+{
+  const auto nodesToClone = collectNodesToCloneAndTransform(node);
+  const auto nodeCount = nodesToClone.size();
+
+  auto nodeIndices = std::unordered_map<const Node*, size_t>{};
+  for (size_t i = 0; i < nodeCount; ++i)
+  {
+    nodeIndices.emplace(nodesToClone[i], i);
+  }
 
-  // In parallel, produce pairs { node pointer, transformed contents } from the nodes in
-  // `nodesToClone`
-  const auto transformResults =
-    kdl::vec_parallel_transform(nodesToClone, [&](const Node* nodeToTransform) {
-      return nodeToTransform->accept(kdl::overload(
-        [](const WorldNode*) -> TransformResult {
-          ensure(false, "Linked group structure is valid");
-        },
-        [](const LayerNode*) -> TransformResult {
-          ensure(false, "Linked group structure is valid");
-        },
-        [&](const GroupNode* groupNode) -> TransformResult {
-          auto group = groupNode->group();
+  // In parallel, produce the transformed contents of every node in `nodesToClone` for
+  // every transformation. This is done in a single pass over all transformations so that
+  // large link sets of small groups keep all threads busy. The contents of the node with
+  // index n for the transformation with index t are stored at index t * nodeCount + n.
+  auto transformedContents =
+    std::vector<std::optional<NodeContents>>(transformations.size() * nodeCount);
+  auto transformFailed = std::atomic<bool>{false};
+
+  kdl::parallel_for(transformedContents.size(), [&](const size_t index) {
+    const auto& transformation = transformations[index / nodeCount];
+    const auto* nodeToTransform = nodesToClone[index % nodeCount];
+
+    // a target that is not transformed relative to the source only needs a copy
+    const auto isIdentity = transformation == vm::mat4x4::identity();
+
+    nodeToTransform->accept(kdl::overload(
+      [](const WorldNode*) { ensure(false, "Linked group structure is valid"); },
+      [](const LayerNode*) { ensure(false, "Linked group structure is valid"); },
+      [&](const GroupNode* groupNode) {
+        auto group = groupNode->group();
+        if (!isIdentity)
+        {
           group.transform(transformation);
-          return std::make_pair(nodeToTransform, NodeContents{std::move(group)});
-        },
-        [&](const EntityNode* entityNode) -> TransformResult {
-          auto entity = entityNode->entity();
+        }
+        transformedContents[index] = NodeContents{std::move(group)};
+      },
+      [&](const EntityNode* entityNode) {
+        auto entity = entityNode->entity();
+        if (!isIdentity)
+        {
           entity.transform(entityNode->entityPropertyConfig(), transformation);
-          return std::make_pair(nodeToTransform, NodeContents{std::move(entity)});
-        },
-        [&](const BrushNode* brushNode) -> TransformResult {
-          auto brush = brushNode->brush();
-          return brush.transform(worldBounds, transformation, true)
-            .and_then([&]() -> TransformResult {
-              return std::make_pair(nodeToTransform, NodeContents{std::move(brush)});
-            });
-        },
-        [&](const PatchNode* patchNode) -> TransformResult {
-          auto patch = patchNode->patch();
+        }
+        transformedContents[index] = NodeContents{std::move(entity)};
+      },
+      [&](const BrushNode* brushNode) {
+        auto brush = brushNode->brush();
+        if (!isIdentity && brush.transform(worldBounds, transformation, true).is_error())
+        {
+          transformFailed = true;
+          return;
+        }
+        transformedContents[index] = NodeContents{std::move(brush)};
+      },
+      [&](const PatchNode* patchNode) {
+        auto patch = patchNode->patch();
+        if (!isIdentity)
+        {
           patch.transform(transformation);
-          return std::make_pair(nodeToTransform, NodeContents{std::move(patch)});
-        }));
-    });
-
-  bool transformFailed = false;
-  auto origNodeAndTransformedContents = kdl::collect_values(
-    transformResults, kdl::overload([&](const auto&) { transformFailed = true; }));
+        }
+        transformedContents[index] = NodeContents{std::move(patch)};
+      }));
+  });
 
   if (transformFailed)
   {
     return UpdateLinkedGroupsError::TransformFailed;
   }
 
-  // Move into map for easier lookup
-  auto resultsMap = std::unordered_map<const Node*, NodeContents>{};
-  for (auto& [origNode, transformedContents] : origNodeAndTransformedContents)
-  {
-    resultsMap.emplace(origNode, std::move(transformedContents));
-  }
-  origNodeAndTransformedContents.clear();
-
-  // Do a recursive traversal of the input node tree again,
-  // creating a matching tree structure, and move in the contents
-  // we've transformed above.
-
-  bool worldBoundsExceeded = false;
-  std::function<std::unique_ptr<Node>(const Node*)> cloneAndTransformRecursive =
-    [&](const Node* n) -> std::unique_ptr<Node> {
-    // First, clone `n`, and move in the new (transformed) content which was prepared for
-    // it above
-    std::unique_ptr<Node> clone = n->accept(kdl::overload(
-      [](const WorldNode*) -> std::unique_ptr<Node> {
-        ensure(false, "Linked group structure is valid");
-      },
-      [](const LayerNode*) -> std::unique_ptr<Node> {
-        ensure(false, "Linked group structure is valid");
-      },
-      [&](const GroupNode* groupNode) -> std::unique_ptr<Node> {
-        auto& group = std::get<Group>(resultsMap.at(groupNode).get());
-        return std::make_unique<GroupNode>(std::move(group));
-      },
-      [&](const EntityNode* entityNode) -> std::unique_ptr<Node> {
-        auto& entity = std::get<Entity>(resultsMap.at(entityNode).get());
-        return std::make_unique<EntityNode>(std::move(entity));
-      },
-      [&](const BrushNode* brushNode) -> std::unique_ptr<Node> {
-        auto& brush = std::get<Brush>(resultsMap.at(brushNode).get());
-        return std::make_unique<BrushNode>(std::move(brush));
-      },
-      [&](const PatchNode* patchNode) -> std::unique_ptr<Node> {
-        auto& patch = std::get<BezierPatch>(resultsMap.at(patchNode).get());
-        return std::make_unique<PatchNode>(std::move(patch));
-      }));
+  // Also in parallel, do a recursive traversal of the input node tree for every
+  // transformation, creating a matching tree structure, and move in the contents we've
+  // transformed above.
+  auto result = std::vector<std::vector<std::unique_ptr<Node>>>(transformations.size());
+  auto worldBoundsExceeded = std::atomic<bool>{false};
 
-    if (!worldBounds.contains(clone->logicalBounds()))
+  kdl::parallel_for(transformations.size(), [&](const size_t transformationIndex) {
+    const auto contentsAt = [&](const Node* n) -> auto&
     {
-      worldBoundsExceeded = true;
-    }
+      return transformedContents[transformationIndex * nodeCount + nodeIndices.at(n)]
+        ->get();
+    };
+
+    std::function<std::unique_ptr<Node>(const Node*)> cloneAndTransformRecursive =
+      [&](const Node* n) -> std::unique_ptr<Node> {
+      // First, clone `n`, and move in the new (transformed) content which was prepared
+      // for it above
+      std::unique_ptr<Node> clone = n->accept(kdl::overload(
+        [](const WorldNode*) -> std::unique_ptr<Node> {
+          ensure(false, "Linked group structure is valid");
+        },
+        [](const LayerNode*) -> std::unique_ptr<Node> {
+          ensure(false, "Linked group structure is valid");
+        },
+        [&](const GroupNode* groupNode) -> std::unique_ptr<Node> {
+          auto& group = std::get<Group>(contentsAt(groupNode));
+          return std::make_unique<GroupNode>(std::move(group));
+        },
+        [&](const EntityNode* entityNode) -> std::unique_ptr<Node> {
+          auto& entity = std::get<Entity>(contentsAt(entityNode));
+          return std::make_unique<EntityNode>(std::move(entity));
+        },
+        [&](const BrushNode* brushNode) -> std::unique_ptr<Node> {
+          auto& brush = std::get<Brush>(contentsAt(brushNode));
+          return std::make_unique<BrushNode>(std::move(brush));
+        },
+        [&](const PatchNode* patchNode) -> std::unique_ptr<Node> {
+          auto& patch = std::get<BezierPatch>(contentsAt(patchNode));
+          return std::make_unique<PatchNode>(std::move(patch));
+        }));
 
-    // Recursively clone children of `n`
-    for (const Node* child : n->children())
-    {
-      std::unique_ptr<Node> childClone = cloneAndTransformRecursive(child);
+      if (!worldBounds.contains(clone->logicalBounds()))
+      {
+        worldBoundsExceeded = true;
+      }
 
-      // attach it as a child of `clone`
-      clone->addChild(childClone.release());
-    }
+      // Recursively clone children of `n`
+      for (const Node* child : n->children())
+      {
+        std::unique_ptr<Node> childClone = cloneAndTransformRecursive(child);
 
-    return clone;
-  };
+        // attach it as a child of `clone`
+        clone->addChild(childClone.release());
+      }
 
-  // Generate the output vector by applying `cloneAndTransformRecursive` to each child of
-  // `node`.
-  auto result =
-    kdl::vec_transform(node.children(), [&](const Node* child) -> std::unique_ptr<Node> {
-      return cloneAndTransformRecursive(child);
-    });
+      return clone;
+    };
+
+    // Generate the output vector by applying `cloneAndTransformRecursive` to each child
+    // of `node`.
+    result[transformationIndex] =
+      kdl::vec_transform(node.children(), [&](const Node* child) {
+        return cloneAndTransformRecursive(child);
+      });
+  });
 
   if (worldBoundsExceeded)
   {
@@ -331,18 +357,29 @@ kdl::result<UpdateLinkedGroupsResult, UpdateLinkedGroupsError> updateLinkedGroup
   const auto _invertedSourceTransformation = invertedSourceTransformation;
   const auto targetGroupNodesToUpdate =
     kdl::vec_erase(targetGroupNodes, &sourceGroupNode);
-  return kdl::for_each_result(targetGroupNodesToUpdate, [&](auto* targetGroupNode) {
-    const auto transformation =
-      targetGroupNode->group().transformation() * _invertedSourceTransformation;
-    return cloneAndTransformChildren(sourceGroupNode, worldBounds, transformation)
-      .transform([&](std::vector<std::unique_ptr<Node>>&& newChildren) {
+  const auto transformations =
+    kdl::vec_transform(targetGroupNodesToUpdate, [&](const auto* targetGroupNode) {
+      return targetGroupNode->group().transformation() * _invertedSourceTransformation;
+    });
+
+  return cloneAndTransformChildren(sourceGroupNode, worldBounds, transformations)
+    .transform([&](std::vector<std::vector<std::unique_ptr<Node>>>&& newChildrenList) {
+      auto result = UpdateLinkedGroupsResult{};
+      result.reserve(targetGroupNodesToUpdate.size());
+
+      for (size_t i = 0; i < targetGroupNodesToUpdate.size(); ++i)
+      {
+        auto* targetGroupNode = targetGroupNodesToUpdate[i];
+        auto& newChildren = newChildrenList[i];
+
         preserveGroupNames(newChildren, targetGroupNode->children());
         preserveEntityProperties(newChildren, targetGroupNode->children());
 
-        return std::make_pair(
-          static_cast<Node*>(targetGroupNode), std::move(newChildren));
-      });
-  });
+        result.emplace_back(targetGroupNode, std::move(newChildren));
+      }
+
+      return result;
+    });
 }
 
 GroupNode::GroupNode(Group group)
@@ -86,7 +86,7 @@ public: // selection
   virtual std::vector<EntityNodeBase*> allSelectedEntityNodes() const = 0;
   virtual const NodeCollection& selectedNodes() const = 0;
   virtual std::vector<BrushFaceHandle> allSelectedBrushFaces() const = 0;
-  virtual std::vector<BrushFaceHandle> selectedBrushFaces() const = 0;
+  virtual const std::vector<BrushFaceHandle>& selectedBrushFaces() const = 0;
 
   virtual const vm::bbox3& referenceBounds() const = 0;
   virtual const vm::bbox3& lastSelectionBounds() const = 0;
@@ -32,6 +32,7 @@
 #include <kdl/reflection_impl.h>
 
 #include <algorithm>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom
@@ -227,46 +228,23 @@ static const auto doRemoveNodes = [](
                                     auto& patches,
                                     auto cur,
                                     auto end) {
-  auto nodeEnd = std::end(nodes);
-  auto layerEnd = std::end(layers);
-  auto groupEnd = std::end(groups);
-  auto entityEnd = std::end(entities);
-  auto brushEnd = std::end(brushes);
-  auto patchEnd = std::end(patches);
-
-  while (cur != end)
-  {
-    (*cur)->accept(kdl::overload(
-      [](WorldNode*) {},
-      [&](LayerNode* layer) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, layer);
-        layerEnd = std::remove(std::begin(layers), layerEnd, layer);
-      },
-      [&](GroupNode* group) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, group);
-        groupEnd = std::remove(std::begin(groups), groupEnd, group);
-      },
-      [&](EntityNode* entity) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, entity);
-        entityEnd = std::remove(std::begin(entities), entityEnd, entity);
-      },
-      [&](BrushNode* brush) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, brush);
-        brushEnd = std::remove(std::begin(brushes), brushEnd, brush);
-      },
-      [&](PatchNode* patch) {
-        nodeEnd = std::remove(std::begin(nodes), nodeEnd, patch);
-        patchEnd = std::remove(std::begin(patches), patchEnd, patch);
-      }));
-    ++cur;
-  }
-
-  nodes.erase(nodeEnd, std::end(nodes));
-  layers.erase(layerEnd, std::end(layers));
-  groups.erase(groupEnd, std::end(groups));
-  entities.erase(entityEnd, std::end(entities));
-  brushes.erase(brushEnd, std::end(brushes));
-  patches.erase(patchEnd, std::end(patches));
+  // remove all nodes in a single pass over each vector, the collection can be large
+  const auto nodesToRemove = std::unordered_set<const Node*>(cur, end);
+  const auto eraseNodes = [&](auto& v) {
+    v.erase(
+      std::remove_if(
+        std::begin(v),
+        std::end(v),
+        [&](const auto* node) { return nodesToRemove.count(node) > 0u; }),
+      std::end(v));
+  };
+
+  eraseNodes(nodes);
+  eraseNodes(layers);
+  eraseNodes(groups);
+  eraseNodes(entities);
+  eraseNodes(brushes);
+  eraseNodes(patches);
 };
 
 void NodeCollection::removeNodes(const std::vector<Node*>& nodes)
@@ -203,6 +203,7 @@ Preference<bool> EnableMSAA(IO::Path("Renderer/Enable multisampling"), true);
 Preference<bool> TextureLock(IO::Path("Editor/Texture lock"), true);
 Preference<bool> UVLock(IO::Path("Editor/UV lock"), false);
 Preference<bool> ChoosePointOnXY(IO::Path("Editor/Choose Point On XY"), true);
+Preference<bool> UseMapCache(IO::Path("Editor/Use map cache"), false);
 
 Preference<IO::Path>& RendererFontPath()
 {
@@ -412,6 +413,7 @@ const std::vector<PreferenceBase*>& staticPreferences()
     &TextureLock,
     &UVLock,
     &ChoosePointOnXY,
+    &UseMapCache,
     &RendererFontPath(),
     &RendererFontSize,
     &BrowserFontSize,
@@ -132,6 +132,7 @@ extern Preference<bool> EnableMSAA;
 extern Preference<bool> TextureLock;
 extern Preference<bool> UVLock;
 extern Preference<bool> ChoosePointOnXY;
+extern Preference<bool> UseMapCache;
 
 Preference<IO::Path>& RendererFontPath();
 extern Preference<int> RendererFontSize;
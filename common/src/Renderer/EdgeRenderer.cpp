@@ -124,6 +124,16 @@ void EdgeRenderer::RenderBase::renderEdges(RenderContext& renderContext)
   }
 }
 
+std::optional<RenderKey> EdgeRenderer::RenderBase::edgeRenderKey(
+  const void* vertexBuffer) const
+{
+  if (m_params.onTop)
+  {
+    return std::nullopt;
+  }
+  return RenderKey{RenderPass::Transparent, &Shaders::EdgeShader, vertexBuffer};
+}
+
 EdgeRenderer::~EdgeRenderer() = default;
 
 void EdgeRenderer::render(
@@ -209,6 +219,11 @@ void DirectEdgeRenderer::Render::doRenderVertices(RenderContext&)
   m_indexRanges.render(m_vertexArray);
 }
 
+std::optional<RenderKey> DirectEdgeRenderer::Render::doGetRenderKey() const
+{
+  return edgeRenderKey(&m_vertexArray);
+}
+
 DirectEdgeRenderer::DirectEdgeRenderer() {}
 
 DirectEdgeRenderer::DirectEdgeRenderer(VertexArray vertexArray, IndexRangeMap indexRanges)
@@ -264,6 +279,11 @@ void IndexedEdgeRenderer::Render::doRenderVertices(RenderContext&)
   m_indexArray->cleanupIndices();
 }
 
+std::optional<RenderKey> IndexedEdgeRenderer::Render::doGetRenderKey() const
+{
+  return edgeRenderKey(m_vertexArray.get());
+}
+
 // IndexedEdgeRenderer
 
 IndexedEdgeRenderer::IndexedEdgeRenderer() = default;
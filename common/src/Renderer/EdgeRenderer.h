@@ -67,6 +67,12 @@ public:
   protected:
     void renderEdges(RenderContext& renderContext);
 
+    /**
+     * Edges may be blended, so they are rendered in the transparent pass. Edges that are
+     * rendered on top disable the depth test and are never reordered.
+     */
+    std::optional<RenderKey> edgeRenderKey(const void* vertexBuffer) const;
+
   private:
     virtual void doRenderVertices(RenderContext& renderContext) = 0;
   };
@@ -126,6 +132,7 @@ private:
     void doPrepareVertices(VboManager& vboManager) override;
     void doRender(RenderContext& renderContext) override;
     void doRenderVertices(RenderContext& renderContext) override;
+    std::optional<RenderKey> doGetRenderKey() const override;
   };
 
 private:
@@ -160,6 +167,7 @@ private:
     void prepareVerticesAndIndices(VboManager& vboManager) override;
     void doRender(RenderContext& renderContext) override;
     void doRenderVertices(RenderContext& renderContext) override;
+    std::optional<RenderKey> doGetRenderKey() const override;
   };
 
 private:
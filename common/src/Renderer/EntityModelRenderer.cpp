@@ -214,5 +214,11 @@ void EntityModelRenderer::doRender(RenderContext& renderContext)
     renderer->render();
   }
 }
+
+std::optional<RenderKey> EntityModelRenderer::doGetRenderKey() const
+{
+  // every model has its own vertex buffer
+  return RenderKey{RenderPass::Opaque, &Shaders::EntityModelShader, nullptr};
+}
 } // namespace Renderer
 } // namespace TrenchBroom
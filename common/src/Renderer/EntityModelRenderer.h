@@ -112,6 +112,7 @@ public:
 private:
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
+  std::optional<RenderKey> doGetRenderKey() const override;
 };
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -234,5 +234,11 @@ void FaceRenderer::doRender(RenderContext& context)
     m_vertexArray->cleanupVertices();
   }
 }
+
+std::optional<RenderKey> FaceRenderer::doGetRenderKey() const
+{
+  const auto pass = m_alpha < 1.0f ? RenderPass::Transparent : RenderPass::Opaque;
+  return RenderKey{pass, &Shaders::FaceShader, m_vertexArray.get()};
+}
 } // namespace Renderer
 } // namespace TrenchBroom
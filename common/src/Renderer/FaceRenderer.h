@@ -78,6 +78,7 @@ public:
 private:
   void prepareVerticesAndIndices(VboManager& vboManager) override;
   void doRender(RenderContext& context) override;
+  std::optional<RenderKey> doGetRenderKey() const override;
 };
 
 void swap(FaceRenderer& left, FaceRenderer& right);
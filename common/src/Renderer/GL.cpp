@@ -36,6 +36,17 @@ void glCheckError(const std::string& msg)
   }
 }
 
+GLCallCounts& glCallCounts()
+{
+  static auto callCounts = GLCallCounts{};
+  return callCounts;
+}
+
+void glResetCallCounts()
+{
+  glCallCounts() = GLCallCounts{};
+}
+
 std::string glGetErrorMessage(const GLenum code)
 {
   switch (code)
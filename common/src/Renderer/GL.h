@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -35,6 +36,20 @@ std::string glGetErrorMessage(GLenum code);
 GLenum glGetEnum(const std::string& name);
 std::string glGetEnumName(GLenum _enum);
 
+/**
+ * Counts the GL calls that change the bound shader program, buffer or texture. The
+ * counts accumulate until they are reset, which the render views do once per frame.
+ */
+struct GLCallCounts
+{
+  size_t programSwitches = 0;
+  size_t bufferBinds = 0;
+  size_t textureBinds = 0;
+};
+
+GLCallCounts& glCallCounts();
+void glResetCallCounts();
+
 // #define GL_DEBUG 1
 // #define GL_LOG 1
 
@@ -25,6 +25,7 @@
 #include "Renderer/ActiveShader.h"
 #include "Renderer/OrthographicCamera.h"
 #include "Renderer/PrimType.h"
+#include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/ShaderManager.h"
 #include "Renderer/Shaders.h"
@@ -36,43 +37,25 @@ namespace TrenchBroom
 {
 namespace Renderer
 {
-GridRenderer::GridRenderer(const OrthographicCamera& camera, const vm::bbox3& worldBounds)
-  : m_vertexArray(VertexArray::move(vertices(camera, worldBounds)))
+GridRenderer::GridRenderer(const OrthographicCamera& camera)
+  : m_camera(camera)
+  , m_vertexArray(VertexArray::move(vertices()))
 {
 }
 
-std::vector<GridRenderer::Vertex> GridRenderer::vertices(
-  const OrthographicCamera& camera, const vm::bbox3& worldBounds)
+void GridRenderer::render(RenderBatch& renderBatch, const vm::bbox3& worldBounds)
 {
-  const auto& viewport = camera.zoomedViewport();
-  const auto w = float(viewport.width) / 2.0f;
-  const auto h = float(viewport.height) / 2.0f;
+  m_worldBounds = worldBounds;
+  renderBatch.add(this);
+}
 
-  const auto& p = camera.position();
-  switch (vm::find_abs_max_component(camera.direction()))
-  {
-  case vm::axis::x:
-    return {
-      Vertex(vm::vec3f(float(worldBounds.min.x()), p.y() - w, p.z() - h)),
-      Vertex(vm::vec3f(float(worldBounds.min.x()), p.y() - w, p.z() + h)),
-      Vertex(vm::vec3f(float(worldBounds.min.x()), p.y() + w, p.z() + h)),
-      Vertex(vm::vec3f(float(worldBounds.min.x()), p.y() + w, p.z() - h))};
-  case vm::axis::y:
-    return {
-      Vertex(vm::vec3f(p.x() - w, float(worldBounds.max.y()), p.z() - h)),
-      Vertex(vm::vec3f(p.x() - w, float(worldBounds.max.y()), p.z() + h)),
-      Vertex(vm::vec3f(p.x() + w, float(worldBounds.max.y()), p.z() + h)),
-      Vertex(vm::vec3f(p.x() + w, float(worldBounds.max.y()), p.z() - h))};
-  case vm::axis::z:
-    return {
-      Vertex(vm::vec3f(p.x() - w, p.y() - h, float(worldBounds.min.z()))),
-      Vertex(vm::vec3f(p.x() - w, p.y() + h, float(worldBounds.min.z()))),
-      Vertex(vm::vec3f(p.x() + w, p.y() + h, float(worldBounds.min.z()))),
-      Vertex(vm::vec3f(p.x() + w, p.y() - h, float(worldBounds.min.z())))};
-  default:
-    // Should not happen.
-    return {};
-  }
+std::vector<GridRenderer::Vertex> GridRenderer::vertices()
+{
+  return {
+    Vertex(vm::vec2f(-1.0f, -1.0f)),
+    Vertex(vm::vec2f(-1.0f, +1.0f)),
+    Vertex(vm::vec2f(+1.0f, +1.0f)),
+    Vertex(vm::vec2f(+1.0f, -1.0f))};
 }
 
 void GridRenderer::doPrepareVertices(VboManager& vboManager)
@@ -84,15 +67,47 @@ void GridRenderer::doRender(RenderContext& renderContext)
 {
   if (renderContext.showGrid())
   {
-    const auto& camera = renderContext.camera();
+    const auto& viewport = m_camera.zoomedViewport();
+    const auto w = float(viewport.width) / 2.0f;
+    const auto h = float(viewport.height) / 2.0f;
+
+    // the grid is placed at the far side of the world bounds
+    const auto& p = m_camera.position();
+    auto origin = vm::vec3f{};
+    auto axisU = vm::vec3f{};
+    auto axisV = vm::vec3f{};
+    switch (vm::find_abs_max_component(m_camera.direction()))
+    {
+    case vm::axis::x:
+      origin = vm::vec3f(float(m_worldBounds.min.x()), p.y(), p.z());
+      axisU = vm::vec3f(0.0f, w, 0.0f);
+      axisV = vm::vec3f(0.0f, 0.0f, h);
+      break;
+    case vm::axis::y:
+      origin = vm::vec3f(p.x(), float(m_worldBounds.max.y()), p.z());
+      axisU = vm::vec3f(w, 0.0f, 0.0f);
+      axisV = vm::vec3f(0.0f, 0.0f, h);
+      break;
+    case vm::axis::z:
+      origin = vm::vec3f(p.x(), p.y(), float(m_worldBounds.min.z()));
+      axisU = vm::vec3f(w, 0.0f, 0.0f);
+      axisV = vm::vec3f(0.0f, h, 0.0f);
+      break;
+    default:
+      // Should not happen.
+      return;
+    }
 
     ActiveShader shader(renderContext.shaderManager(), Shaders::Grid2DShader);
-    shader.set("Normal", -camera.direction());
+    shader.set("GridOrigin", origin);
+    shader.set("GridAxisU", axisU);
+    shader.set("GridAxisV", axisV);
+    shader.set("Normal", -m_camera.direction());
     shader.set("RenderGrid", renderContext.showGrid());
     shader.set("GridSize", static_cast<float>(renderContext.gridSize()));
     shader.set("GridAlpha", pref(Preferences::GridAlpha));
     shader.set("GridColor", pref(Preferences::GridColor2D));
-    shader.set("CameraZoom", camera.zoom());
+    shader.set("CameraZoom", m_camera.zoom());
 
     m_vertexArray.render(PrimType::Quads);
   }
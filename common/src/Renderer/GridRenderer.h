@@ -24,6 +24,8 @@
 #include "Renderer/Renderable.h"
 #include "Renderer/VertexArray.h"
 
+#include <vecmath/bbox.h>
+
 #include <vector>
 
 namespace TrenchBroom
@@ -31,21 +33,32 @@ namespace TrenchBroom
 namespace Renderer
 {
 class OrthographicCamera;
+class RenderBatch;
 class RenderContext;
 class VboManager;
 
+/**
+ * Renders the grid of a 2D view. The grid lines are computed in the fragment shader, and
+ * the vertex shader stretches a unit quad over the visible area. Thereby, the vertex
+ * data never changes and the cost of rendering the grid does not depend on the grid
+ * size or the zoom level.
+ */
 class GridRenderer : public DirectRenderable
 {
 private:
-  using Vertex = GLVertexTypes::P3::Vertex;
+  using Vertex = GLVertexTypes::P2::Vertex;
+
+  const OrthographicCamera& m_camera;
+  vm::bbox3 m_worldBounds;
   VertexArray m_vertexArray;
 
 public:
-  GridRenderer(const OrthographicCamera& camera, const vm::bbox3& worldBounds);
+  explicit GridRenderer(const OrthographicCamera& camera);
+
+  void render(RenderBatch& renderBatch, const vm::bbox3& worldBounds);
 
 private:
-  static std::vector<Vertex> vertices(
-    const OrthographicCamera& camera, const vm::bbox3& worldBounds);
+  static std::vector<Vertex> vertices();
 
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
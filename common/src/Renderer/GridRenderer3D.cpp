@@ -23,8 +23,9 @@
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Renderer/ActiveShader.h"
+#include "Renderer/Camera.h"
 #include "Renderer/PrimType.h"
-#include "Renderer/OrthographicCamera.h"
+#include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/ShaderManager.h"
 #include "Renderer/Shaders.h"
@@ -36,11 +37,16 @@
 namespace TrenchBroom {
     namespace Renderer {
 
-        GridRenderer3D::GridRenderer3D(const PerspectiveCamera&, const vm::bbox3 &worldBounds) :
-            m_vertexArray(VertexArray::move(vertices(worldBounds)))
+        GridRenderer3D::GridRenderer3D() :
+            m_vertexArray(VertexArray::move(vertices()))
         {
         }
 
+        void GridRenderer3D::render(RenderBatch& renderBatch, const vm::bbox3& worldBounds) {
+            m_worldBounds = worldBounds;
+            renderBatch.add(this);
+        }
+
         void GridRenderer3D::doPrepareVertices(VboManager &vboManager) {
             m_vertexArray.prepare(vboManager);
         }
@@ -55,6 +61,13 @@ namespace TrenchBroom {
                 if(camera.position().z() < 0.0)
                     normal = vm::vec3f(0, 0, -1);
 
+                // stretch the unit quad over the XY plane of the world bounds
+                const auto center = vm::vec2f(m_worldBounds.center().xy());
+                const auto halfSize = vm::vec2f(m_worldBounds.size().xy()) / 2.0f;
+                shader.set("GridOrigin", vm::vec3f(center, 0.f));
+                shader.set("GridAxisU", vm::vec3f(halfSize.x(), 0.f, 0.f));
+                shader.set("GridAxisV", vm::vec3f(0.f, halfSize.y(), 0.f));
+
                 shader.set("Normal", normal);
                 shader.set("RenderGrid", renderContext.showGrid());
                 shader.set("GridSize", static_cast<float>(renderContext.gridSize()));
@@ -66,15 +79,12 @@ namespace TrenchBroom {
             }
         }
 
-        std::vector<GridRenderer3D::Vertex> GridRenderer3D::vertices(const vm::bbox3 &worldBounds) {
-            // Generate verticies along the XY plane
-            const auto lower2d = worldBounds.min.xy();
-            const auto upper2d = worldBounds.max.xy();
+        std::vector<GridRenderer3D::Vertex> GridRenderer3D::vertices() {
             return {
-                    Vertex(vm::vec3f(lower2d, 0.f)),
-                    Vertex(vm::vec3f(lower2d.x(), upper2d.y(), 0.f)),
-                    Vertex(vm::vec3f(upper2d, 0.f)),
-                    Vertex(vm::vec3f(upper2d.x(), lower2d.y(), 0.f)),
+                    Vertex(vm::vec2f(-1.f, -1.f)),
+                    Vertex(vm::vec2f(-1.f, +1.f)),
+                    Vertex(vm::vec2f(+1.f, +1.f)),
+                    Vertex(vm::vec2f(+1.f, -1.f)),
             };
         }
     }
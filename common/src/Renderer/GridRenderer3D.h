@@ -24,22 +24,32 @@
 #include "Renderer/VertexArray.h"
 #include "Renderer/GLVertexType.h"
 
+#include <vecmath/bbox.h>
+
 #include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
-        class PerspectiveCamera;
+        class RenderBatch;
         class RenderContext;
         class VboManager;
 
+        /**
+         * Renders the grid on the XY plane of a 3D view. Like the 2D grid, it is computed in
+         * the fragment shader on a unit quad that the vertex shader stretches over the world
+         * bounds.
+         */
         class GridRenderer3D : public DirectRenderable {
         private:
-            using Vertex = GLVertexTypes::P3::Vertex;
+            using Vertex = GLVertexTypes::P2::Vertex;
+            vm::bbox3 m_worldBounds;
             VertexArray m_vertexArray;
         public:
-            GridRenderer3D(const PerspectiveCamera& camera, const vm::bbox3& worldBounds);
+            GridRenderer3D();
+
+            void render(RenderBatch& renderBatch, const vm::bbox3& worldBounds);
         private:
-            static std::vector<Vertex> vertices(const vm::bbox3& worldBounds);
+            static std::vector<Vertex> vertices();
 
             void doPrepareVertices(VboManager& vboManager) override;
             void doRender(RenderContext& renderContext) override;
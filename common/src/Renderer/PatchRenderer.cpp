@@ -415,5 +415,10 @@ void PatchRenderer::doRender(RenderContext& context)
   }
   */
 }
+
+std::optional<RenderKey> PatchRenderer::doGetRenderKey() const
+{
+  return RenderKey{RenderPass::Opaque, &Shaders::FaceShader, &m_patchMeshRenderer};
+}
 } // namespace Renderer
 } // namespace TrenchBroom
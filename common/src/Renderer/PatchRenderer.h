@@ -125,6 +125,7 @@ private:
 private: // implement IndexedRenderable interface
   void prepareVerticesAndIndices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
+  std::optional<RenderKey> doGetRenderKey() const override;
 };
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -20,9 +20,12 @@
 #include "RenderBatch.h"
 
 #include "Ensure.h"
+#include "Renderer/RenderContext.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/ShaderManager.h"
 #include "Renderer/VboManager.h"
 
+#include <kdl/invoke.h>
 #include <kdl/vector_utils.h>
 
 namespace TrenchBroom
@@ -51,6 +54,11 @@ private:
   {
     m_wrappee->render(renderContext);
   }
+
+  std::optional<RenderKey> doGetRenderKey() const override
+  {
+    return m_wrappee->renderKey();
+  }
 };
 
 RenderBatch::RenderBatch(VboManager& vboManager)
@@ -129,8 +137,21 @@ void RenderBatch::prepareRenderables()
 
 void RenderBatch::renderRenderables(RenderContext& renderContext)
 {
+  sortRenderables(m_batch);
+
+  auto& shaderManager = renderContext.shaderManager();
+  const auto unbindProgramAndBuffers = kdl::invoke_later{[&]() {
+    shaderManager.setKeepProgramBound(false);
+    m_vboManager.setKeepBuffersBound(false);
+  }};
+
   for (auto* renderable : m_batch)
   {
+    // renderables with a render key leave no state behind except for their program and
+    // buffers, so these can stay bound in case the next renderable uses them, too
+    const auto hasRenderKey = renderable->renderKey().has_value();
+    shaderManager.setKeepProgramBound(hasRenderKey);
+    m_vboManager.setKeepBuffersBound(hasRenderKey);
     renderable->render(renderContext);
   }
 }
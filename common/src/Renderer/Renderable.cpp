@@ -19,6 +19,9 @@
 
 #include "Renderable.h"
 
+#include <algorithm>
+#include <functional>
+
 namespace TrenchBroom
 {
 namespace Renderer
@@ -28,9 +31,75 @@ void Renderable::render(RenderContext& renderContext)
   doRender(renderContext);
 }
 
+std::optional<RenderKey> Renderable::renderKey() const
+{
+  return doGetRenderKey();
+}
+
+std::optional<RenderKey> Renderable::doGetRenderKey() const
+{
+  return std::nullopt;
+}
+
 void DirectRenderable::prepareVertices(VboManager& vboManager)
 {
   doPrepareVertices(vboManager);
 }
+
+namespace
+{
+struct SortEntry
+{
+  Renderable* renderable;
+  std::optional<RenderKey> key;
+};
+
+bool compareSortEntries(const SortEntry& lhs, const SortEntry& rhs)
+{
+  const auto& lhsKey = *lhs.key;
+  const auto& rhsKey = *rhs.key;
+  if (lhsKey.pass != rhsKey.pass)
+  {
+    return lhsKey.pass < rhsKey.pass;
+  }
+  if (lhsKey.pass == RenderPass::Transparent)
+  {
+    // keep the submission order, the sort is stable
+    return false;
+  }
+
+  if (lhsKey.shader != rhsKey.shader)
+  {
+    return std::less<const ShaderConfig*>{}(lhsKey.shader, rhsKey.shader);
+  }
+  return std::less<const void*>{}(lhsKey.vertexBuffer, rhsKey.vertexBuffer);
+}
+} // namespace
+
+void sortRenderables(std::vector<Renderable*>& renderables)
+{
+  auto entries = std::vector<SortEntry>{};
+  entries.reserve(renderables.size());
+  for (auto* renderable : renderables)
+  {
+    entries.push_back({renderable, renderable->renderKey()});
+  }
+
+  const auto hasNoKey = [](const auto& entry) { return !entry.key.has_value(); };
+
+  auto first = entries.begin();
+  while (first != entries.end())
+  {
+    first = std::find_if_not(first, entries.end(), hasNoKey);
+    const auto last = std::find_if(first, entries.end(), hasNoKey);
+    std::stable_sort(first, last, compareSortEntries);
+    first = last;
+  }
+
+  std::transform(
+    entries.begin(), entries.end(), renderables.begin(), [](const auto& entry) {
+      return entry.renderable;
+    });
+}
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -21,13 +21,40 @@
 
 #include "Macros.h"
 
+#include <optional>
+#include <vector>
+
 namespace TrenchBroom
 {
 namespace Renderer
 {
 class RenderContext;
+class ShaderConfig;
 class VboManager;
 
+enum class RenderPass
+{
+  /** Depth tested geometry that is not blended and can be rendered in any order. */
+  Opaque,
+  /** Blended geometry that must be rendered in the order in which it was submitted. */
+  Transparent,
+};
+
+/**
+ * Describes the GL state that a renderable sets up, so that renderables which use the
+ * same shader program and vertex buffer can be rendered one after another. While such
+ * renderables are rendered, the program and the buffers are kept bound between them.
+ *
+ * Textures are not part of the key because the renderables that provide a key draw with
+ * many textures, grouped by texture in their index array maps.
+ */
+struct RenderKey
+{
+  RenderPass pass;
+  const ShaderConfig* shader;
+  const void* vertexBuffer;
+};
+
 class Renderable
 {
 public:
@@ -36,8 +63,16 @@ public:
 
   void render(RenderContext& renderContext);
 
+  /**
+   * Returns the render key of this renderable, or nothing if it must be rendered exactly
+   * where it was submitted. A renderable that returns a key must draw using only the
+   * shader program given by the key, and it must restore any other GL state it changes.
+   */
+  std::optional<RenderKey> renderKey() const;
+
 private:
   virtual void doRender(RenderContext& renderContext) = 0;
+  virtual std::optional<RenderKey> doGetRenderKey() const;
 
   defineCopyAndMove(Renderable);
 };
@@ -66,5 +101,15 @@ public:
 
   defineCopyAndMove(IndexedRenderable);
 };
+
+/**
+ * Reorders the given renderables to reduce the number of program and buffer switches.
+ *
+ * Renderables without a render key are not moved, and no renderable is moved past them.
+ * Between two such renderables, the opaque renderables are moved before the transparent
+ * ones and are grouped by shader program and vertex buffer. The transparent renderables
+ * keep their relative order.
+ */
+void sortRenderables(std::vector<Renderable*>& renderables);
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -27,16 +27,16 @@
 #include <fstream>
 #include <sstream>
 #include <string>
-#include <vector>
 
 namespace TrenchBroom
 {
 namespace Renderer
 {
-Shader::Shader(const IO::Path& path, const GLenum type)
-  : m_name(path.lastComponent().asString())
+Shader::Shader(std::string name, const GLenum type, const std::string& source)
+  : m_name(std::move(name))
   , m_type(type)
   , m_shaderId(0)
+  , m_compileStatusChecked(false)
 {
   assert(m_type == GL_VERTEX_SHADER || m_type == GL_FRAGMENT_SHADER);
   glAssert(m_shaderId = glCreateShader(m_type));
@@ -44,42 +44,10 @@ Shader::Shader(const IO::Path& path, const GLenum type)
   if (m_shaderId == 0)
     throw RenderException("Could not create shader " + m_name);
 
-  const std::vector<std::string> source = loadSource(path);
-  const char** linePtrs = new const char*[source.size()];
-  for (size_t i = 0; i < source.size(); i++)
-    linePtrs[i] = source[i].c_str();
-
-  glAssert(
-    glShaderSource(m_shaderId, static_cast<GLsizei>(source.size()), linePtrs, nullptr));
-  delete[] linePtrs;
+  const char* sourcePtr = source.c_str();
+  glAssert(glShaderSource(m_shaderId, 1, &sourcePtr, nullptr));
 
   glAssert(glCompileShader(m_shaderId));
-  GLint compileStatus;
-  glAssert(glGetShaderiv(m_shaderId, GL_COMPILE_STATUS, &compileStatus));
-
-  if (compileStatus == 0)
-  {
-    auto str = std::stringstream();
-    str << "Could not compile shader " << m_name << ": ";
-
-    GLint infoLogLength;
-    glAssert(glGetShaderiv(m_shaderId, GL_INFO_LOG_LENGTH, &infoLogLength));
-    if (infoLogLength > 0)
-    {
-      char* infoLog = new char[static_cast<size_t>(infoLogLength)];
-      glAssert(glGetShaderInfoLog(m_shaderId, infoLogLength, &infoLogLength, infoLog));
-      infoLog[infoLogLength - 1] = 0;
-
-      str << infoLog;
-      delete[] infoLog;
-    }
-    else
-    {
-      str << "Unknown error";
-    }
-
-    throw RenderException(str.str());
-  }
 }
 
 Shader::~Shader()
@@ -93,6 +61,7 @@ Shader::~Shader()
 
 void Shader::attach(const GLuint programId)
 {
+  checkCompileStatus();
   glAssert(glAttachShader(programId, m_shaderId));
 }
 
@@ -101,7 +70,7 @@ void Shader::detach(const GLuint programId)
   glAssert(glDetachShader(programId, m_shaderId));
 }
 
-std::vector<std::string> Shader::loadSource(const IO::Path& path)
+std::string Shader::loadSource(const IO::Path& path)
 {
   std::ifstream stream = openPathAsInputStream(path);
   if (!stream.is_open())
@@ -110,15 +79,52 @@ std::vector<std::string> Shader::loadSource(const IO::Path& path)
   }
 
   std::string line;
-  std::vector<std::string> lines;
+  std::string source;
 
   while (!stream.eof())
   {
     std::getline(stream, line);
-    lines.push_back(line + '\n');
+    source += line + '\n';
+  }
+
+  return source;
+}
+
+void Shader::checkCompileStatus()
+{
+  if (m_compileStatusChecked)
+  {
+    return;
+  }
+
+  GLint compileStatus;
+  glAssert(glGetShaderiv(m_shaderId, GL_COMPILE_STATUS, &compileStatus));
+
+  if (compileStatus == 0)
+  {
+    auto str = std::stringstream();
+    str << "Could not compile shader " << m_name << ": ";
+
+    GLint infoLogLength;
+    glAssert(glGetShaderiv(m_shaderId, GL_INFO_LOG_LENGTH, &infoLogLength));
+    if (infoLogLength > 0)
+    {
+      char* infoLog = new char[static_cast<size_t>(infoLogLength)];
+      glAssert(glGetShaderInfoLog(m_shaderId, infoLogLength, &infoLogLength, infoLog));
+      infoLog[infoLogLength - 1] = 0;
+
+      str << infoLog;
+      delete[] infoLog;
+    }
+    else
+    {
+      str << "Unknown error";
+    }
+
+    throw RenderException(str.str());
   }
 
-  return lines;
+  m_compileStatusChecked = true;
 }
 } // namespace Renderer
 } // namespace TrenchBroom
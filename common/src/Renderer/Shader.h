@@ -22,7 +22,6 @@
 #include "Renderer/GL.h"
 
 #include <string>
-#include <vector>
 
 namespace TrenchBroom
 {
@@ -39,16 +38,24 @@ private:
   std::string m_name;
   GLenum m_type;
   GLuint m_shaderId;
+  bool m_compileStatusChecked;
 
 public:
-  Shader(const IO::Path& path, const GLenum type);
+  /**
+   * Starts compiling the given shader source. The compile status is only checked when the
+   * shader is first attached to a program, so that the driver can compile several shaders
+   * before any of them are waited for.
+   */
+  Shader(std::string name, const GLenum type, const std::string& source);
   ~Shader();
 
   void attach(const GLuint programId);
   void detach(const GLuint programId);
 
+  static std::string loadSource(const IO::Path& path);
+
 private:
-  static std::vector<std::string> loadSource(const IO::Path& path);
+  void checkCompileStatus();
 };
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -20,38 +20,138 @@
 #include "ShaderManager.h"
 
 #include "Ensure.h"
+#include "Exceptions.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
 #include "IO/Path.h"
+#include "IO/Reader.h"
 #include "IO/SystemPaths.h"
 #include "Renderer/Shader.h"
 #include "Renderer/ShaderConfig.h"
 #include "Renderer/ShaderProgram.h"
+#include "Renderer/ShaderProgramCache.h"
+
+#include <kdl/string_utils.h>
 
 #include <cassert>
+#include <sstream>
 #include <string>
 
 namespace TrenchBroom
 {
 namespace Renderer
 {
-ShaderManager::ShaderManager()
+namespace
+{
+IO::Path shaderPath(const std::string& name)
+{
+  return IO::SystemPaths::findResourceFile(IO::Path("shader") + IO::Path(name));
+}
+
+std::string getGLString(const GLenum name)
+{
+  const auto* str = reinterpret_cast<const char*>(glGetString(name));
+  return str != nullptr ? std::string{str} : std::string{};
+}
+
+bool programBinariesSupported()
+{
+  if (!GLEW_ARB_get_program_binary)
+  {
+    return false;
+  }
+
+  GLint formatCount = 0;
+  glAssert(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount));
+  return formatCount > 0;
+}
+} // namespace
+
+ShaderManager::ShaderManager(std::optional<IO::Path> programCachePath)
   : m_currentProgram(nullptr)
+  , m_boundProgramId(0)
+  , m_keepProgramBound(false)
+  , m_programCachePath(std::move(programCachePath))
 {
 }
 
 ShaderManager::~ShaderManager() = default;
 
+void ShaderManager::loadPrograms(const std::vector<const ShaderConfig*>& configs)
+{
+  struct PendingProgram
+  {
+    const ShaderConfig* config;
+    std::optional<ShaderProgramCacheKey> key;
+    std::unique_ptr<ShaderProgram> program;
+  };
+
+  const auto useProgramCache = m_programCachePath && programBinariesSupported();
+  auto pendingPrograms = std::vector<PendingProgram>{};
+
+  for (const auto* config : configs)
+  {
+    if (m_programs.count(config) > 0)
+    {
+      continue;
+    }
+
+    auto key = useProgramCache ? std::optional{programCacheKey(*config)} : std::nullopt;
+    if (key)
+    {
+      if (auto program = loadCachedProgram(*config, *key))
+      {
+        m_programs.emplace(config, std::move(program));
+        continue;
+      }
+    }
+
+    // start compiling the shaders
+    for (const auto& path : config->vertexShaders())
+    {
+      loadShader(path, GL_VERTEX_SHADER);
+    }
+    for (const auto& path : config->fragmentShaders())
+    {
+      loadShader(path, GL_FRAGMENT_SHADER);
+    }
+
+    pendingPrograms.push_back(PendingProgram{config, std::move(key), nullptr});
+  }
+
+  for (auto& pendingProgram : pendingPrograms)
+  {
+    pendingProgram.program = createProgram(*pendingProgram.config);
+    if (pendingProgram.key)
+    {
+      pendingProgram.program->setBinaryRetrievable();
+    }
+    pendingProgram.program->link();
+  }
+
+  for (auto& pendingProgram : pendingPrograms)
+  {
+    pendingProgram.program->checkLinkStatus();
+    if (pendingProgram.key)
+    {
+      writeCachedProgram(
+        *pendingProgram.config, *pendingProgram.key, *pendingProgram.program);
+    }
+    m_programs.emplace(pendingProgram.config, std::move(pendingProgram.program));
+  }
+}
+
 ShaderProgram& ShaderManager::program(const ShaderConfig& config)
 {
   auto it = m_programs.find(&config);
-  if (it != std::end(m_programs))
+  if (it == std::end(m_programs))
   {
-    return *it->second;
+    loadPrograms({&config});
+    it = m_programs.find(&config);
+    assert(it != std::end(m_programs));
   }
 
-  auto result = m_programs.emplace(&config, createProgram(config));
-  assert(result.second);
-
-  return *(result.first->second);
+  return *it->second;
 }
 
 ShaderProgram* ShaderManager::currentProgram()
@@ -59,11 +159,45 @@ ShaderProgram* ShaderManager::currentProgram()
   return m_currentProgram;
 }
 
+void ShaderManager::setKeepProgramBound(const bool keepProgramBound)
+{
+  m_keepProgramBound = keepProgramBound;
+  if (!m_keepProgramBound && m_currentProgram == nullptr)
+  {
+    unbindProgram();
+  }
+}
+
 void ShaderManager::setCurrentProgram(ShaderProgram* program)
 {
   m_currentProgram = program;
 }
 
+bool ShaderManager::keepProgramBound() const
+{
+  return m_keepProgramBound;
+}
+
+void ShaderManager::bindProgram(const GLuint programId)
+{
+  if (!m_keepProgramBound || programId != m_boundProgramId)
+  {
+    glAssert(glUseProgram(programId));
+    ++glCallCounts().programSwitches;
+    m_boundProgramId = programId;
+  }
+}
+
+void ShaderManager::unbindProgram()
+{
+  if (m_boundProgramId != 0)
+  {
+    glAssert(glUseProgram(0));
+    ++glCallCounts().programSwitches;
+    m_boundProgramId = 0;
+  }
+}
+
 std::unique_ptr<ShaderProgram> ShaderManager::createProgram(const ShaderConfig& config)
 {
   auto program = std::make_unique<ShaderProgram>(this, config.name());
@@ -83,6 +217,17 @@ std::unique_ptr<ShaderProgram> ShaderManager::createProgram(const ShaderConfig&
   return program;
 }
 
+const std::string& ShaderManager::loadShaderSource(const std::string& name)
+{
+  auto it = m_shaderSources.find(name);
+  if (it == std::end(m_shaderSources))
+  {
+    it = m_shaderSources.emplace(name, Shader::loadSource(shaderPath(name))).first;
+  }
+
+  return it->second;
+}
+
 Shader& ShaderManager::loadShader(const std::string& name, const GLenum type)
 {
   auto it = m_shaders.find(name);
@@ -91,12 +236,88 @@ Shader& ShaderManager::loadShader(const std::string& name, const GLenum type)
     return *it->second;
   }
 
-  const auto shaderPath =
-    IO::SystemPaths::findResourceFile(IO::Path("shader") + IO::Path(name));
-  auto result = m_shaders.emplace(name, std::make_unique<Shader>(shaderPath, type));
+  auto result =
+    m_shaders.emplace(name, std::make_unique<Shader>(name, type, loadShaderSource(name)));
   assert(result.second);
 
   return *(result.first->second);
 }
+
+ShaderProgramCacheKey ShaderManager::programCacheKey(const ShaderConfig& config)
+{
+  auto sources = std::vector<std::string>{};
+  for (const auto& path : config.vertexShaders())
+  {
+    sources.push_back(loadShaderSource(path));
+  }
+  for (const auto& path : config.fragmentShaders())
+  {
+    sources.push_back(loadShaderSource(path));
+  }
+
+  return ShaderProgramCacheKey{
+    getGLString(GL_VENDOR),
+    getGLString(GL_RENDERER),
+    getGLString(GL_VERSION),
+    makeShaderProgramSourceHash(sources)};
+}
+
+IO::Path ShaderManager::programCacheFilePath(const ShaderConfig& config) const
+{
+  assert(m_programCachePath);
+
+  // some program names contain path separators
+  const auto fileName = kdl::str_replace_every(config.name(), "/", "_");
+  return *m_programCachePath + IO::Path{fileName + ".cache"};
+}
+
+std::unique_ptr<ShaderProgram> ShaderManager::loadCachedProgram(
+  const ShaderConfig& config, const ShaderProgramCacheKey& key)
+{
+  const auto cachePath = programCacheFilePath(config);
+  try
+  {
+    if (IO::Disk::fileExists(cachePath))
+    {
+      const auto file = IO::Disk::openFile(cachePath);
+      auto bufferedReader = file->reader().buffer();
+      if (const auto binary = readShaderProgramCache(bufferedReader.stringView(), key))
+      {
+        auto program = std::make_unique<ShaderProgram>(this, config.name());
+        if (program->loadBinary(*binary))
+        {
+          return program;
+        }
+      }
+    }
+  }
+  catch (const Exception&)
+  {
+    // the program is linked from its shaders instead
+  }
+
+  return nullptr;
+}
+
+void ShaderManager::writeCachedProgram(
+  const ShaderConfig& config,
+  const ShaderProgramCacheKey& key,
+  const ShaderProgram& program) const
+{
+  if (const auto binary = program.binary())
+  {
+    const auto cachePath = programCacheFilePath(config);
+    try
+    {
+      auto stream = std::ostringstream{};
+      writeShaderProgramCache(stream, key, *binary);
+      IO::Disk::createFileAtomically(cachePath, stream.str());
+    }
+    catch (const Exception&)
+    {
+      // the program cache is optional
+    }
+  }
+}
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -19,11 +19,14 @@
 
 #pragma once
 
+#include "IO/Path.h"
 #include "Renderer/GL.h"
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -32,31 +35,70 @@ namespace Renderer
 class Shader;
 class ShaderConfig;
 class ShaderProgram;
+struct ShaderProgramCacheKey;
 
 class ShaderManager
 {
 private:
   friend class ShaderProgram;
+  using ShaderSourceCache = std::map<std::string, std::string>;
   using ShaderCache = std::map<std::string, std::unique_ptr<Shader>>;
   using ShaderProgramCache =
     std::map<const ShaderConfig*, std::unique_ptr<ShaderProgram>>;
 
+  ShaderSourceCache m_shaderSources;
   ShaderCache m_shaders;
   ShaderProgramCache m_programs;
   ShaderProgram* m_currentProgram;
+  GLuint m_boundProgramId;
+  bool m_keepProgramBound;
+  std::optional<IO::Path> m_programCachePath;
 
 public:
-  ShaderManager();
+  /**
+   * Creates a shader manager. If a program cache path is given, the binaries of the
+   * linked programs are stored in that directory and reused if the driver and the shader
+   * sources have not changed.
+   */
+  explicit ShaderManager(std::optional<IO::Path> programCachePath = std::nullopt);
   ~ShaderManager();
 
 public:
+  /**
+   * Creates the programs for the given configs unless they have already been created.
+   * Programs are loaded from the program cache if possible. The shaders of the remaining
+   * programs are all submitted for compilation and the programs are all submitted for
+   * linking before the results are checked.
+   */
+  void loadPrograms(const std::vector<const ShaderConfig*>& configs);
+
   ShaderProgram& program(const ShaderConfig& config);
   ShaderProgram* currentProgram();
 
+  /**
+   * While set, a deactivated program remains bound until another program is activated,
+   * so that activating the same program again does not switch programs. Clearing this
+   * unbinds the program unless it is active.
+   */
+  void setKeepProgramBound(bool keepProgramBound);
+
 private:
   void setCurrentProgram(ShaderProgram* program);
+  bool keepProgramBound() const;
+  void bindProgram(GLuint programId);
+  void unbindProgram();
   std::unique_ptr<ShaderProgram> createProgram(const ShaderConfig& config);
+  const std::string& loadShaderSource(const std::string& name);
   Shader& loadShader(const std::string& name, const GLenum type);
+
+  ShaderProgramCacheKey programCacheKey(const ShaderConfig& config);
+  IO::Path programCacheFilePath(const ShaderConfig& config) const;
+  std::unique_ptr<ShaderProgram> loadCachedProgram(
+    const ShaderConfig& config, const ShaderProgramCacheKey& key);
+  void writeCachedProgram(
+    const ShaderConfig& config,
+    const ShaderProgramCacheKey& key,
+    const ShaderProgram& program) const;
 };
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -22,6 +22,7 @@
 #include "Exceptions.h"
 #include "Renderer/Shader.h"
 #include "Renderer/ShaderManager.h"
+#include "Renderer/ShaderProgramCache.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/mat.h>
@@ -30,6 +31,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom
 {
@@ -39,6 +41,7 @@ ShaderProgram::ShaderProgram(ShaderManager* shaderManager, const std::string& na
   : m_name(name)
   , m_programId(glCreateProgram())
   , m_needsLinking(true)
+  , m_linkStatusChecked(false)
   , m_shaderManager(shaderManager)
 {
   if (m_programId == 0)
@@ -74,10 +77,10 @@ void ShaderProgram::activate()
 {
   assert(m_programId != 0);
 
-  if (m_needsLinking)
-    link();
+  link();
+  checkLinkStatus();
 
-  glAssert(glUseProgram(m_programId));
+  m_shaderManager->bindProgram(m_programId);
   assert(checkActive());
 
   m_shaderManager->setCurrentProgram(this);
@@ -85,7 +88,10 @@ void ShaderProgram::activate()
 
 void ShaderProgram::deactivate()
 {
-  glAssert(glUseProgram(0));
+  if (!m_shaderManager->keepProgramBound())
+  {
+    m_shaderManager->unbindProgram();
+  }
 
   m_shaderManager->setCurrentProgram(nullptr);
 }
@@ -159,9 +165,31 @@ void ShaderProgram::set(const std::string& name, const vm::mat4x4f& value)
     findUniformLocation(name), 1, false, reinterpret_cast<const float*>(value.v)));
 }
 
+void ShaderProgram::setBinaryRetrievable()
+{
+  assert(GLEW_ARB_get_program_binary);
+  glAssert(glProgramParameteri(m_programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+}
+
 void ShaderProgram::link()
 {
+  if (!m_needsLinking)
+  {
+    return;
+  }
+
   glAssert(glLinkProgram(m_programId));
+  m_needsLinking = false;
+  m_linkStatusChecked = false;
+}
+
+void ShaderProgram::checkLinkStatus()
+{
+  assert(!m_needsLinking);
+  if (m_linkStatusChecked)
+  {
+    return;
+  }
 
   GLint linkStatus = 0;
   glAssert(glGetProgramiv(m_programId, GL_LINK_STATUS, &linkStatus));
@@ -190,8 +218,47 @@ void ShaderProgram::link()
     throw RenderException(str.str());
   }
 
+  m_variableCache.clear();
+  m_linkStatusChecked = true;
+}
+
+bool ShaderProgram::loadBinary(const ShaderProgramBinary& binary)
+{
+  glAssert(glProgramBinary(
+    m_programId,
+    static_cast<GLenum>(binary.format),
+    binary.data.data(),
+    static_cast<GLsizei>(binary.data.size())));
+
+  GLint linkStatus = 0;
+  glAssert(glGetProgramiv(m_programId, GL_LINK_STATUS, &linkStatus));
+  if (linkStatus == 0)
+  {
+    return false;
+  }
+
   m_variableCache.clear();
   m_needsLinking = false;
+  m_linkStatusChecked = true;
+  return true;
+}
+
+std::optional<ShaderProgramBinary> ShaderProgram::binary() const
+{
+  GLint length = 0;
+  glAssert(glGetProgramiv(m_programId, GL_PROGRAM_BINARY_LENGTH, &length));
+  if (length <= 0)
+  {
+    return std::nullopt;
+  }
+
+  auto data = std::vector<char>(static_cast<size_t>(length));
+  auto format = GLenum(0);
+  auto actualLength = GLsizei(0);
+  glAssert(glGetProgramBinary(m_programId, length, &actualLength, &format, data.data()));
+  data.resize(static_cast<size_t>(actualLength));
+
+  return ShaderProgramBinary{static_cast<std::uint32_t>(format), std::move(data)};
 }
 
 GLint ShaderProgram::findAttributeLocation(const std::string& name) const
@@ -24,6 +24,7 @@
 #include <vecmath/forward.h>
 
 #include <map>
+#include <optional>
 #include <string>
 
 namespace TrenchBroom
@@ -32,6 +33,7 @@ namespace Renderer
 {
 class ShaderManager;
 class Shader;
+struct ShaderProgramBinary;
 
 class ShaderProgram
 {
@@ -41,6 +43,7 @@ private:
   std::string m_name;
   GLuint m_programId;
   bool m_needsLinking;
+  bool m_linkStatusChecked;
   mutable UniformVariableCache m_variableCache;
   mutable AttributeLocationCache m_attributeCache;
   ShaderManager* m_shaderManager;
@@ -52,6 +55,36 @@ public:
   void attach(Shader& shader);
   void detach(Shader& shader);
 
+  /**
+   * Hints the driver that the binary of this program will be retrieved after linking it.
+   */
+  void setBinaryRetrievable();
+
+  /**
+   * Starts linking the program if shaders were attached or detached since it was last
+   * linked. Link errors are only reported by checkLinkStatus, so that the driver can link
+   * several programs before any of them are waited for.
+   */
+  void link();
+
+  /**
+   * Throws a RenderException if the program could not be linked.
+   */
+  void checkLinkStatus();
+
+  /**
+   * Replaces the program with the given binary, which must have been created by the same
+   * driver. Returns false if the driver rejects the binary, in which case the program
+   * must be linked from its shaders.
+   */
+  bool loadBinary(const ShaderProgramBinary& binary);
+
+  /**
+   * Returns the binary of the linked program, or nothing if the driver does not provide
+   * one.
+   */
+  std::optional<ShaderProgramBinary> binary() const;
+
   void activate();
   void deactivate();
 
@@ -70,7 +103,6 @@ public:
   GLint findAttributeLocation(const std::string& name) const;
 
 private:
-  void link();
   GLint findUniformLocation(const std::string& name) const;
   bool checkActive() const;
 };
@@ -0,0 +1,129 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ShaderProgramCache.h"
+
+#include "IO/BinaryCache.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+
+#include <functional>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+using namespace IO::BinaryCache;
+
+constexpr auto Magic = std::string_view{"TBPCACHE"};
+constexpr auto Version = std::uint32_t(1);
+} // namespace
+
+bool operator==(const ShaderProgramCacheKey& lhs, const ShaderProgramCacheKey& rhs)
+{
+  return lhs.glVendor == rhs.glVendor && lhs.glRenderer == rhs.glRenderer
+         && lhs.glVersion == rhs.glVersion && lhs.sourceHash == rhs.sourceHash;
+}
+
+bool operator!=(const ShaderProgramCacheKey& lhs, const ShaderProgramCacheKey& rhs)
+{
+  return !(lhs == rhs);
+}
+
+std::uint64_t makeShaderProgramSourceHash(const std::vector<std::string>& sources)
+{
+  auto hash = std::uint64_t(sources.size());
+  for (const auto& source : sources)
+  {
+    const auto sourceHash = static_cast<std::uint64_t>(std::hash<std::string>{}(source));
+    hash ^= sourceHash + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+bool operator==(const ShaderProgramBinary& lhs, const ShaderProgramBinary& rhs)
+{
+  return lhs.format == rhs.format && lhs.data == rhs.data;
+}
+
+bool operator!=(const ShaderProgramBinary& lhs, const ShaderProgramBinary& rhs)
+{
+  return !(lhs == rhs);
+}
+
+void writeShaderProgramCache(
+  std::ostream& stream,
+  const ShaderProgramCacheKey& key,
+  const ShaderProgramBinary& binary)
+{
+  auto buffer = beginCache(Magic, Version);
+
+  writeString(buffer, key.glVendor);
+  writeString(buffer, key.glRenderer);
+  writeString(buffer, key.glVersion);
+  write(buffer, key.sourceHash);
+
+  write(buffer, binary.format);
+  writeString(buffer, std::string_view{binary.data.data(), binary.data.size()});
+
+  endCache(buffer, Magic, stream);
+}
+
+std::optional<ShaderProgramBinary> readShaderProgramCache(
+  const std::string_view cache, const ShaderProgramCacheKey& key)
+{
+  try
+  {
+    auto reader = IO::Reader::from(cache.data(), cache.data() + cache.size());
+    if (!readHeader(reader, Magic, Version))
+    {
+      return std::nullopt;
+    }
+
+    auto cacheKey = ShaderProgramCacheKey{};
+    cacheKey.glVendor = readString(reader);
+    cacheKey.glRenderer = readString(reader);
+    cacheKey.glVersion = readString(reader);
+    cacheKey.sourceHash = read<std::uint64_t>(reader);
+    if (cacheKey != key)
+    {
+      return std::nullopt;
+    }
+
+    auto binary = ShaderProgramBinary{};
+    binary.format = read<std::uint32_t>(reader);
+    binary.data.resize(readCount(reader));
+    reader.read(binary.data.data(), binary.data.size());
+
+    if (!readTrailer(reader, Magic))
+    {
+      return std::nullopt;
+    }
+
+    return binary;
+  }
+  catch (const IO::ReaderException&)
+  {
+    return std::nullopt;
+  }
+}
+} // namespace Renderer
+} // namespace TrenchBroom
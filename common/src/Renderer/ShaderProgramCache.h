@@ -0,0 +1,83 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+/**
+ * Identifies the driver and the shader sources that a program binary was created with.
+ * Program binaries are only valid for the driver that created them, so a cached binary is
+ * only used if its key matches the key of the program being loaded.
+ */
+struct ShaderProgramCacheKey
+{
+  std::string glVendor;
+  std::string glRenderer;
+  std::string glVersion;
+  std::uint64_t sourceHash;
+};
+
+bool operator==(const ShaderProgramCacheKey& lhs, const ShaderProgramCacheKey& rhs);
+bool operator!=(const ShaderProgramCacheKey& lhs, const ShaderProgramCacheKey& rhs);
+
+/**
+ * Computes the hash of the given shader sources for use in a cache key.
+ */
+std::uint64_t makeShaderProgramSourceHash(const std::vector<std::string>& sources);
+
+/**
+ * A linked program as returned by glGetProgramBinary.
+ */
+struct ShaderProgramBinary
+{
+  std::uint32_t format;
+  std::vector<char> data;
+};
+
+bool operator==(const ShaderProgramBinary& lhs, const ShaderProgramBinary& rhs);
+bool operator!=(const ShaderProgramBinary& lhs, const ShaderProgramBinary& rhs);
+
+/**
+ * Writes the given program binary and its key to the given stream.
+ */
+void writeShaderProgramCache(
+  std::ostream& stream,
+  const ShaderProgramCacheKey& key,
+  const ShaderProgramBinary& binary);
+
+/**
+ * Reads a program binary from the given cache.
+ *
+ * Returns an empty optional if the cache was written for a different key or by a
+ * different version, or if it is malformed.
+ */
+std::optional<ShaderProgramBinary> readShaderProgramCache(
+  std::string_view cache, const ShaderProgramCacheKey& key);
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -71,6 +71,34 @@ const ShaderConfig TriangleShader =
 const ShaderConfig UVViewShader =
   ShaderConfig("UV View", {"UVView.vertsh"}, {"UVView.fragsh"});
 const ShaderConfig Grid3DShader               = ShaderConfig("3D Grid",                          { "Grid3D.vertsh" },               { "Grid.fragsh", "Grid3D.fragsh" });
+
+std::vector<const ShaderConfig*> allShaders()
+{
+  return {
+    &Grid2DShader,
+    &Grid3DShader,
+    &VaryingPCShader,
+    &VaryingPUniformCShader,
+    &MiniMapEdgeShader,
+    &EntityModelShader,
+    &FaceShader,
+    &PatchShader,
+    &EdgeShader,
+    &ColoredTextShader,
+    &TextBackgroundShader,
+    &TextureBrowserShader,
+    &TextureBrowserBorderShader,
+    &HandleShader,
+    &ColoredHandleShader,
+    &CompassShader,
+    &CompassOutlineShader,
+    &CompassBackgroundShader,
+    &LinkLineShader,
+    &LinkArrowShader,
+    &TriangleShader,
+    &UVViewShader,
+  };
+}
 } // namespace Shaders
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -21,6 +21,8 @@
 
 #include "Renderer/ShaderConfig.h"
 
+#include <vector>
+
 namespace TrenchBroom
 {
 namespace Renderer
@@ -49,6 +51,11 @@ extern const ShaderConfig LinkLineShader;
 extern const ShaderConfig LinkArrowShader;
 extern const ShaderConfig TriangleShader;
 extern const ShaderConfig UVViewShader;
+
+/**
+ * Returns all shaders declared above.
+ */
+std::vector<const ShaderConfig*> allShaders();
 } // namespace Shaders
 } // namespace Renderer
 } // namespace TrenchBroom
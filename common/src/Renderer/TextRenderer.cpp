@@ -31,10 +31,14 @@
 #include "Renderer/TextAnchor.h"
 #include "Renderer/TextureFont.h"
 
+#include <vecmath/bbox.h>
 #include <vecmath/forward.h>
 #include <vecmath/mat_ext.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace TrenchBroom
 {
 namespace Renderer
@@ -46,18 +50,15 @@ const size_t TextRenderer::RectCornerSegments = 3;
 const float TextRenderer::RectCornerRadius = 3.0f;
 
 TextRenderer::Entry::Entry(
-  std::vector<vm::vec2f>& i_vertices,
-  const vm::vec2f& i_size,
+  std::shared_ptr<const GlyphRun> i_glyphRun,
   const vm::vec3f& i_offset,
   const Color& i_textColor,
   const Color& i_backgroundColor)
-  : size(i_size)
+  : glyphRun(std::move(i_glyphRun))
   , offset(i_offset)
   , textColor(i_textColor)
   , backgroundColor(i_backgroundColor)
 {
-  using std::swap;
-  swap(vertices, i_vertices);
 }
 
 TextRenderer::EntryCollection::EntryCollection()
@@ -66,6 +67,45 @@ TextRenderer::EntryCollection::EntryCollection()
 {
 }
 
+const float TextRenderer::LabelGrid::CellSize = 64.0f;
+
+bool TextRenderer::LabelGrid::insert(const vm::bbox2f& bounds)
+{
+  const auto minX = static_cast<std::int32_t>(std::floor(bounds.min.x() / CellSize));
+  const auto minY = static_cast<std::int32_t>(std::floor(bounds.min.y() / CellSize));
+  const auto maxX = static_cast<std::int32_t>(std::floor(bounds.max.x() / CellSize));
+  const auto maxY = static_cast<std::int32_t>(std::floor(bounds.max.y() / CellSize));
+
+  const auto cellKey = [](const std::int32_t x, const std::int32_t y) {
+    return (std::uint64_t(std::uint32_t(x)) << 32) | std::uint64_t(std::uint32_t(y));
+  };
+
+  for (auto y = minY; y <= maxY; ++y)
+  {
+    for (auto x = minX; x <= maxX; ++x)
+    {
+      const auto it = m_cells.find(cellKey(x, y));
+      if (
+        it != m_cells.end()
+        && std::any_of(it->second.begin(), it->second.end(), [&](const auto& other) {
+             return other.intersects(bounds);
+           }))
+      {
+        return false;
+      }
+    }
+  }
+
+  for (auto y = minY; y <= maxY; ++y)
+  {
+    for (auto x = minX; x <= maxX; ++x)
+    {
+      m_cells[cellKey(x, y)].push_back(bounds);
+    }
+  }
+  return true;
+}
+
 TextRenderer::TextRenderer(
   const FontDescriptor& fontDescriptor,
   const float maxViewDistance,
@@ -112,43 +152,39 @@ void TextRenderer::renderString(
   if (distance <= 0.0f)
     return;
 
-  if (!isVisible(renderContext, string, position, distance, onTop))
+  if (!isVisible(renderContext, distance, onTop))
     return;
 
   FontManager& fontManager = renderContext.fontManager();
   TextureFont& font = fontManager.font(m_fontDescriptor);
 
-  std::vector<vm::vec2f> vertices = font.quads(string, true);
-  const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
-  const vm::vec2f size = font.measure(string);
+  // the glyph run is cached by the font, so the string is only laid out once
+  auto glyphRun = font.glyphRun(string);
+  const vm::vec2f& size = glyphRun->size;
   const vm::vec3f offset = position.offset(camera, size);
 
-  if (onTop)
-    addEntry(
-      m_entriesOnTop,
-      Entry(
-        vertices,
-        size,
-        offset,
-        Color(textColor, alphaFactor * textColor.a()),
-        Color(backgroundColor, alphaFactor * backgroundColor.a())));
-  else
-    addEntry(
-      m_entries,
-      Entry(
-        vertices,
-        size,
-        offset,
-        Color(textColor, alphaFactor * textColor.a()),
-        Color(backgroundColor, alphaFactor * backgroundColor.a())));
+  if (!isVisible(renderContext, size, offset))
+    return;
+
+  // in 2D views, labels that would cover each other are dropped rather than drawn as an
+  // unreadable clutter, the labels that are added first take precedence
+  if (
+    !onTop && renderContext.render2D()
+    && !m_labelGrid.insert(vm::bbox2f(offset.xy(), offset.xy() + size)))
+    return;
+
+  const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
+  addEntry(
+    onTop ? m_entriesOnTop : m_entries,
+    Entry(
+      std::move(glyphRun),
+      offset,
+      Color(textColor, alphaFactor * textColor.a()),
+      Color(backgroundColor, alphaFactor * backgroundColor.a())));
 }
 
 bool TextRenderer::isVisible(
-  RenderContext& renderContext,
-  const AttrString& string,
-  const TextAnchor& position,
-  const float distance,
-  const bool onTop) const
+  RenderContext& renderContext, const float distance, const bool onTop) const
 {
   if (!onTop)
   {
@@ -157,15 +193,19 @@ bool TextRenderer::isVisible(
     if (renderContext.render2D() && renderContext.camera().zoom() < m_minZoomFactor)
       return false;
   }
+  return true;
+}
 
-  const Camera& camera = renderContext.camera();
-  const Camera::Viewport& viewport = camera.viewport();
+bool TextRenderer::isVisible(
+  RenderContext& renderContext, const vm::vec2f& size, const vm::vec3f& offset) const
+{
+  const Camera::Viewport& viewport = renderContext.camera().viewport();
 
-  const vm::vec2f size = stringSize(renderContext, string);
-  const vm::vec2f offset = vm::vec2f(position.offset(camera, size)) - m_inset;
-  const vm::vec2f actualSize = size + 2.0f * m_inset;
+  const vm::vec2f actualOffset = offset.xy() - m_inset;
+  const vm::vec2f actualSize = round(size) + 2.0f * m_inset;
 
-  return viewport.contains(offset.x(), offset.y(), actualSize.x(), actualSize.y());
+  return viewport.contains(
+    actualOffset.x(), actualOffset.y(), actualSize.x(), actualSize.y());
 }
 
 float TextRenderer::computeAlphaFactor(
@@ -191,56 +231,46 @@ float TextRenderer::computeAlphaFactor(
   }
 }
 
-void TextRenderer::addEntry(EntryCollection& collection, const Entry& entry)
+void TextRenderer::addEntry(EntryCollection& collection, Entry entry)
 {
-  collection.entries.push_back(entry);
-  collection.textVertexCount += entry.vertices.size();
+  collection.textVertexCount += entry.glyphRun->vertices.size() / 2;
   collection.rectVertexCount += roundedRect2DVertexCount(RectCornerSegments);
-}
-
-vm::vec2f TextRenderer::stringSize(
-  RenderContext& renderContext, const AttrString& string) const
-{
-  FontManager& fontManager = renderContext.fontManager();
-  TextureFont& font = fontManager.font(m_fontDescriptor);
-  return round(font.measure(string));
+  collection.entries.push_back(std::move(entry));
 }
 
 void TextRenderer::doPrepareVertices(VboManager& vboManager)
 {
-  prepare(m_entries, false, vboManager);
-  prepare(m_entriesOnTop, true, vboManager);
-}
-
-void TextRenderer::prepare(
-  EntryCollection& collection, const bool onTop, VboManager& vboManager)
-{
+  // all labels share one vertex array per vertex type, the labels that are rendered on
+  // top follow the others
   std::vector<TextVertex> textVertices;
-  textVertices.reserve(collection.textVertexCount);
+  textVertices.reserve(m_entries.textVertexCount + m_entriesOnTop.textVertexCount);
 
   std::vector<RectVertex> rectVertices;
-  rectVertices.reserve(collection.rectVertexCount);
+  rectVertices.reserve(m_entries.rectVertexCount + m_entriesOnTop.rectVertexCount);
 
-  for (const Entry& entry : collection.entries)
+  for (const Entry& entry : m_entries.entries)
+  {
+    addEntry(entry, textVertices, rectVertices);
+  }
+  for (const Entry& entry : m_entriesOnTop.entries)
   {
-    addEntry(entry, onTop, textVertices, rectVertices);
+    addEntry(entry, textVertices, rectVertices);
   }
 
-  collection.textArray = VertexArray::move(std::move(textVertices));
-  collection.rectArray = VertexArray::move(std::move(rectVertices));
+  m_textArray = VertexArray::move(std::move(textVertices));
+  m_rectArray = VertexArray::move(std::move(rectVertices));
 
-  collection.textArray.prepare(vboManager);
-  collection.rectArray.prepare(vboManager);
+  m_textArray.prepare(vboManager);
+  m_rectArray.prepare(vboManager);
 }
 
 void TextRenderer::addEntry(
   const Entry& entry,
-  const bool /* onTop */,
   std::vector<TextVertex>& textVertices,
   std::vector<RectVertex>& rectVertices)
 {
-  const std::vector<vm::vec2f>& stringVertices = entry.vertices;
-  const vm::vec2f& stringSize = entry.size;
+  const std::vector<vm::vec2f>& stringVertices = entry.glyphRun->vertices;
+  const vm::vec2f& stringSize = entry.glyphRun->size;
 
   const vm::vec3f& offset = entry.offset;
 
@@ -278,15 +308,28 @@ void TextRenderer::doRender(RenderContext& renderContext)
   const vm::mat4x4f view = vm::view_matrix(vm::vec3f::neg_z(), vm::vec3f::pos_y());
   ReplaceTransformation ortho(renderContext.transformation(), projection, view);
 
-  render(m_entries, renderContext);
+  render(m_entries, 0, 0, renderContext);
 
   glAssert(glDisable(GL_DEPTH_TEST));
-  render(m_entriesOnTop, renderContext);
+  render(
+    m_entriesOnTop,
+    m_entries.textVertexCount,
+    m_entries.rectVertexCount,
+    renderContext);
   glAssert(glEnable(GL_DEPTH_TEST));
 }
 
-void TextRenderer::render(EntryCollection& collection, RenderContext& renderContext)
+void TextRenderer::render(
+  const EntryCollection& collection,
+  const size_t firstTextVertex,
+  const size_t firstRectVertex,
+  RenderContext& renderContext)
 {
+  if (collection.entries.empty())
+  {
+    return;
+  }
+
   FontManager& fontManager = renderContext.fontManager();
   TextureFont& font = fontManager.font(m_fontDescriptor);
 
@@ -294,14 +337,20 @@ void TextRenderer::render(EntryCollection& collection, RenderContext& renderCont
 
   ActiveShader backgroundShader(
     renderContext.shaderManager(), Shaders::TextBackgroundShader);
-  collection.rectArray.render(PrimType::Triangles);
+  m_rectArray.render(
+    PrimType::Triangles,
+    static_cast<GLint>(firstRectVertex),
+    static_cast<GLsizei>(collection.rectVertexCount));
 
   glAssert(glEnable(GL_TEXTURE_2D));
 
   ActiveShader textShader(renderContext.shaderManager(), Shaders::ColoredTextShader);
   textShader.set("Texture", 0);
   font.activate();
-  collection.textArray.render(PrimType::Quads);
+  m_textArray.render(
+    PrimType::Quads,
+    static_cast<GLint>(firstTextVertex),
+    static_cast<GLsizei>(collection.textVertexCount));
   font.deactivate();
 }
 } // namespace Renderer
@@ -25,9 +25,13 @@
 #include "Renderer/Renderable.h"
 #include "Renderer/VertexArray.h"
 
+#include <vecmath/bbox.h>
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom
@@ -35,6 +39,7 @@ namespace TrenchBroom
 namespace Renderer
 {
 class AttrString;
+struct GlyphRun;
 class RenderContext;
 class TextAnchor;
 
@@ -49,15 +54,13 @@ private:
 
   struct Entry
   {
-    std::vector<vm::vec2f> vertices;
-    vm::vec2f size;
+    std::shared_ptr<const GlyphRun> glyphRun;
     vm::vec3f offset;
     Color textColor;
     Color backgroundColor;
 
     Entry(
-      std::vector<vm::vec2f>& i_vertices,
-      const vm::vec2f& i_size,
+      std::shared_ptr<const GlyphRun> i_glyphRun,
       const vm::vec3f& i_offset,
       const Color& i_textColor,
       const Color& i_backgroundColor);
@@ -71,12 +74,29 @@ private:
     size_t textVertexCount;
     size_t rectVertexCount;
 
-    VertexArray textArray;
-    VertexArray rectArray;
-
     EntryCollection();
   };
 
+  /**
+   * Records the screen space bounds of the labels that were accepted so far, bucketed
+   * into a coarse grid so that a new label is only tested against its neighbours.
+   */
+  class LabelGrid
+  {
+  private:
+    static const float CellSize;
+
+    std::unordered_map<std::uint64_t, std::vector<vm::bbox2f>> m_cells;
+
+  public:
+    /**
+     * Adds the given bounds unless they overlap any bounds that were added before.
+     *
+     * @return true if the bounds were added and false otherwise
+     */
+    bool insert(const vm::bbox2f& bounds);
+  };
+
   using TextVertex = GLVertexTypes::P3T2C4::Vertex;
   using RectVertex = GLVertexTypes::P3C4::Vertex;
 
@@ -87,6 +107,10 @@ private:
 
   EntryCollection m_entries;
   EntryCollection m_entriesOnTop;
+  LabelGrid m_labelGrid;
+
+  VertexArray m_textArray;
+  VertexArray m_rectArray;
 
 public:
   explicit TextRenderer(
@@ -117,32 +141,27 @@ private:
     const TextAnchor& position,
     bool onTop);
 
+  bool isVisible(RenderContext& renderContext, float distance, bool onTop) const;
   bool isVisible(
-    RenderContext& renderContext,
-    const AttrString& string,
-    const TextAnchor& position,
-    float distance,
-    bool onTop) const;
+    RenderContext& renderContext, const vm::vec2f& size, const vm::vec3f& offset) const;
   float computeAlphaFactor(
     const RenderContext& renderContext, float distance, bool onTop) const;
-  void addEntry(EntryCollection& collection, const Entry& entry);
-
-  vm::vec2f stringSize(RenderContext& renderContext, const AttrString& string) const;
+  void addEntry(EntryCollection& collection, Entry entry);
 
 private:
   void doPrepareVertices(VboManager& vboManager) override;
-  void prepare(EntryCollection& collection, bool onTop, VboManager& vboManager);
 
   void addEntry(
     const Entry& entry,
-    bool onTop,
     std::vector<TextVertex>& textVertices,
     std::vector<RectVertex>& rectVertices);
 
   void doRender(RenderContext& renderContext) override;
-  void render(EntryCollection& collection, RenderContext& renderContext);
-
-  void clear();
+  void render(
+    const EntryCollection& collection,
+    size_t firstTextVertex,
+    size_t firstRectVertex,
+    RenderContext& renderContext);
 };
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -23,8 +23,6 @@
 #include "Renderer/FontGlyph.h"
 #include "Renderer/FontTexture.h"
 
-#include <kdl/vector_utils.h>
-
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
@@ -34,6 +32,8 @@ namespace TrenchBroom
 {
 namespace Renderer
 {
+const size_t TextureFont::MaxCachedGlyphRuns = 8192;
+
 TextureFont::TextureFont(
   std::unique_ptr<FontTexture> texture,
   const std::vector<FontGlyph>& glyphs,
@@ -45,6 +45,7 @@ TextureFont::TextureFont(
   , m_lineHeight(lineHeight)
   , m_firstChar(firstChar)
   , m_charCount(charCount)
+  , m_useCount(0)
 {
 }
 
@@ -139,7 +140,7 @@ public:
     m_y -= m_sizes.back().y();
   }
 
-  const std::vector<vm::vec2f>& vertices() const { return m_vertices; }
+  std::vector<vm::vec2f>& vertices() { return m_vertices; }
 
 private:
   void justifyLeft(const std::string& str) override { makeQuads(str, 0.0f); }
@@ -159,8 +160,8 @@ private:
   void makeQuads(const std::string& str, const float x)
   {
     const auto offset = m_offset + vm::vec2f(x, m_y);
-    m_vertices =
-      kdl::vec_concat(std::move(m_vertices), m_font.quads(str, m_clockwise, offset));
+    const auto quads = m_font.quads(str, m_clockwise, offset);
+    m_vertices.insert(m_vertices.end(), quads.begin(), quads.end());
 
     m_y -= m_sizes[m_index].y();
     m_index++;
@@ -176,7 +177,7 @@ std::vector<vm::vec2f> TextureFont::quads(
 
   MakeQuads makeQuads(*this, clockwise, offset, sizes);
   string.lines(makeQuads);
-  return makeQuads.vertices();
+  return std::move(makeQuads.vertices());
 }
 
 vm::vec2f TextureFont::measure(const AttrString& string) const
@@ -251,8 +252,37 @@ vm::vec2f TextureFont::measure(const std::string& string) const
   return result;
 }
 
+std::shared_ptr<const GlyphRun> TextureFont::glyphRun(const AttrString& string)
+{
+  const auto it = m_glyphRunIndex.find(string);
+  if (it != m_glyphRunIndex.end())
+  {
+    auto& cachedGlyphRun = *it->second;
+    cachedGlyphRun.lastUse = m_useCount;
+    m_glyphRuns.splice(m_glyphRuns.begin(), m_glyphRuns, it->second);
+    return cachedGlyphRun.glyphRun;
+  }
+
+  while (
+    m_glyphRuns.size() >= MaxCachedGlyphRuns && m_glyphRuns.back().lastUse != m_useCount)
+  {
+    m_glyphRunIndex.erase(*m_glyphRuns.back().string);
+    m_glyphRuns.pop_back();
+  }
+
+  auto glyphRun =
+    std::make_shared<const GlyphRun>(GlyphRun{quads(string, true), measure(string)});
+  const auto indexIt = m_glyphRunIndex.emplace(string, m_glyphRuns.end()).first;
+  m_glyphRuns.push_front(CachedGlyphRun{&indexIt->first, glyphRun, m_useCount});
+  indexIt->second = m_glyphRuns.begin();
+  return glyphRun;
+}
+
 void TextureFont::activate()
 {
+  // the strings of the current frame have been laid out when the font is activated for
+  // rendering them, the glyph runs requested afterwards belong to the next frame
+  ++m_useCount;
   m_texture->activate();
 }
 
@@ -20,10 +20,13 @@
 #pragma once
 
 #include "Macros.h"
+#include "Renderer/AttrString.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -32,13 +35,24 @@ namespace TrenchBroom
 {
 namespace Renderer
 {
-class AttrString;
 class FontGlyph;
 class FontTexture;
 
+/**
+ * The quads and the size of a string rendered with a particular font. The quads are
+ * wound clockwise and positioned at the origin.
+ */
+struct GlyphRun
+{
+  std::vector<vm::vec2f> vertices;
+  vm::vec2f size;
+};
+
 class TextureFont
 {
 private:
+  static const size_t MaxCachedGlyphRuns;
+
   std::unique_ptr<FontTexture> m_texture;
   std::vector<FontGlyph> m_glyphs;
   int m_lineHeight;
@@ -46,6 +60,19 @@ private:
   unsigned char m_firstChar;
   unsigned char m_charCount;
 
+  struct CachedGlyphRun
+  {
+    const AttrString* string;
+    std::shared_ptr<const GlyphRun> glyphRun;
+    size_t lastUse;
+  };
+  using GlyphRunList = std::list<CachedGlyphRun>;
+
+  // ordered by recency of use, the most recently used glyph run comes first
+  GlyphRunList m_glyphRuns;
+  std::map<AttrString, GlyphRunList::iterator> m_glyphRunIndex;
+  size_t m_useCount;
+
 public:
   TextureFont(
     std::unique_ptr<FontTexture> texture,
@@ -69,6 +96,18 @@ public:
     const vm::vec2f& offset = vm::vec2f::zero()) const;
   vm::vec2f measure(const std::string& string) const;
 
+  /**
+   * Returns the glyph run of the given string. Glyph runs are cached, so that strings
+   * which are rendered repeatedly are only laid out once. The returned glyph run remains
+   * valid even if it is evicted from the cache later.
+   *
+   * If the cache is full, the least recently used glyph runs are evicted. Glyph runs
+   * that were requested since this font was last activated belong to the frame that is
+   * currently being prepared and are never evicted, so the cache grows beyond its limit
+   * instead of evicting them when a frame shows more distinct strings than it holds.
+   */
+  std::shared_ptr<const GlyphRun> glyphRun(const AttrString& string);
+
   void activate();
   void deactivate();
 };
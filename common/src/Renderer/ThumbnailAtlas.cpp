@@ -0,0 +1,187 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThumbnailAtlas.h"
+
+#include "Ensure.h"
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+ThumbnailAtlas::ThumbnailAtlas(const int size)
+  : m_size{size}
+  , m_framebufferId{0}
+  , m_textureId{0}
+  , m_depthBufferId{0}
+  , m_rowX{0}
+  , m_rowY{0}
+  , m_rowHeight{0}
+{
+  assert(m_size > 0);
+}
+
+ThumbnailAtlas::~ThumbnailAtlas()
+{
+  if (m_framebufferId != 0)
+  {
+    glAssert(glDeleteFramebuffers(1, &m_framebufferId));
+    m_framebufferId = 0;
+  }
+  if (m_depthBufferId != 0)
+  {
+    glAssert(glDeleteRenderbuffers(1, &m_depthBufferId));
+    m_depthBufferId = 0;
+  }
+  if (m_textureId != 0)
+  {
+    glAssert(glDeleteTextures(1, &m_textureId));
+    m_textureId = 0;
+  }
+}
+
+int ThumbnailAtlas::size() const
+{
+  return m_size;
+}
+
+std::optional<ThumbnailAtlas::Slot> ThumbnailAtlas::allocate(
+  const int width, const int height)
+{
+  assert(width > 0 && height > 0);
+  if (width > m_size || height > m_size)
+  {
+    return std::nullopt;
+  }
+
+  if (m_rowX + width > m_size)
+  {
+    // start a new row
+    m_rowX = 0;
+    m_rowY += m_rowHeight;
+    m_rowHeight = 0;
+  }
+
+  if (m_rowY + height > m_size)
+  {
+    return std::nullopt;
+  }
+
+  const auto slot = Slot{m_rowX, m_rowY, width, height};
+  m_rowX += width;
+  m_rowHeight = std::max(m_rowHeight, height);
+  return slot;
+}
+
+void ThumbnailAtlas::clear()
+{
+  m_rowX = 0;
+  m_rowY = 0;
+  m_rowHeight = 0;
+}
+
+vm::bbox2f ThumbnailAtlas::texCoords(const Slot& slot) const
+{
+  const auto size = static_cast<float>(m_size);
+  return vm::bbox2f{
+    vm::vec2f{static_cast<float>(slot.x), static_cast<float>(slot.y)} / size,
+    vm::vec2f{
+      static_cast<float>(slot.x + slot.width), static_cast<float>(slot.y + slot.height)}
+      / size};
+}
+
+void ThumbnailAtlas::activate()
+{
+  prepare();
+  glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
+}
+
+void ThumbnailAtlas::deactivate()
+{
+  glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+}
+
+void ThumbnailAtlas::prepare()
+{
+  if (m_framebufferId == 0)
+  {
+    glAssert(glGenTextures(1, &m_textureId));
+    glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
+    glAssert(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+    glAssert(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    glAssert(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    glAssert(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    glAssert(glTexImage2D(
+      GL_TEXTURE_2D,
+      0,
+      GL_RGBA,
+      static_cast<GLsizei>(m_size),
+      static_cast<GLsizei>(m_size),
+      0,
+      GL_RGBA,
+      GL_UNSIGNED_BYTE,
+      nullptr));
+    glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+
+    glAssert(glGenRenderbuffers(1, &m_depthBufferId));
+    glAssert(glBindRenderbuffer(GL_RENDERBUFFER, m_depthBufferId));
+    glAssert(glRenderbufferStorage(
+      GL_RENDERBUFFER,
+      GL_DEPTH_COMPONENT24,
+      static_cast<GLsizei>(m_size),
+      static_cast<GLsizei>(m_size)));
+    glAssert(glBindRenderbuffer(GL_RENDERBUFFER, 0));
+
+    GLint previousFramebufferId;
+    glAssert(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebufferId));
+
+    glAssert(glGenFramebuffers(1, &m_framebufferId));
+    glAssert(glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferId));
+    glAssert(glFramebufferTexture2D(
+      GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_textureId, 0));
+    glAssert(glFramebufferRenderbuffer(
+      GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBufferId));
+
+    GLenum status;
+    glAssert(status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+    glAssert(glBindFramebuffer(GL_FRAMEBUFFER, GLuint(previousFramebufferId)));
+    ensure(status == GL_FRAMEBUFFER_COMPLETE, "Thumbnail framebuffer must be complete");
+  }
+}
+
+void ThumbnailAtlas::bindSlot(const Slot& slot)
+{
+  prepare();
+
+  glAssert(glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferId));
+  glAssert(glViewport(slot.x, slot.y, slot.width, slot.height));
+
+  glAssert(glEnable(GL_SCISSOR_TEST));
+  glAssert(glScissor(slot.x, slot.y, slot.width, slot.height));
+  glAssert(glClearColor(0.0f, 0.0f, 0.0f, 0.0f));
+  glAssert(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+  glAssert(glDisable(GL_SCISSOR_TEST));
+}
+} // namespace Renderer
+} // namespace TrenchBroom
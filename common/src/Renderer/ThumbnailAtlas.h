@@ -0,0 +1,119 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Macros.h"
+#include "Renderer/GL.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/forward.h>
+
+#include <optional>
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+/**
+ * A square texture that serves as an offscreen render target for small images. The
+ * texture is divided into rectangular slots which are allocated row by row, and each slot
+ * can be rendered into separately.
+ *
+ * Slots cannot be freed individually. Instead, the atlas is cleared when it is full and
+ * the caller must render its images again.
+ */
+class ThumbnailAtlas
+{
+public:
+  struct Slot
+  {
+    int x;
+    int y;
+    int width;
+    int height;
+  };
+
+private:
+  int m_size;
+  GLuint m_framebufferId;
+  GLuint m_textureId;
+  GLuint m_depthBufferId;
+
+  int m_rowX;
+  int m_rowY;
+  int m_rowHeight;
+
+public:
+  explicit ThumbnailAtlas(int size);
+  ~ThumbnailAtlas();
+
+  deleteCopyAndMove(ThumbnailAtlas);
+
+  int size() const;
+
+  /**
+   * Allocates a slot of the given size in pixels, or returns nothing if the atlas has no
+   * more room for it.
+   */
+  std::optional<Slot> allocate(int width, int height);
+
+  /**
+   * Forgets all allocated slots. The texture contents are not changed.
+   */
+  void clear();
+
+  /**
+   * Returns the texture coordinates of the given slot. The minimum corner corresponds to
+   * the bottom left corner of the viewport that was used to render into the slot.
+   */
+  vm::bbox2f texCoords(const Slot& slot) const;
+
+  /**
+   * Clears the given slot, binds the atlas as the render target and sets the viewport to
+   * the slot, then calls the given function and restores the previous render target and
+   * viewport.
+   */
+  template <typename F>
+  void render(const Slot& slot, const F& renderFunc)
+  {
+    GLint previousFramebufferId, previousViewport[4];
+    glAssert(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebufferId));
+    glAssert(glGetIntegerv(GL_VIEWPORT, previousViewport));
+
+    bindSlot(slot);
+    renderFunc();
+
+    glAssert(glBindFramebuffer(GL_FRAMEBUFFER, GLuint(previousFramebufferId)));
+    glAssert(glViewport(
+      previousViewport[0],
+      previousViewport[1],
+      previousViewport[2],
+      previousViewport[3]));
+  }
+
+  void activate();
+  void deactivate();
+
+private:
+  void prepare();
+  void bindSlot(const Slot& slot);
+};
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -27,14 +27,16 @@ namespace TrenchBroom
 {
 namespace Renderer
 {
-Vbo::Vbo(GLenum type, const size_t capacity, const GLenum usage)
-  : m_type(type)
+Vbo::Vbo(
+  VboManager& vboManager, GLenum type, const size_t capacity, const GLenum usage)
+  : m_vboManager(vboManager)
+  , m_type(type)
   , m_capacity(capacity)
 {
   assert(m_type == GL_ELEMENT_ARRAY_BUFFER || m_type == GL_ARRAY_BUFFER);
 
   glAssert(glGenBuffers(1, &m_bufferId));
-  glAssert(glBindBuffer(m_type, m_bufferId));
+  m_vboManager.bindBuffer(m_type, m_bufferId);
   glAssert(glBufferData(m_type, static_cast<GLsizeiptr>(m_capacity), nullptr, usage));
 }
 
@@ -63,13 +65,13 @@ size_t Vbo::capacity() const
 void Vbo::bind()
 {
   assert(m_bufferId != 0);
-  glAssert(glBindBuffer(m_type, m_bufferId));
+  m_vboManager.bindBuffer(m_type, m_bufferId);
 }
 
 void Vbo::unbind()
 {
   assert(m_bufferId != 0);
-  glAssert(glBindBuffer(m_type, 0));
+  m_vboManager.unbindBuffer(m_type);
 }
 } // namespace Renderer
 } // namespace TrenchBroom
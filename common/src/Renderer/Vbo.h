@@ -37,6 +37,7 @@ class Vbo
 private:
   friend class VboManager;
 
+  VboManager& m_vboManager;
   /**
    * e.g. GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER
    */
@@ -48,7 +49,7 @@ private:
    * Immediately creates and binds to a buffer of the given type and capacity.
    * The contents are initially unspecified.
    */
-  Vbo(GLenum type, size_t capacity, GLenum usage);
+  Vbo(VboManager& vboManager, GLenum type, size_t capacity, GLenum usage);
   ~Vbo();
 
   /**
@@ -101,7 +102,7 @@ public:
     const GLvoid* ptr = static_cast<const GLvoid*>(array);
     const GLintptr offset = static_cast<GLintptr>(address);
     const GLsizeiptr sizei = static_cast<GLsizeiptr>(size);
-    glAssert(glBindBuffer(m_type, m_bufferId));
+    m_vboManager.bindBuffer(m_type, m_bufferId);
     glAssert(glBufferSubData(m_type, offset, sizei, ptr));
 
     return size;
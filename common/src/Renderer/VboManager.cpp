@@ -63,12 +63,13 @@ VboManager::VboManager(ShaderManager* shaderManager)
   , m_currentVboCount(0u)
   , m_currentVboSize(0u)
   , m_shaderManager(shaderManager)
+  , m_keepBuffersBound(false)
 {
 }
 
 Vbo* VboManager::allocateVbo(VboType type, const size_t capacity, const VboUsage usage)
 {
-  auto* result = new Vbo(typeToOpenGL(type), capacity, usageToOpenGL(usage));
+  auto* result = new Vbo(*this, typeToOpenGL(type), capacity, usageToOpenGL(usage));
 
   m_currentVboSize += capacity;
   m_currentVboCount++;
@@ -82,6 +83,7 @@ void VboManager::destroyVbo(Vbo* vbo)
   m_currentVboSize -= vbo->capacity();
   m_currentVboCount--;
 
+  bufferDeleted(vbo->m_type, vbo->m_bufferId);
   vbo->free();
   delete vbo;
 }
@@ -105,5 +107,69 @@ ShaderManager& VboManager::shaderManager()
 {
   return *m_shaderManager;
 }
+
+void VboManager::setKeepBuffersBound(const bool keepBuffersBound)
+{
+  if (keepBuffersBound == m_keepBuffersBound)
+  {
+    return;
+  }
+
+  m_keepBuffersBound = keepBuffersBound;
+  if (!m_keepBuffersBound)
+  {
+    // perform the deferred unbinds
+    for (const GLenum type : {GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER})
+    {
+      if (boundBuffer(type).value_or(0) != 0)
+      {
+        glAssert(glBindBuffer(type, 0));
+        ++glCallCounts().bufferBinds;
+      }
+    }
+  }
+
+  // buffers may have been bound in another context since buffers were last kept bound
+  m_boundArrayBuffer = std::nullopt;
+  m_boundElementArrayBuffer = std::nullopt;
+}
+
+std::optional<GLuint>& VboManager::boundBuffer(const GLenum type)
+{
+  return type == GL_ARRAY_BUFFER ? m_boundArrayBuffer : m_boundElementArrayBuffer;
+}
+
+void VboManager::bindBuffer(const GLenum type, const GLuint bufferId)
+{
+  auto& boundBufferId = boundBuffer(type);
+  if (!m_keepBuffersBound || boundBufferId != bufferId)
+  {
+    glAssert(glBindBuffer(type, bufferId));
+    ++glCallCounts().bufferBinds;
+    if (m_keepBuffersBound)
+    {
+      boundBufferId = bufferId;
+    }
+  }
+}
+
+void VboManager::unbindBuffer(const GLenum type)
+{
+  if (!m_keepBuffersBound)
+  {
+    glAssert(glBindBuffer(type, 0));
+    ++glCallCounts().bufferBinds;
+  }
+}
+
+void VboManager::bufferDeleted(const GLenum type, const GLuint bufferId)
+{
+  // deleting a buffer unbinds it
+  auto& boundBufferId = boundBuffer(type);
+  if (boundBufferId == bufferId)
+  {
+    boundBufferId = 0;
+  }
+}
 } // namespace Renderer
 } // namespace TrenchBroom
@@ -22,6 +22,7 @@
 #include "Renderer/GL.h"
 
 #include <cstddef> // for size_t
+#include <optional>
 
 namespace TrenchBroom
 {
@@ -50,6 +51,14 @@ private:
   size_t m_currentVboSize;
   ShaderManager* m_shaderManager;
 
+  /**
+   * The buffers bound to GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER while buffers are
+   * kept bound, or nothing if the binding is unknown.
+   */
+  std::optional<GLuint> m_boundArrayBuffer;
+  std::optional<GLuint> m_boundElementArrayBuffer;
+  bool m_keepBuffersBound;
+
 public:
   explicit VboManager(ShaderManager* shaderManager);
   /**
@@ -64,6 +73,22 @@ public:
   size_t currentVboSize() const;
 
   ShaderManager& shaderManager();
+
+  /**
+   * While buffers are kept bound, binding a buffer that is already bound does nothing,
+   * and unbinding a buffer is deferred until buffers are no longer kept bound. This is
+   * only safe while the bound buffers cannot change behind the manager's back and no
+   * draw call relies on a buffer not being bound.
+   */
+  void setKeepBuffersBound(bool keepBuffersBound);
+
+private:
+  friend class Vbo;
+
+  std::optional<GLuint>& boundBuffer(GLenum type);
+  void bindBuffer(GLenum type, GLuint bufferId);
+  void unbindBuffer(GLenum type);
+  void bufferDeleted(GLenum type, GLuint bufferId);
 };
 } // namespace Renderer
 } // namespace TrenchBroom
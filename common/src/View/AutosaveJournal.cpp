@@ -0,0 +1,473 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AutosaveJournal.h"
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace View
+{
+namespace
+{
+std::vector<std::string_view> splitLines(const std::string_view text)
+{
+  auto result = std::vector<std::string_view>{};
+
+  auto begin = size_t(0);
+  for (auto end = text.find('\n'); end != std::string_view::npos;
+       end = text.find('\n', begin))
+  {
+    result.push_back(text.substr(begin, end - begin));
+    begin = end + 1u;
+  }
+  result.push_back(text.substr(begin));
+
+  return result;
+}
+
+std::string joinLines(const std::vector<std::string_view>& lines)
+{
+  assert(!lines.empty());
+
+  auto size = lines.size() - 1u;
+  for (const auto& line : lines)
+  {
+    size += line.size();
+  }
+
+  auto result = std::string{};
+  result.reserve(size);
+
+  result.append(lines.front());
+  for (auto it = std::next(lines.begin()); it != lines.end(); ++it)
+  {
+    result.push_back('\n');
+    result.append(*it);
+  }
+
+  return result;
+}
+
+std::uint64_t checksum(const std::string_view text)
+{
+  // FNV-1a, the checksum must not depend on the standard library implementation
+  auto result = std::uint64_t(14695981039346656037u);
+  for (const auto c : text)
+  {
+    result ^= static_cast<unsigned char>(c);
+    result *= std::uint64_t(1099511628211u);
+  }
+  return result;
+}
+
+struct Hunk
+{
+  size_t position;
+  size_t removeCount;
+  std::vector<std::string_view> insertedLines;
+};
+
+/**
+ * Computes the shortest edit script between the given sequences of lines using Myers'
+ * algorithm and groups the edits into hunks. Common leading and trailing lines are skipped
+ * first because the changes between two autosaves are usually small and local.
+ */
+std::optional<std::vector<Hunk>> diffLines(
+  const std::vector<std::string_view>& oldLines,
+  const std::vector<std::string_view>& newLines,
+  const size_t maxEdits)
+{
+  auto prefix = size_t(0);
+  while (prefix < oldLines.size() && prefix < newLines.size()
+         && oldLines[prefix] == newLines[prefix])
+  {
+    ++prefix;
+  }
+
+  auto suffix = size_t(0);
+  while (suffix < oldLines.size() - prefix && suffix < newLines.size() - prefix
+         && oldLines[oldLines.size() - suffix - 1u] == newLines[newLines.size() - suffix - 1u])
+  {
+    ++suffix;
+  }
+
+  const auto n = static_cast<std::ptrdiff_t>(oldLines.size() - prefix - suffix);
+  const auto m = static_cast<std::ptrdiff_t>(newLines.size() - prefix - suffix);
+  const auto maxD = std::min(n + m, static_cast<std::ptrdiff_t>(maxEdits));
+  if (std::abs(n - m) > maxD)
+  {
+    return std::nullopt;
+  }
+
+  const auto oldLine = [&](const std::ptrdiff_t i) {
+    return oldLines[prefix + static_cast<size_t>(i)];
+  };
+  const auto newLine = [&](const std::ptrdiff_t i) {
+    return newLines[prefix + static_cast<size_t>(i)];
+  };
+
+  // v[offset + k] holds the furthest x reached on diagonal k, trace[d] holds the values
+  // of the diagonals -d..d after step d
+  const auto offset = maxD + 1;
+  auto v = std::vector<std::ptrdiff_t>(static_cast<size_t>(2 * maxD + 3), 0);
+  auto trace = std::vector<std::vector<std::ptrdiff_t>>{};
+
+  const auto at = [&](std::vector<std::ptrdiff_t>& values, const std::ptrdiff_t k) -> auto&
+  {
+    return values[static_cast<size_t>(offset + k)];
+  };
+
+  auto found = std::optional<std::ptrdiff_t>{};
+  for (auto d = std::ptrdiff_t(0); d <= maxD && !found; ++d)
+  {
+    for (auto k = -d; k <= d; k += 2)
+    {
+      auto x = (k == -d || (k != d && at(v, k - 1) < at(v, k + 1))) ? at(v, k + 1)
+                                                                     : at(v, k - 1) + 1;
+      auto y = x - k;
+      while (x < n && y < m && oldLine(x) == newLine(y))
+      {
+        ++x;
+        ++y;
+      }
+      at(v, k) = x;
+
+      if (x >= n && y >= m)
+      {
+        found = d;
+        break;
+      }
+    }
+    trace.push_back(v);
+  }
+
+  if (!found)
+  {
+    return std::nullopt;
+  }
+
+  // walk back from the end and record the edits in reverse order
+  struct Edit
+  {
+    std::ptrdiff_t x;
+    std::optional<std::ptrdiff_t> insertedY;
+  };
+  auto edits = std::vector<Edit>{};
+
+  auto x = n;
+  auto y = m;
+  for (auto d = *found; d > 0; --d)
+  {
+    auto& previous = trace[static_cast<size_t>(d - 1)];
+    const auto k = x - y;
+    const auto previousK =
+      (k == -d || (k != d && at(previous, k - 1) < at(previous, k + 1))) ? k + 1 : k - 1;
+    const auto previousX = at(previous, previousK);
+    const auto previousY = previousX - previousK;
+
+    while (x > previousX && y > previousY)
+    {
+      --x;
+      --y;
+    }
+
+    if (x == previousX)
+    {
+      edits.push_back(Edit{x, previousY});
+    }
+    else
+    {
+      edits.push_back(Edit{previousX, std::nullopt});
+    }
+
+    x = previousX;
+    y = previousY;
+  }
+
+  auto result = std::vector<Hunk>{};
+  for (auto it = edits.rbegin(); it != edits.rend(); ++it)
+  {
+    const auto position = prefix + static_cast<size_t>(it->x);
+    if (result.empty() || result.back().position + result.back().removeCount != position)
+    {
+      result.push_back(Hunk{position, 0u, {}});
+    }
+
+    auto& hunk = result.back();
+    if (it->insertedY)
+    {
+      hunk.insertedLines.push_back(newLine(*it->insertedY));
+    }
+    else
+    {
+      ++hunk.removeCount;
+    }
+  }
+
+  return result;
+}
+
+class JournalReader
+{
+private:
+  std::string_view m_journal;
+
+public:
+  explicit JournalReader(const std::string_view journal)
+    : m_journal{journal}
+  {
+  }
+
+  bool eof() const { return m_journal.empty(); }
+
+  std::optional<std::string_view> readLine()
+  {
+    const auto end = m_journal.find('\n');
+    if (end == std::string_view::npos)
+    {
+      return std::nullopt;
+    }
+
+    const auto line = m_journal.substr(0, end);
+    m_journal.remove_prefix(end + 1u);
+    return line;
+  }
+
+  template <typename... T>
+  bool readNumbers(const std::string_view prefix, T&... numbers)
+  {
+    const auto line = readLine();
+    if (!line || line->substr(0, prefix.size()) != prefix)
+    {
+      return false;
+    }
+
+    const auto* cur = line->data() + prefix.size();
+    const auto* end = line->data() + line->size();
+    const auto readNumber = [&](auto& number) {
+      while (cur != end && *cur == ' ')
+      {
+        ++cur;
+      }
+      const auto [ptr, ec] = std::from_chars(cur, end, number);
+      cur = ptr;
+      return ec == std::errc{};
+    };
+
+    return (readNumber(numbers) && ...) && cur == end;
+  }
+};
+
+std::optional<std::string> replayRecord(
+  JournalReader& reader, const std::vector<std::string_view>& oldLines)
+{
+  auto hunkCount = size_t(0);
+  auto expectedChecksum = std::uint64_t(0);
+  if (!reader.readNumbers("@", hunkCount, expectedChecksum))
+  {
+    return std::nullopt;
+  }
+
+  auto newLines = std::vector<std::string_view>{};
+  newLines.reserve(oldLines.size());
+
+  auto cursor = size_t(0);
+  for (size_t i = 0; i < hunkCount; ++i)
+  {
+    auto position = size_t(0);
+    auto removeCount = size_t(0);
+    auto insertCount = size_t(0);
+    if (
+      !reader.readNumbers("", position, removeCount, insertCount) || position < cursor
+      || position + removeCount > oldLines.size())
+    {
+      return std::nullopt;
+    }
+
+    newLines.insert(
+      newLines.end(),
+      std::next(oldLines.begin(), static_cast<std::ptrdiff_t>(cursor)),
+      std::next(oldLines.begin(), static_cast<std::ptrdiff_t>(position)));
+
+    for (size_t j = 0; j < insertCount; ++j)
+    {
+      const auto line = reader.readLine();
+      if (!line)
+      {
+        return std::nullopt;
+      }
+      newLines.push_back(*line);
+    }
+
+    cursor = position + removeCount;
+  }
+
+  newLines.insert(
+    newLines.end(),
+    std::next(oldLines.begin(), static_cast<std::ptrdiff_t>(cursor)),
+    oldLines.end());
+
+  if (newLines.empty())
+  {
+    return std::nullopt;
+  }
+
+  auto result = joinLines(newLines);
+  if (checksum(result) != expectedChecksum)
+  {
+    return std::nullopt;
+  }
+
+  return result;
+}
+} // namespace
+
+std::string stripObjectComments(const std::string_view mapText)
+{
+  const auto isObjectComment = [](const std::string_view line) {
+    for (const auto prefix : {std::string_view{"// entity "}, std::string_view{"// brush "}})
+    {
+      if (line.size() > prefix.size() && line.substr(0, prefix.size()) == prefix)
+      {
+        const auto number = line.substr(prefix.size());
+        return std::all_of(
+          number.begin(), number.end(), [](const auto c) { return c >= '0' && c <= '9'; });
+      }
+    }
+    return false;
+  };
+
+  auto result = std::string{};
+  result.reserve(mapText.size());
+
+  auto begin = size_t(0);
+  while (begin < mapText.size())
+  {
+    const auto end = std::min(mapText.find('\n', begin), mapText.size());
+    const auto line = mapText.substr(begin, end - begin);
+    if (!isObjectComment(line))
+    {
+      result.append(mapText.substr(begin, std::min(end + 1u, mapText.size()) - begin));
+    }
+    begin = end + 1u;
+  }
+
+  return result;
+}
+
+std::string restoreObjectComments(const std::string_view mapText)
+{
+  auto result = std::string{};
+  result.reserve(mapText.size());
+
+  // entities are the objects at the top level, and brushes and patches are the objects
+  // nested in them
+  auto depth = size_t(0);
+  auto entityNo = size_t(0);
+  auto brushNo = size_t(0);
+
+  auto begin = size_t(0);
+  while (begin < mapText.size())
+  {
+    const auto end = std::min(mapText.find('\n', begin), mapText.size());
+    const auto line = mapText.substr(begin, end - begin);
+    if (line == "{")
+    {
+      if (depth == 0u)
+      {
+        result.append("// entity " + std::to_string(entityNo++) + "\n");
+        brushNo = 0u;
+      }
+      else if (depth == 1u)
+      {
+        result.append("// brush " + std::to_string(brushNo++) + "\n");
+      }
+      ++depth;
+    }
+    else if (line == "}" && depth > 0u)
+    {
+      --depth;
+    }
+    result.append(mapText.substr(begin, std::min(end + 1u, mapText.size()) - begin));
+    begin = end + 1u;
+  }
+
+  return result;
+}
+
+std::optional<std::string> makeJournalRecord(
+  const std::string_view oldText, const std::string_view newText, const size_t maxEdits)
+{
+  const auto oldLines = splitLines(oldText);
+  const auto newLines = splitLines(newText);
+
+  const auto hunks = diffLines(oldLines, newLines, maxEdits);
+  if (!hunks)
+  {
+    return std::nullopt;
+  }
+
+  auto result = std::string{};
+  result.append("@ ")
+    .append(std::to_string(hunks->size()))
+    .append(" ")
+    .append(std::to_string(checksum(newText)))
+    .append("\n");
+
+  for (const auto& hunk : *hunks)
+  {
+    result.append(std::to_string(hunk.position))
+      .append(" ")
+      .append(std::to_string(hunk.removeCount))
+      .append(" ")
+      .append(std::to_string(hunk.insertedLines.size()))
+      .append("\n");
+    for (const auto& line : hunk.insertedLines)
+    {
+      result.append(line).append("\n");
+    }
+  }
+
+  return result;
+}
+
+std::string replayJournal(std::string text, const std::string_view journal)
+{
+  auto reader = JournalReader{journal};
+  while (!reader.eof())
+  {
+    auto newText = replayRecord(reader, splitLines(text));
+    if (!newText)
+    {
+      break;
+    }
+    text = std::move(*newText);
+  }
+  return text;
+}
+} // namespace View
+} // namespace TrenchBroom
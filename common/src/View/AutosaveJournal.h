@@ -0,0 +1,66 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace TrenchBroom
+{
+namespace View
+{
+/**
+ * Removes the entity and brush number comments from the given map file contents.
+ *
+ * These numbers change whenever an object is added or removed, so keeping them would make
+ * the difference between two versions of a map much larger than the actual change.
+ */
+std::string stripObjectComments(std::string_view mapText);
+
+/**
+ * Inserts entity and brush number comments into the given map file contents, which must
+ * not contain any. This undoes stripObjectComments for map files written by TrenchBroom.
+ */
+std::string restoreObjectComments(std::string_view mapText);
+
+/**
+ * Computes a journal record that transforms the given old text into the given new text.
+ *
+ * A record consists of a header line containing the number of hunks and a checksum of
+ * the resulting text, followed by the hunks. Each hunk replaces a range of lines of the
+ * old text with a sequence of new lines.
+ *
+ * Returns std::nullopt if more than the given number of lines would have to be removed or
+ * inserted.
+ */
+std::optional<std::string> makeJournalRecord(
+  std::string_view oldText, std::string_view newText, size_t maxEdits);
+
+/**
+ * Applies the records of the given journal to the given text in order and returns the
+ * result.
+ *
+ * Replaying stops at the first record that is incomplete or does not yield the expected
+ * text, e.g. because the application was terminated while the record was being written.
+ */
+std::string replayJournal(std::string text, std::string_view journal);
+} // namespace View
+} // namespace TrenchBroom
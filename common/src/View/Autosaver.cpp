@@ -22,6 +22,8 @@
 #include "Exceptions.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
+#include "IO/IOUtils.h"
+#include "View/AutosaveJournal.h"
 #include "View/MapDocument.h"
 
 #include <kdl/memory_utils.h>
@@ -29,15 +31,49 @@
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
 
+#include <QString>
+
 #include <algorithm> // for std::sort
 #include <cassert>
+#include <fstream>
 #include <limits>
 #include <memory>
+#include <sstream>
 
 namespace TrenchBroom
 {
 namespace View
 {
+namespace
+{
+/**
+ * The maximum number of lines that a journal record may remove or insert. If a change is
+ * larger, a new backup is created instead.
+ */
+constexpr auto MaxJournalEdits = size_t(1024);
+
+/**
+ * Collects the messages logged on the worker thread so that they can be passed on to the
+ * actual logger on the main thread.
+ */
+class BufferingLogger : public Logger
+{
+public:
+  std::vector<std::tuple<LogLevel, std::string>> messages;
+
+private:
+  void doLog(const LogLevel level, const std::string& message) override
+  {
+    messages.emplace_back(level, message);
+  }
+
+  void doLog(const LogLevel level, const QString& message) override
+  {
+    doLog(level, message.toStdString());
+  }
+};
+} // namespace
+
 Autosaver::BackupFileMatcher::BackupFileMatcher(const IO::Path& mapBasename)
   : m_mapBasename(mapBasename)
 {
@@ -84,8 +120,25 @@ Autosaver::Autosaver(
 {
 }
 
+Autosaver::~Autosaver()
+{
+  if (m_pendingBackup.valid())
+  {
+    m_pendingBackup.wait();
+  }
+}
+
 void Autosaver::triggerAutosave(Logger& logger)
 {
+  if (m_pendingBackup.valid())
+  {
+    if (m_pendingBackup.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+    {
+      return;
+    }
+    collectPendingBackup(logger);
+  }
+
   if (kdl::mem_expired(m_document))
   {
     return;
@@ -117,42 +170,235 @@ void Autosaver::triggerAutosave(Logger& logger)
     return;
   }
 
-  autosave(logger, document);
+  autosave(document);
+}
+
+void Autosaver::recoverJournal(Logger& logger)
+{
+  waitForPendingBackup(logger);
+
+  if (kdl::mem_expired(m_document))
+  {
+    return;
+  }
+
+  const auto mapPath = kdl::mem_lock(m_document)->path();
+  if (!mapPath.isAbsolute())
+  {
+    return;
+  }
+  if (!IO::Disk::directoryExists(mapPath.deleteLastComponent() + IO::Path("autosave")))
+  {
+    return;
+  }
+  if (m_journal && m_journal->mapPath == mapPath)
+  {
+    // the journal was written by the current session
+    return;
+  }
+
+  m_pendingBackup = std::async(std::launch::async, [this, mapPath]() {
+    auto backupLogger = BufferingLogger{};
+    try
+    {
+      const auto mapBasename = mapPath.lastComponent().deleteExtension();
+      auto fs = createBackupFileSystem(backupLogger, mapPath);
+      auto backups = collectBackups(fs, mapBasename);
+      recoverJournal(backupLogger, fs, backups, mapBasename);
+    }
+    catch (const FileSystemException& e)
+    {
+      backupLogger.error() << "Could not recover autosave journal: " << e.what();
+    }
+    return std::move(backupLogger.messages);
+  });
 }
 
-void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document)
+void Autosaver::waitForPendingBackup(Logger& logger)
 {
-  const auto& mapPath = document->path();
+  if (m_pendingBackup.valid())
+  {
+    collectPendingBackup(logger);
+  }
+}
+
+void Autosaver::collectPendingBackup(Logger& logger)
+{
+  assert(m_pendingBackup.valid());
+
+  for (const auto& [level, message] : m_pendingBackup.get())
+  {
+    logger.log(level, message);
+  }
+}
+
+void Autosaver::autosave(std::shared_ptr<MapDocument> document)
+{
+  const auto mapPath = document->path();
   assert(IO::Disk::fileExists(IO::Disk::fixPath(mapPath)));
 
+  // the serialized document is an immutable snapshot, so the backup can be written while
+  // the document is being edited
+  auto stream = std::stringstream{};
+  document->saveDocumentTo(stream);
+
+  m_lastSaveTime = Clock::now();
+  m_lastModificationCount = document->modificationCount();
+
+  m_pendingBackup = std::async(
+    std::launch::async, [this, mapPath, contents = stream.str()]() {
+      auto backupLogger = BufferingLogger{};
+      writeBackup(backupLogger, mapPath, contents);
+      return std::move(backupLogger.messages);
+    });
+}
+
+void Autosaver::writeBackup(
+  Logger& logger, const IO::Path& mapPath, const std::string& contents)
+{
   const auto mapFilename = mapPath.lastComponent();
   const auto mapBasename = mapFilename.deleteExtension();
 
   try
   {
     auto fs = createBackupFileSystem(logger, mapPath);
-    auto backups = collectBackups(fs, mapBasename);
-
-    thinBackups(logger, fs, backups);
-    cleanBackups(fs, backups, mapBasename);
+    auto text = stripObjectComments(contents);
 
-    assert(backups.size() < m_maxBackups);
-    const auto backupNo = backups.size() + 1;
+    if (appendToJournal(logger, fs, mapPath, mapBasename, text))
+    {
+      return;
+    }
 
-    const auto backupFilePath = fs.makeAbsolute(makeBackupName(mapBasename, backupNo));
+    auto backups = collectBackups(fs, mapBasename);
+    if (!m_journal || m_journal->mapPath != mapPath)
+    {
+      recoverJournal(logger, fs, backups, mapBasename);
+    }
 
-    m_lastSaveTime = Clock::now();
-    m_lastModificationCount = document->modificationCount();
-    document->saveDocumentTo(backupFilePath);
+    m_journal = std::nullopt;
+    const auto backupFilename = createBackup(logger, fs, backups, mapBasename, contents);
+    m_journal =
+      Journal{mapPath, backups.size(), std::move(text), contents.size(), size_t(0)};
 
-    logger.info() << "Created autosave backup at " << backupFilePath;
+    logger.info() << "Created autosave backup at " << fs.makeAbsolute(backupFilename);
   }
   catch (const FileSystemException& e)
   {
+    m_journal = std::nullopt;
     logger.error() << "Aborting autosave: " << e.what();
   }
 }
 
+bool Autosaver::appendToJournal(
+  Logger& logger,
+  IO::WritableDiskFileSystem& fs,
+  const IO::Path& mapPath,
+  const IO::Path& mapBasename,
+  std::string& text)
+{
+  if (!m_journal || m_journal->mapPath != mapPath)
+  {
+    return false;
+  }
+
+  const auto backupFilename = makeBackupName(mapBasename, m_journal->backupNo);
+  const auto journalFilename = makeJournalName(backupFilename);
+  if (
+    !fs.fileExists(backupFilename)
+    || (m_journal->journalSize > 0u && !fs.fileExists(journalFilename)))
+  {
+    return false;
+  }
+
+  const auto record = makeJournalRecord(m_journal->text, text, MaxJournalEdits);
+
+  // a long journal takes longer to recover than a new backup is to write
+  if (!record || m_journal->journalSize + record->size() > m_journal->backupSize / 2u)
+  {
+    return false;
+  }
+
+  const auto journalPath = fs.makeAbsolute(journalFilename);
+  auto stream = IO::openPathAsOutputStream(journalPath, std::ios::out | std::ios::app);
+  stream << *record;
+  stream.close();
+  if (!stream)
+  {
+    throw FileSystemException{"Cannot write file: " + journalPath.asString()};
+  }
+
+  m_journal->text = std::move(text);
+  m_journal->journalSize += record->size();
+
+  logger.info() << "Appended changes to autosave journal at " << journalPath;
+  return true;
+}
+
+void Autosaver::recoverJournal(
+  Logger& logger,
+  IO::WritableDiskFileSystem& fs,
+  std::vector<IO::Path>& backups,
+  const IO::Path& mapBasename) const
+{
+  if (backups.empty())
+  {
+    return;
+  }
+
+  const auto journalFilename = makeJournalName(backups.back());
+  if (!fs.fileExists(journalFilename))
+  {
+    return;
+  }
+
+  const auto backup = IO::Disk::readTextFile(fs.makeAbsolute(backups.back()));
+  const auto journal = IO::Disk::readTextFile(fs.makeAbsolute(journalFilename));
+
+  const auto recovered =
+    restoreObjectComments(replayJournal(stripObjectComments(backup), journal));
+  const auto backupFilename = createBackup(logger, fs, backups, mapBasename, recovered);
+
+  // the journal is only deleted once the new backup contains its changes, the backups
+  // may have been renumbered in the meantime
+  if (backups.size() > 1u)
+  {
+    const auto oldJournalFilename = makeJournalName(backups[backups.size() - 2u]);
+    if (fs.fileExists(oldJournalFilename))
+    {
+      fs.deleteFile(oldJournalFilename);
+    }
+  }
+
+  logger.info() << "Recovered autosave journal into " << fs.makeAbsolute(backupFilename);
+}
+
+IO::Path Autosaver::createBackup(
+  Logger& logger,
+  IO::WritableDiskFileSystem& fs,
+  std::vector<IO::Path>& backups,
+  const IO::Path& mapBasename,
+  const std::string& contents) const
+{
+  thinBackups(logger, fs, backups);
+  cleanBackups(fs, backups, mapBasename);
+
+  assert(backups.size() < m_maxBackups);
+  const auto backupNo = backups.size() + 1;
+
+  const auto backupFilename = makeBackupName(mapBasename, backupNo);
+  const auto journalFilename = makeJournalName(backupFilename);
+  if (fs.fileExists(journalFilename))
+  {
+    // a stale journal must not be applied to the new backup
+    fs.deleteFile(journalFilename);
+  }
+
+  fs.createFileAtomic(backupFilename, contents);
+  backups.push_back(backupFilename);
+
+  return backupFilename;
+}
+
 IO::WritableDiskFileSystem Autosaver::createBackupFileSystem(
   Logger& logger, const IO::Path& mapPath) const
 {
@@ -194,6 +440,11 @@ void Autosaver::thinBackups(
     try
     {
       fs.deleteFile(filename);
+      if (const auto journalFilename = makeJournalName(filename);
+          fs.fileExists(journalFilename))
+      {
+        fs.deleteFile(journalFilename);
+      }
       logger.debug() << "Deleted autosave backup " << filename;
       backups.erase(std::begin(backups));
     }
@@ -218,6 +469,12 @@ void Autosaver::cleanBackups(
     if (oldName != newName)
     {
       fs.moveFile(oldName, newName, false);
+      if (const auto oldJournalName = makeJournalName(oldName);
+          fs.fileExists(oldJournalName))
+      {
+        fs.moveFile(oldJournalName, makeJournalName(newName), true);
+      }
+      backups[i] = newName;
     }
   }
 }
@@ -227,6 +484,11 @@ IO::Path Autosaver::makeBackupName(const IO::Path& mapBasename, const size_t ind
   return IO::Path(kdl::str_to_string(mapBasename, ".", index, ".map"));
 }
 
+IO::Path makeJournalName(const IO::Path& backupName)
+{
+  return backupName.replaceExtension("journal");
+}
+
 size_t extractBackupNo(const IO::Path& path)
 {
   // currently this function is only used when comparing file names which have already
@@ -20,14 +20,18 @@
 #pragma once
 
 #include "IO/Path.h"
+#include "Logger.h"
 
 #include <chrono>
+#include <future>
 #include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
 
 namespace TrenchBroom
 {
-class Logger;
-
 namespace IO
 {
 class WritableDiskFileSystem;
@@ -77,16 +81,86 @@ private:
    */
   size_t m_lastModificationCount;
 
+  /**
+   * The backup that is currently being written on a worker thread, if any. Yields the
+   * messages that were logged while writing the backup.
+   */
+  std::future<std::vector<std::tuple<LogLevel, std::string>>> m_pendingBackup;
+
+  /**
+   * The journal that records the changes made since the most recent backup was created.
+   * Only accessed while writing a backup.
+   */
+  struct Journal
+  {
+    IO::Path mapPath;
+    size_t backupNo;
+    /**
+     * The contents of the backup with all journal records applied, without object
+     * comments.
+     */
+    std::string text;
+    size_t backupSize;
+    size_t journalSize;
+  };
+
+  std::optional<Journal> m_journal;
+
 public:
   explicit Autosaver(
     std::weak_ptr<MapDocument> document,
     std::chrono::milliseconds saveInterval = std::chrono::milliseconds(10 * 60 * 1000),
     size_t maxBackups = 50);
+  ~Autosaver();
 
+  /**
+   * Creates a new backup if the document was modified and the save interval has elapsed.
+   *
+   * The document is serialized on the calling thread, but the backup file is written on a
+   * worker thread. No new backup is created while a previous one is still being written.
+   *
+   * Once a backup was created, subsequent changes are appended to a journal next to it
+   * instead of creating another full backup, until the journal gets too large in relation
+   * to the backup.
+   */
   void triggerAutosave(Logger& logger);
 
+  /**
+   * Replays a journal that a previous session left behind next to the newest backup of
+   * the document into a new backup, so that the newest backup contains all changes that
+   * were recorded before that session ended, e.g. due to a crash.
+   *
+   * This is called when a document was opened. The new backup is written on a worker
+   * thread like any other backup.
+   */
+  void recoverJournal(Logger& logger);
+
+  /**
+   * Blocks until the backup that is currently being written, if any, is finished.
+   */
+  void waitForPendingBackup(Logger& logger);
+
 private:
-  void autosave(Logger& logger, std::shared_ptr<View::MapDocument> document);
+  void collectPendingBackup(Logger& logger);
+  void autosave(std::shared_ptr<View::MapDocument> document);
+  void writeBackup(Logger& logger, const IO::Path& mapPath, const std::string& contents);
+  bool appendToJournal(
+    Logger& logger,
+    IO::WritableDiskFileSystem& fs,
+    const IO::Path& mapPath,
+    const IO::Path& mapBasename,
+    std::string& text);
+  void recoverJournal(
+    Logger& logger,
+    IO::WritableDiskFileSystem& fs,
+    std::vector<IO::Path>& backups,
+    const IO::Path& mapBasename) const;
+  IO::Path createBackup(
+    Logger& logger,
+    IO::WritableDiskFileSystem& fs,
+    std::vector<IO::Path>& backups,
+    const IO::Path& mapBasename,
+    const std::string& contents) const;
   IO::WritableDiskFileSystem createBackupFileSystem(
     Logger& logger, const IO::Path& mapPath) const;
   std::vector<IO::Path> collectBackups(
@@ -100,6 +174,8 @@ private:
   IO::Path makeBackupName(const IO::Path& mapBasename, const size_t index) const;
 };
 
+IO::Path makeJournalName(const IO::Path& backupName);
+
 size_t extractBackupNo(const IO::Path& path);
 } // namespace View
 } // namespace TrenchBroom
@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 
 namespace TrenchBroom
 {
@@ -445,6 +446,22 @@ const std::vector<LayoutRow>& LayoutGroup::rows() const
   return m_rows;
 }
 
+std::pair<size_t, size_t> LayoutGroup::indicesOfRowsIntersectingY(
+  const float y, const float height) const
+{
+  // the rows are ordered from top to bottom and don't overlap
+  const auto first =
+    std::partition_point(m_rows.begin(), m_rows.end(), [&](const auto& row) {
+      return row.bounds().bottom() < y;
+    });
+  const auto last = std::partition_point(first, m_rows.end(), [&](const auto& row) {
+    return row.bounds().top() <= y + height;
+  });
+  return {
+    size_t(std::distance(m_rows.begin(), first)),
+    size_t(std::distance(m_rows.begin(), last))};
+}
+
 size_t LayoutGroup::indexOfRowAt(const float y) const
 {
   for (size_t i = 0; i < m_rows.size(); ++i)
@@ -24,6 +24,7 @@
 
 #include <any>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom
@@ -216,6 +217,12 @@ public:
   LayoutBounds bounds() const;
 
   const std::vector<LayoutRow>& rows() const;
+
+  /**
+   * Returns the index of the first row that intersects the given vertical range and the
+   * index past the last such row.
+   */
+  std::pair<size_t, size_t> indicesOfRowsIntersectingY(float y, float height) const;
   size_t indexOfRowAt(float y) const;
   const LayoutCell* cellAt(float x, float y) const;
 
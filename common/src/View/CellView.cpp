@@ -94,6 +94,12 @@ CellView::CellView(GLContextManager& contextManager, QScrollBar* scrollBar)
 }
 
 void CellView::invalidate()
+{
+  doInvalidate();
+  invalidateLayout();
+}
+
+void CellView::invalidateLayout()
 {
   m_valid = false;
 }
@@ -377,6 +383,7 @@ void CellView::setupGL()
   glAssert(glShadeModel(GL_SMOOTH));
 }
 
+void CellView::doInvalidate() {}
 void CellView::doClear() {}
 void CellView::doLeftClick(Layout& /* layout */, float /* x */, float /* y */) {}
 void CellView::doContextMenu(
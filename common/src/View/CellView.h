@@ -65,6 +65,13 @@ public:
   void clear();
   void resizeEvent(QResizeEvent* event) override;
 
+protected:
+  /**
+   * Invalidates the layout, but keeps any data that a subclass has cached to build it.
+   */
+  void invalidateLayout();
+
+public:
   /**
    * Scroll to a cell. Pass a visitor of type `const Cell& cell -> bool` that returns true
    * for the cell that should be scrolled to.
@@ -120,6 +127,7 @@ private:
 
   virtual void doInitLayout(Layout& layout) = 0;
   virtual void doReloadLayout(Layout& layout) = 0;
+  virtual void doInvalidate();
   virtual void doClear();
   virtual void doRender(Layout& layout, float y, float height) = 0;
   virtual void doLeftClick(Layout& layout, float x, float y);
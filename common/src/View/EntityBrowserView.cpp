@@ -39,6 +39,7 @@
 #include "Renderer/Shaders.h"
 #include "Renderer/TextureFont.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
+#include "Renderer/ThumbnailAtlas.h"
 #include "Renderer/Transformation.h"
 #include "Renderer/VertexArray.h"
 #include "View/MapFrame.h"
@@ -55,6 +56,8 @@
 #include <vecmath/quat.h>
 #include <vecmath/vec.h>
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <string>
 #include <vector>
@@ -76,6 +79,7 @@ EntityBrowserView::EntityBrowserView(
   , m_group{false}
   , m_hideUnused{false}
   , m_sortOrder{Assets::EntityDefinitionSortOrder::Name}
+  , m_thumbnailBrightness{0.0f}
 {
   const auto hRotation = vm::quatf{vm::vec3f::pos_z(), vm::to_radians(-30.0f)};
   const auto vRotation = vm::quatf{vm::vec3f::pos_y(), vm::to_radians(20.0f)};
@@ -84,6 +88,9 @@ EntityBrowserView::EntityBrowserView(
 
 EntityBrowserView::~EntityBrowserView()
 {
+  // Deleting the thumbnail atlas will delete its framebuffer, so we need to be current
+  // see: http://doc.qt.io/qt-5/qopenglwidget.html#resource-initialization-and-cleanup
+  makeCurrent();
   clear();
 }
 
@@ -270,7 +277,15 @@ void EntityBrowserView::addEntityToLayout(
   }
 }
 
-void EntityBrowserView::doClear() {}
+void EntityBrowserView::doInvalidate()
+{
+  clearThumbnails();
+}
+
+void EntityBrowserView::doClear()
+{
+  clearThumbnails();
+}
 
 void EntityBrowserView::doRender(Layout& layout, const float y, const float height)
 {
@@ -287,6 +302,7 @@ void EntityBrowserView::doRender(Layout& layout, const float y, const float heig
 
   renderBounds(layout, y, height);
   renderModels(layout, y, height, transformation);
+  renderThumbnails(layout, y, height, projection);
   renderNames(layout, y, height, projection);
 }
 
@@ -364,6 +380,9 @@ void EntityBrowserView::renderModels(
   shader.set("CameraUp", CameraUp);
   shader.set("ViewMatrix", transformation.viewMatrix());
 
+  updateThumbnails(layout, y, height, shader, transformation);
+
+  // render the models that did not fit into the thumbnail atlas
   for (const auto& group : layout.groups())
   {
     if (group.intersectsY(y, height))
@@ -374,7 +393,8 @@ void EntityBrowserView::renderModels(
         {
           for (const auto& cell : row.cells())
           {
-            if (auto* modelRenderer = cellData(cell).modelRenderer)
+            auto* modelRenderer = cellData(cell).modelRenderer;
+            if (modelRenderer != nullptr && !thumbnail(cell))
             {
               shader.set(
                 "Orientation", static_cast<int>(cellData(cell).modelOrientation));
@@ -393,6 +413,218 @@ void EntityBrowserView::renderModels(
   }
 }
 
+void EntityBrowserView::clearThumbnails()
+{
+  m_thumbnails.clear();
+  m_thumbnailOverflowRange = std::nullopt;
+  if (m_thumbnailAtlas)
+  {
+    m_thumbnailAtlas->clear();
+  }
+}
+
+void EntityBrowserView::updateThumbnails(
+  Layout& layout,
+  const float y,
+  const float height,
+  Renderer::ActiveShader& shader,
+  Renderer::Transformation& transformation)
+{
+  const auto brightness = pref(Preferences::Brightness);
+  if (brightness != m_thumbnailBrightness)
+  {
+    clearThumbnails();
+    m_thumbnailBrightness = brightness;
+  }
+
+  if (!m_thumbnailAtlas)
+  {
+    m_thumbnailAtlas = std::make_unique<Renderer::ThumbnailAtlas>(ThumbnailAtlasSize);
+  }
+
+  // the thumbnails must keep the alpha values of the models so that they can be blended
+  // with the background later
+  glAssert(glDisable(GL_BLEND));
+
+  // if the atlas runs full, discard all thumbnails and try again once so that the atlas
+  // only contains the visible thumbnails; if they still don't fit, keep the atlas as it
+  // is until the visible range changes instead of clearing it on every frame
+  const auto range = std::pair{y, height};
+  if (m_thumbnailOverflowRange && *m_thumbnailOverflowRange != range)
+  {
+    m_thumbnailOverflowRange = std::nullopt;
+  }
+
+  for (size_t attempt = 0u; attempt < 2u; ++attempt)
+  {
+    auto atlasIsFull = false;
+    for (const auto& group : layout.groups())
+    {
+      if (group.intersectsY(y, height))
+      {
+        for (const auto& row : group.rows())
+        {
+          if (row.intersectsY(y, height))
+          {
+            for (const auto& cell : row.cells())
+            {
+              if (cellData(cell).modelRenderer != nullptr)
+              {
+                atlasIsFull |= !updateThumbnail(cell, shader, transformation);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    if (!atlasIsFull || m_thumbnailOverflowRange)
+    {
+      break;
+    }
+    if (attempt > 0u)
+    {
+      m_thumbnailOverflowRange = range;
+      break;
+    }
+    clearThumbnails();
+  }
+
+  glAssert(glEnable(GL_BLEND));
+}
+
+bool EntityBrowserView::updateThumbnail(
+  const Cell& cell,
+  Renderer::ActiveShader& shader,
+  Renderer::Transformation& transformation)
+{
+  if (thumbnail(cell))
+  {
+    return true;
+  }
+
+  const auto [thumbnailWidth, thumbnailHeight] = thumbnailSize(cell);
+  const auto slot = m_thumbnailAtlas->allocate(thumbnailWidth, thumbnailHeight);
+  if (!slot)
+  {
+    return false;
+  }
+
+  const auto& itemBounds = cell.itemBounds();
+  const auto projection = vm::ortho_matrix(
+    -1024.0f, 1024.0f, 0.0f, itemBounds.height, itemBounds.width, 0.0f);
+  const auto view = transformation.viewMatrix();
+  const auto cellTrans = cellTransformation(cell, true);
+
+  m_thumbnailAtlas->render(*slot, [&]() {
+    shader.set("Orientation", static_cast<int>(cellData(cell).modelOrientation));
+    shader.set("ModelMatrix", cellTrans);
+
+    const auto replaceTransformation =
+      Renderer::ReplaceTransformation{transformation, projection, view, cellTrans};
+    cellData(cell).modelRenderer->render();
+  });
+
+  m_thumbnails[cellData(cell).entityDefinition] = *slot;
+  return true;
+}
+
+std::optional<Renderer::ThumbnailAtlas::Slot> EntityBrowserView::thumbnail(
+  const Cell& cell) const
+{
+  const auto it = m_thumbnails.find(cellData(cell).entityDefinition);
+  if (it == m_thumbnails.end())
+  {
+    return std::nullopt;
+  }
+
+  // the thumbnail is stale if the cell was resized since it was rendered
+  const auto& slot = it->second;
+  const auto [thumbnailWidth, thumbnailHeight] = thumbnailSize(cell);
+  if (slot.width != thumbnailWidth || slot.height != thumbnailHeight)
+  {
+    return std::nullopt;
+  }
+
+  return slot;
+}
+
+std::pair<int, int> EntityBrowserView::thumbnailSize(const Cell& cell) const
+{
+  const auto r = devicePixelRatioF();
+  const auto& itemBounds = cell.itemBounds();
+  return {
+    std::max(1, static_cast<int>(std::ceil(itemBounds.width * r))),
+    std::max(1, static_cast<int>(std::ceil(itemBounds.height * r)))};
+}
+
+void EntityBrowserView::renderThumbnails(
+  Layout& layout, const float y, const float height, const vm::mat4x4f& projection)
+{
+  using Vertex = Renderer::GLVertexTypes::P2T2::Vertex;
+  auto vertices = std::vector<Vertex>{};
+
+  for (const auto& group : layout.groups())
+  {
+    if (group.intersectsY(y, height))
+    {
+      for (const auto& row : group.rows())
+      {
+        if (row.intersectsY(y, height))
+        {
+          for (const auto& cell : row.cells())
+          {
+            if (const auto slot = thumbnail(cell))
+            {
+              const auto& bounds = cell.itemBounds();
+              const auto texCoords = m_thumbnailAtlas->texCoords(*slot);
+              const auto top = height - (bounds.top() - y);
+              const auto bottom = height - (bounds.bottom() - y);
+
+              vertices.emplace_back(
+                vm::vec2f{bounds.left(), top},
+                vm::vec2f{texCoords.min.x(), texCoords.max.y()});
+              vertices.emplace_back(vm::vec2f{bounds.left(), bottom}, texCoords.min);
+              vertices.emplace_back(
+                vm::vec2f{bounds.right(), bottom},
+                vm::vec2f{texCoords.max.x(), texCoords.min.y()});
+              vertices.emplace_back(vm::vec2f{bounds.right(), top}, texCoords.max);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  if (vertices.empty())
+  {
+    return;
+  }
+
+  auto transformation = Renderer::Transformation{
+    projection,
+    vm::view_matrix(vm::vec3f::neg_z(), vm::vec3f::pos_y())
+      * vm::translation_matrix(vm::vec3f{0.0f, 0.0f, -1.0f})};
+
+  glAssert(glDisable(GL_DEPTH_TEST));
+  glAssert(glFrontFace(GL_CCW));
+
+  auto vertexArray = Renderer::VertexArray::move(std::move(vertices));
+  auto shader =
+    Renderer::ActiveShader{shaderManager(), Renderer::Shaders::TextureBrowserShader};
+  shader.set("ApplyTinting", false);
+  shader.set("Brightness", 1.0f);
+  shader.set("GrayScale", false);
+  shader.set("Texture", 0);
+
+  vertexArray.prepare(vboManager());
+  m_thumbnailAtlas->activate();
+  vertexArray.render(Renderer::PrimType::Quads);
+  m_thumbnailAtlas->deactivate();
+
+  glAssert(glFrontFace(GL_CW));
+}
+
 void EntityBrowserView::renderNames(
   Layout& layout, const float y, const float height, const vm::mat4x4f& projection)
 {
@@ -531,12 +763,18 @@ EntityBrowserView::StringMap EntityBrowserView::collectStringVertices(
 
 vm::mat4x4f EntityBrowserView::itemTransformation(
   const Cell& cell, const float y, const float height, const bool applyModelScale) const
+{
+  const auto offset =
+    vm::vec3f{0.0f, cell.itemBounds().left(), height - (cell.itemBounds().bottom() - y)};
+  return vm::translation_matrix(offset) * cellTransformation(cell, applyModelScale);
+}
+
+vm::mat4x4f EntityBrowserView::cellTransformation(
+  const Cell& cell, const bool applyModelScale) const
 {
   const auto& cellData = this->cellData(cell);
   const auto* definition = cellData.entityDefinition;
 
-  const auto offset =
-    vm::vec3f{0.0f, cell.itemBounds().left(), height - (cell.itemBounds().bottom() - y)};
   const auto scaling = cell.scale();
   const auto& rotatedBounds = cellData.bounds;
   const auto modelScale = applyModelScale ? cellData.modelScale : vm::vec3f{1, 1, 1};
@@ -546,7 +784,7 @@ vm::mat4x4f EntityBrowserView::itemTransformation(
   const auto boundsCenter = vm::vec3f{definition->bounds().center()};
   const auto scaledBoundsCenter = scalingMatrix * boundsCenter;
 
-  return vm::translation_matrix(offset) * vm::scaling_matrix(vm::vec3f::fill(scaling))
+  return vm::scaling_matrix(vm::vec3f::fill(scaling))
          * vm::translation_matrix(rotationOffset)
          * vm::translation_matrix(scaledBoundsCenter) * vm::rotation_matrix(m_rotation)
          * scalingMatrix * vm::translation_matrix(-boundsCenter);
@@ -23,14 +23,18 @@
 #include "NotifierConnection.h"
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/GLVertexType.h"
+#include "Renderer/ThumbnailAtlas.h"
 #include "View/CellView.h"
 
 #include <vecmath/bbox.h>
 #include <vecmath/forward.h>
 #include <vecmath/quat.h>
 
+#include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom
@@ -49,6 +53,7 @@ class PointEntityDefinition;
 
 namespace Renderer
 {
+class ActiveShader;
 class FontDescriptor;
 class TexturedRenderer;
 class Transformation;
@@ -81,6 +86,7 @@ private:
   static constexpr auto CameraPosition = vm::vec3f{256.0f, 0.0f, 0.0f};
   static constexpr auto CameraDirection = vm::vec3f::neg_x();
   static constexpr auto CameraUp = vm::vec3f::pos_z();
+  static constexpr auto ThumbnailAtlasSize = 2048;
 
   Assets::EntityDefinitionManager& m_entityDefinitionManager;
   Assets::EntityModelManager& m_entityModelManager;
@@ -93,6 +99,23 @@ private:
   Assets::EntityDefinitionSortOrder m_sortOrder;
   std::string m_filterText;
 
+  /**
+   * The model previews are rendered into the atlas once and then drawn as textured quads.
+   * The thumbnails are discarded when the layout is invalidated, which happens whenever
+   * the models or entity definitions change, and when the brightness changes.
+   */
+  std::unique_ptr<Renderer::ThumbnailAtlas> m_thumbnailAtlas;
+  std::unordered_map<const Assets::PointEntityDefinition*, Renderer::ThumbnailAtlas::Slot>
+    m_thumbnails;
+  float m_thumbnailBrightness;
+
+  /**
+   * The visible range (y and height) for which the visible thumbnails did not fit into
+   * the atlas even after clearing it. The atlas is not cleared again until the visible
+   * range changes or the thumbnails are invalidated.
+   */
+  std::optional<std::pair<float, float>> m_thumbnailOverflowRange;
+
   NotifierConnection m_notifierConnection;
 
 public:
@@ -129,6 +152,7 @@ private:
     const Assets::PointEntityDefinition* definition,
     const Renderer::FontDescriptor& font);
 
+  void doInvalidate() override;
   void doClear() override;
   void doRender(Layout& layout, float y, float height) override;
   bool doShouldRenderFocusIndicator() const override;
@@ -140,6 +164,22 @@ private:
   void renderModels(
     Layout& layout, float y, float height, Renderer::Transformation& transformation);
 
+  void clearThumbnails();
+  void updateThumbnails(
+    Layout& layout,
+    float y,
+    float height,
+    Renderer::ActiveShader& shader,
+    Renderer::Transformation& transformation);
+  bool updateThumbnail(
+    const Cell& cell,
+    Renderer::ActiveShader& shader,
+    Renderer::Transformation& transformation);
+  std::optional<Renderer::ThumbnailAtlas::Slot> thumbnail(const Cell& cell) const;
+  std::pair<int, int> thumbnailSize(const Cell& cell) const;
+  void renderThumbnails(
+    Layout& layout, float y, float height, const vm::mat4x4f& projection);
+
   void renderNames(Layout& layout, float y, float height, const vm::mat4x4f& projection);
   void renderGroupTitleBackgrounds(Layout& layout, float y, float height);
   void renderStrings(Layout& layout, float y, float height);
@@ -147,6 +187,7 @@ private:
 
   vm::mat4x4f itemTransformation(
     const Cell& cell, float y, float height, bool applyModelScale) const;
+  vm::mat4x4f cellTransformation(const Cell& cell, bool applyModelScale) const;
 
   QString tooltip(const Cell& cell) override;
 
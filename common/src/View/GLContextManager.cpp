@@ -20,11 +20,14 @@
 #include "GLContextManager.h"
 
 #include "Exceptions.h"
+#include "IO/Path.h"
+#include "IO/SystemPaths.h"
 #include "Renderer/FontManager.h"
 #include "Renderer/GL.h"
 #include "Renderer/Shader.h"
 #include "Renderer/ShaderManager.h"
 #include "Renderer/ShaderProgram.h"
+#include "Renderer/Shaders.h"
 #include "Renderer/Vbo.h"
 
 #include <sstream>
@@ -40,7 +43,8 @@ std::string GLContextManager::GLVersion = "unknown";
 
 GLContextManager::GLContextManager()
   : m_initialized(false)
-  , m_shaderManager(std::make_unique<Renderer::ShaderManager>())
+  , m_shaderManager(std::make_unique<Renderer::ShaderManager>(
+      IO::SystemPaths::userDataDirectory() + IO::Path{"cache/programs"}))
   , m_vboManager(std::make_unique<Renderer::VboManager>(m_shaderManager.get()))
   , m_fontManager(std::make_unique<Renderer::FontManager>())
 {
@@ -75,6 +79,9 @@ bool GLContextManager::initialize()
     GLRenderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
     GLVersion = reinterpret_cast<const char*>(glGetString(GL_VERSION));
 
+    // create all programs now so that the first frame doesn't wait for them
+    m_shaderManager->loadPrograms(Renderer::Shaders::allShaders());
+
     m_initialized = true;
     return true;
   }
@@ -27,6 +27,7 @@
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
 #include <vecmath/polygon.h>
+#include <vecmath/scalar.h>
 #include <vecmath/segment.h>
 
 namespace TrenchBroom
@@ -47,23 +48,42 @@ void Lasso::update(const vm::vec3& point)
   m_cur = point;
 }
 
-bool Lasso::selects(
-  const vm::vec3& point, const vm::plane3& plane, const vm::bbox2& box) const
+vm::vec3 Lasso::selectionPoint(const vm::vec3& point)
 {
-  const auto projected = project(point, plane);
-  return !vm::is_nan(projected) && box.contains(vm::vec2{projected});
+  return point;
 }
 
-bool Lasso::selects(
-  const vm::segment3& edge, const vm::plane3& plane, const vm::bbox2& box) const
+vm::vec3 Lasso::selectionPoint(const vm::segment3& edge)
+{
+  return edge.center();
+}
+
+vm::vec3 Lasso::selectionPoint(const vm::polygon3& polygon)
 {
-  return selects(edge.center(), plane, box);
+  return polygon.center();
+}
+
+bool Lasso::mayContain(const Frustum& frustum, const vm::vec3& point)
+{
+  // The exact test projects the point using single precision pick rays, so points that
+  // are slightly outside of the frustum may still be selected.
+  static constexpr auto Epsilon = FloatType(1.0);
+
+  for (const auto& plane : frustum)
+  {
+    if (plane.point_distance(point) > Epsilon)
+    {
+      return false;
+    }
+  }
+  return true;
 }
 
 bool Lasso::selects(
-  const vm::polygon3& polygon, const vm::plane3& plane, const vm::bbox2& box) const
+  const vm::vec3& point, const vm::plane3& plane, const vm::bbox2& box) const
 {
-  return selects(polygon.center(), plane, box);
+  const auto projected = project(point, plane);
+  return !vm::is_nan(projected) && box.contains(vm::vec2{projected});
 }
 
 vm::vec3 Lasso::project(const vm::vec3& point, const vm::plane3& plane) const
@@ -120,6 +140,45 @@ vm::mat4x4 Lasso::getTransform() const
     m_camera.defaultPoint(static_cast<float>(m_distance)))};
 }
 
+std::optional<Lasso::Frustum> Lasso::getFrustum(
+  const vm::mat4x4& transform, const vm::bbox2& box) const
+{
+  const auto [invertible, inverseTransform] = vm::invert(transform);
+  if (
+    !invertible || vm::is_zero(box.size().x(), vm::C::almost_zero())
+    || vm::is_zero(box.size().y(), vm::C::almost_zero()))
+  {
+    return std::nullopt;
+  }
+
+  const auto corners = std::array<vm::vec3, 4>{
+    inverseTransform * vm::vec3{box.min.x(), box.min.y(), 0.0},
+    inverseTransform * vm::vec3{box.min.x(), box.max.y(), 0.0},
+    inverseTransform * vm::vec3{box.max.x(), box.max.y(), 0.0},
+    inverseTransform * vm::vec3{box.max.x(), box.min.y(), 0.0},
+  };
+  const auto center = inverseTransform * vm::vec3{box.center(), 0.0};
+
+  // Perspective pick rays start at the camera position, orthographic pick rays are
+  // parallel to the camera direction.
+  const auto isPerspective = m_camera.perspectiveProjection();
+  const auto position = vm::vec3{m_camera.position()};
+  const auto direction = vm::vec3{m_camera.direction()};
+
+  auto result = Frustum{};
+  for (size_t i = 0; i < 4; ++i)
+  {
+    const auto& p1 = corners[i];
+    const auto& p2 = corners[(i + 1) % 4];
+    const auto normal = isPerspective
+                          ? vm::normalize(vm::cross(p1 - position, p2 - position))
+                          : vm::normalize(vm::cross(p2 - p1, direction));
+    const auto plane = vm::plane3{p1, normal};
+    result[i] = plane.point_distance(center) > 0.0 ? plane.flip() : plane;
+  }
+  return result;
+}
+
 vm::bbox2 Lasso::getBox(const vm::mat4x4& transform) const
 {
   const auto start = transform * m_start;
@@ -24,6 +24,9 @@
 #include <vecmath/bbox.h>
 #include <vecmath/plane.h>
 
+#include <array>
+#include <optional>
+
 namespace TrenchBroom
 {
 namespace Renderer
@@ -51,11 +54,14 @@ public:
   template <typename I, typename O>
   void selected(I cur, I end, O out) const
   {
+    const auto transform = getTransform();
     const auto plane = getPlane();
-    const auto box = getBox(getTransform());
+    const auto box = getBox(transform);
+    const auto frustum = getFrustum(transform, box);
     while (cur != end)
     {
-      if (selects(*cur, plane, box))
+      const auto point = selectionPoint(*cur);
+      if ((!frustum || mayContain(*frustum, point)) && selects(point, plane, box))
       {
         out = *cur;
       }
@@ -64,12 +70,26 @@ public:
   }
 
 private:
+  /**
+   * The planes bounding the volume that is swept by the lasso rectangle when it is
+   * projected into the scene along the camera's pick rays. The plane normals point out of
+   * the volume.
+   */
+  using Frustum = std::array<vm::plane3, 4>;
+
+  static vm::vec3 selectionPoint(const vm::vec3& point);
+  static vm::vec3 selectionPoint(const vm::segment3& edge);
+  static vm::vec3 selectionPoint(const vm::polygon3& polygon);
+
+  /**
+   * Conservative test whether the given point is selected by the lasso. This is much
+   * cheaper than projecting the point onto the lasso plane and is used to discard most
+   * points before the exact test.
+   */
+  static bool mayContain(const Frustum& frustum, const vm::vec3& point);
+
   bool selects(
     const vm::vec3& point, const vm::plane3& plane, const vm::bbox2& box) const;
-  bool selects(
-    const vm::segment3& edge, const vm::plane3& plane, const vm::bbox2& box) const;
-  bool selects(
-    const vm::polygon3& polygon, const vm::plane3& plane, const vm::bbox2& box) const;
   vm::vec3 project(const vm::vec3& point, const vm::plane3& plane) const;
 
 public:
@@ -80,6 +100,13 @@ private:
   vm::plane3 getPlane() const;
   vm::mat4x4 getTransform() const;
   vm::bbox2 getBox(const vm::mat4x4& transform) const;
+
+  /**
+   * Returns the frustum of the given lasso rectangle, or std::nullopt if the rectangle is
+   * degenerate.
+   */
+  std::optional<Frustum> getFrustum(
+    const vm::mat4x4& transform, const vm::bbox2& box) const;
 };
 } // namespace View
 } // namespace TrenchBroom
@@ -25,6 +25,7 @@
 #include "Assets/EntityDefinitionGroup.h"
 #include "Assets/EntityDefinitionManager.h"
 #include "Assets/EntityModelManager.h"
+#include "Assets/ModelDefinition.h"
 #include "Assets/Texture.h"
 #include "Assets/TextureManager.h"
 #include "EL/ELExceptions.h"
@@ -115,6 +116,7 @@
 #include <kdl/vector_set.h>
 #include <kdl/vector_utils.h>
 
+#include <vecmath/mat.h>
 #include <vecmath/polygon.h>
 #include <vecmath/util.h>
 #include <vecmath/vec.h>
@@ -127,6 +129,7 @@
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -622,6 +625,13 @@ void MapDocument::saveDocumentTo(const IO::Path& path)
   m_game->writeMap(*m_world, path);
 }
 
+void MapDocument::saveDocumentTo(std::ostream& stream)
+{
+  ensure(m_game.get() != nullptr, "game is null");
+  ensure(m_world != nullptr, "world is null");
+  m_game->writeMap(*m_world, stream);
+}
+
 void MapDocument::exportDocumentAs(const IO::ExportOptions& options)
 {
   m_game->exportMap(*m_world, options);
@@ -673,6 +683,61 @@ std::string MapDocument::serializeSelectedBrushFaces()
   return stream.str();
 }
 
+/**
+ * Returns whether, for UI reasons, duplicating the given node should also cause its
+ * parent to be duplicated.
+ *
+ * Applies when duplicating a brush inside a brush entity.
+ */
+static bool shouldCloneParentWhenCloningNode(const Model::Node* node)
+{
+  return node->parent()->accept(kdl::overload(
+    [](const Model::WorldNode*) { return false; },
+    [](const Model::LayerNode*) { return false; },
+    [](const Model::GroupNode*) { return false; },
+    [&](const Model::EntityNode*) { return true; },
+    [](const Model::BrushNode*) { return false; },
+    [](const Model::PatchNode*) { return false; }));
+}
+
+std::vector<Model::Node*> MapDocument::cloneSelectedNodes() const
+{
+  auto result = std::vector<Model::Node*>{};
+  auto parentClones = std::unordered_map<Model::Node*, Model::Node*>{};
+
+  for (auto* original : m_selectedNodes.nodes())
+  {
+    auto* clone = original->cloneRecursively(m_worldBounds);
+
+    // visibility and lock states are not serialized, so they should not be copied either
+    clone->accept([](auto&& thisLambda, Model::Node* node) {
+      node->setVisibilityState(Model::VisibilityState::Inherited);
+      node->setLockState(Model::LockState::Inherited);
+      node->visitChildren(thisLambda);
+    });
+
+    if (shouldCloneParentWhenCloningNode(original))
+    {
+      auto* parent = original->parent();
+      auto [it, inserted] = parentClones.emplace(parent, nullptr);
+      if (inserted)
+      {
+        it->second = parent->clone(m_worldBounds);
+        it->second->setVisibilityState(Model::VisibilityState::Inherited);
+        it->second->setLockState(Model::LockState::Inherited);
+        result.push_back(it->second);
+      }
+      it->second->addChild(clone);
+    }
+    else
+    {
+      result.push_back(clone);
+    }
+  }
+
+  return result;
+}
+
 template <typename O>
 static void getLinkedGroupIdsRecursively(const std::vector<Model::Node*>& nodes, O out)
 {
@@ -737,6 +802,46 @@ PasteType MapDocument::paste(const std::string& str)
   return PasteType::Failed;
 }
 
+PasteType MapDocument::pasteClonedNodes(const std::vector<Model::Node*>& nodes)
+{
+  // Like the map reader, unlink groups whose linked group ID occurs neither in this
+  // document nor in any other pasted group
+  auto linkedGroupIds = getLinkedGroupIdsRecursively({m_world.get()});
+  getLinkedGroupIdsRecursively(nodes, std::back_inserter(linkedGroupIds));
+
+  auto linkedGroupCounts = std::unordered_map<std::string, size_t>{};
+  for (const auto& linkedGroupId : linkedGroupIds)
+  {
+    ++linkedGroupCounts[linkedGroupId];
+  }
+
+  Model::Node::visitAll(
+    nodes,
+    kdl::overload(
+      [](Model::WorldNode*) {},
+      [](Model::LayerNode*) {},
+      [&](auto&& thisLambda, Model::GroupNode* groupNode) {
+        if (const auto& linkedGroupId = groupNode->group().linkedGroupId())
+        {
+          if (linkedGroupCounts[*linkedGroupId] == 1u)
+          {
+            warn() << "Unlinking orphaned linked group with ID '" << *linkedGroupId
+                   << "'";
+            auto group = groupNode->group();
+            group.resetLinkedGroupId();
+            group.setTransformation(vm::mat4x4::identity());
+            groupNode->setGroup(std::move(group));
+          }
+        }
+        groupNode->visitChildren(thisLambda);
+      },
+      [](Model::EntityNode*) {},
+      [](Model::BrushNode*) {},
+      [](Model::PatchNode*) {}));
+
+  return pasteNodes(nodes) ? PasteType::Node : PasteType::Failed;
+}
+
 static std::vector<Model::IdType> allPersistentGroupIds(const Model::Node& root)
 {
   auto result = std::vector<Model::IdType>{};
@@ -1067,14 +1172,14 @@ std::vector<Model::EntityNodeBase*> MapDocument::allSelectedEntityNodes() const
   return kdl::vec_sort_and_remove_duplicates(std::move(nodes));
 }
 
-std::vector<Model::BrushNode*> MapDocument::allSelectedBrushNodes() const
+static void collectBrushNodes(
+  const std::vector<Model::Node*>& nodes, std::vector<Model::BrushNode*>& brushes)
 {
-  auto brushes = std::vector<Model::BrushNode*>{};
-  for (auto* node : m_selectedNodes.nodes())
+  for (auto* node : nodes)
   {
     node->accept(kdl::overload(
-      [](
-        auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
+      // the world node is never part of the selected node collection
+      [](Model::WorldNode*) {},
       [](
         auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
       [](
@@ -1085,11 +1190,26 @@ std::vector<Model::BrushNode*> MapDocument::allSelectedBrushNodes() const
       [&](Model::BrushNode* brush) { brushes.push_back(brush); },
       [&](Model::PatchNode*) {}));
   }
-  return brushes;
+}
+
+const std::vector<Model::BrushNode*>& MapDocument::allSelectedBrushNodes() const
+{
+  if (!m_allSelectedBrushNodes)
+  {
+    auto brushes = std::vector<Model::BrushNode*>{};
+    collectBrushNodes(m_selectedNodes.nodes(), brushes);
+    m_allSelectedBrushNodes = std::move(brushes);
+  }
+  return *m_allSelectedBrushNodes;
 }
 
 bool MapDocument::hasAnySelectedBrushNodes() const
 {
+  if (m_allSelectedBrushNodes)
+  {
+    return !m_allSelectedBrushNodes->empty();
+  }
+
   // This is just an optimization of `!allSelectedBrushNodes().empty()`
   // that stops after finding the first brush
   const auto visitChildrenAndExitEarly = [](auto&& thisLambda, const auto* node) {
@@ -1144,7 +1264,7 @@ std::vector<Model::BrushFaceHandle> MapDocument::allSelectedBrushFaces() const
     .facesToSelect;
 }
 
-std::vector<Model::BrushFaceHandle> MapDocument::selectedBrushFaces() const
+const std::vector<Model::BrushFaceHandle>& MapDocument::selectedBrushFaces() const
 {
   return m_selectedBrushFaces;
 }
@@ -1482,9 +1602,31 @@ void MapDocument::updateLastSelectionBounds()
   }
 }
 
-void MapDocument::invalidateSelectionBounds()
+void MapDocument::addToSelectionCaches(
+  const std::vector<Model::Node*>& selectedNodes, const bool hadSelectedNodes)
+{
+  if (!hadSelectedNodes)
+  {
+    m_selectionBounds = computeLogicalBounds(selectedNodes);
+    m_selectionBoundsValid = true;
+    m_allSelectedBrushNodes = std::vector<Model::BrushNode*>{};
+  }
+  else if (m_selectionBoundsValid)
+  {
+    m_selectionBounds = vm::merge(
+      m_selectionBounds, computeLogicalBounds(selectedNodes, m_selectionBounds));
+  }
+
+  if (m_allSelectedBrushNodes)
+  {
+    collectBrushNodes(selectedNodes, *m_allSelectedBrushNodes);
+  }
+}
+
+void MapDocument::invalidateSelectionCaches()
 {
   m_selectionBoundsValid = false;
+  m_allSelectedBrushNodes = std::nullopt;
 }
 
 void MapDocument::validateSelectionBounds() const
@@ -1497,6 +1639,7 @@ void MapDocument::clearSelection()
 {
   m_selectedNodes.clear();
   m_selectedBrushFaces.clear();
+  invalidateSelectionCaches();
 }
 
 /**
@@ -1752,23 +1895,6 @@ void MapDocument::deleteObjects()
   assertResult(transaction.commit());
 }
 
-/**
- * Returns whether, for UI reasons, duplicating the given node should also cause its
- * parent to be duplicated.
- *
- * Applies when duplicating a brush inside a brush entity.
- */
-static bool shouldCloneParentWhenCloningNode(const Model::Node* node)
-{
-  return node->parent()->accept(kdl::overload(
-    [](const Model::WorldNode*) { return false; },
-    [](const Model::LayerNode*) { return false; },
-    [](const Model::GroupNode*) { return false; },
-    [&](const Model::EntityNode*) { return true; },
-    [](const Model::BrushNode*) { return false; },
-    [](const Model::PatchNode*) { return false; }));
-}
-
 void MapDocument::duplicateObjects()
 {
   auto nodesToAdd = std::map<Model::Node*, std::vector<Model::Node*>>{};
@@ -3151,13 +3277,19 @@ bool MapDocument::csgSubtract()
   auto toRemove =
     std::vector<Model::Node*>{std::begin(subtrahendNodes), std::end(subtrahendNodes)};
 
-  for (auto* minuendNode : minuendNodes)
+  // the minuends are independent of each other, so they can be processed in parallel
+  const auto mapFormat = m_world->mapFormat();
+  const auto& textureName = currentTextureName();
+  auto subtractionResults =
+    kdl::vec_parallel_transform(minuendNodes, [&](const Model::BrushNode* minuendNode) {
+      return minuendNode->brush().subtract(mapFormat, m_worldBounds, textureName, subtrahends);
+    });
+
+  for (size_t i = 0; i < minuendNodes.size(); ++i)
   {
-    const auto& minuend = minuendNode->brush();
-    auto currentSubtractionResults = minuend.subtract(
-      m_world->mapFormat(), m_worldBounds, currentTextureName(), subtrahends);
+    auto* minuendNode = minuendNodes[i];
     auto currentBrushes = kdl::collect_values(
-      std::move(currentSubtractionResults),
+      std::move(subtractionResults[i]),
       [&](const Model::BrushError& e) { error() << "Could not create brush: " << e; });
 
     if (!currentBrushes.empty())
@@ -3236,33 +3368,47 @@ bool MapDocument::csgHollow()
     return false;
   }
 
-  bool didHollowAnything = false;
-  auto fragmentsAndSourceNodes =
-    kdl::vec_transform(brushNodes, [&](Model::BrushNode* brushNode) {
+  // the brushes are independent of each other, so they can be hollowed in parallel
+  const auto mapFormat = m_world->mapFormat();
+  const auto& textureName = currentTextureName();
+  const auto delta = -1.0 * static_cast<FloatType>(m_grid->actualSize());
+  auto hollowResults =
+    kdl::vec_parallel_transform(brushNodes, [&](const Model::BrushNode* brushNode) {
       const auto& originalBrush = brushNode->brush();
 
       auto shrunkenBrush = originalBrush;
-      auto fragments = std::vector<Model::Brush>{};
-      shrunkenBrush
-        .expand(m_worldBounds, -1.0 * static_cast<FloatType>(m_grid->actualSize()), true)
-        .transform([&]() {
-          didHollowAnything = true;
-
-          auto subtractionResults = originalBrush.subtract(
-            m_world->mapFormat(), m_worldBounds, currentTextureName(), shrunkenBrush);
-          fragments = kdl::collect_values(
-            std::move(subtractionResults), [&](const Model::BrushError& e) {
-              error() << "Could not create brush: " << e;
-            });
-        })
-        .or_else([&](const Model::BrushError& e) {
-          error() << "Could not hollow brush: " << e;
-          fragments = {originalBrush};
-        });
-
-      return std::make_pair(brushNode, std::move(fragments));
+      return shrunkenBrush.expand(m_worldBounds, delta, true).transform([&]() {
+        return originalBrush.subtract(
+          mapFormat, m_worldBounds, textureName, shrunkenBrush);
+      });
     });
 
+  bool didHollowAnything = false;
+  auto fragmentsAndSourceNodes =
+    std::vector<std::pair<Model::BrushNode*, std::vector<Model::Brush>>>{};
+  fragmentsAndSourceNodes.reserve(brushNodes.size());
+
+  for (size_t i = 0; i < brushNodes.size(); ++i)
+  {
+    auto* brushNode = brushNodes[i];
+
+    auto fragments = std::vector<Model::Brush>{};
+    std::move(hollowResults[i])
+      .transform([&](auto&& subtractionResults) {
+        didHollowAnything = true;
+        fragments = kdl::collect_values(
+          std::move(subtractionResults), [&](const Model::BrushError& e) {
+            error() << "Could not create brush: " << e;
+          });
+      })
+      .or_else([&](const Model::BrushError& e) {
+        error() << "Could not hollow brush: " << e;
+        fragments = {brushNode->brush()};
+      });
+
+    fragmentsAndSourceNodes.emplace_back(brushNode, std::move(fragments));
+  }
+
   if (!didHollowAnything)
   {
     return false;
@@ -3822,57 +3968,146 @@ bool MapDocument::snapVertices(const FloatType snapTo)
   return true;
 }
 
+namespace
+{
+/**
+ * Signals that the handles of a brush cannot be moved, e.g. because the brush would
+ * become invalid. This happens routinely while dragging handles and is not reported.
+ */
+struct CannotMoveHandlesError
+{
+};
+
+/**
+ * Applies the given lambda to a copy of each brush among the given nodes and returns a
+ * vector of pairs of the original node and the modified contents together with the new
+ * handle positions returned by the lambda. The contents of all other nodes are copied
+ * unchanged.
+ *
+ * The lambda is applied in parallel and must therefore not touch any shared state. It
+ * must have the following signature:
+ * - kdl::result<std::vector<P>, Model::BrushError, CannotMoveHandlesError>
+ *     operator()(Model::Brush&);
+ *
+ * Brush errors are logged with the given message. If the lambda fails for any brush,
+ * an empty optional is returned.
+ */
+template <typename P, typename L>
+std::optional<
+  std::tuple<std::vector<std::pair<Model::Node*, Model::NodeContents>>, std::vector<P>>>
+moveHandles(
+  Logger& logger,
+  const std::vector<Model::Node*>& nodes,
+  const std::string& errorMessage,
+  const L& lambda)
+{
+  using MovedNode = std::tuple<Model::Node*, Model::NodeContents, std::vector<P>>;
+  using MoveResult = kdl::result<MovedNode, Model::BrushError, CannotMoveHandlesError>;
+
+  const auto copyContents = [](Model::Node* node, auto contents) -> MoveResult {
+    return MovedNode{node, Model::NodeContents{std::move(contents)}, {}};
+  };
+
+  auto moveResults = kdl::vec_parallel_transform(nodes, [&](Model::Node* node) {
+    return node->accept(kdl::overload(
+      [&](Model::WorldNode* worldNode) {
+        return copyContents(worldNode, worldNode->entity());
+      },
+      [&](Model::LayerNode* layerNode) {
+        return copyContents(layerNode, layerNode->layer());
+      },
+      [&](Model::GroupNode* groupNode) {
+        return copyContents(groupNode, groupNode->group());
+      },
+      [&](Model::EntityNode* entityNode) {
+        return copyContents(entityNode, entityNode->entity());
+      },
+      [&](Model::BrushNode* brushNode) -> MoveResult {
+        auto brush = brushNode->brush();
+        return lambda(brush).transform([&](std::vector<P>&& newPositions) {
+          return MovedNode{
+            brushNode, Model::NodeContents{std::move(brush)}, std::move(newPositions)};
+        });
+      },
+      [&](Model::PatchNode* patchNode) {
+        return copyContents(patchNode, patchNode->patch());
+      }));
+  });
+
+  auto newNodes = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
+  newNodes.reserve(nodes.size());
+  auto newPositions = std::vector<P>{};
+
+  auto success = true;
+  for (auto& moveResult : moveResults)
+  {
+    std::move(moveResult)
+      .visit(kdl::overload(
+        [&](MovedNode&& movedNode) {
+          auto& [node, contents, positions] = movedNode;
+          newNodes.emplace_back(node, std::move(contents));
+          newPositions = kdl::vec_concat(std::move(newPositions), std::move(positions));
+        },
+        [&](const Model::BrushError e) {
+          logger.error() << errorMessage << ": " << e;
+          success = false;
+        },
+        [&](const CannotMoveHandlesError&) { success = false; }));
+  }
+
+  if (!success)
+  {
+    return std::nullopt;
+  }
+
+  return std::make_tuple(
+    std::move(newNodes), kdl::vec_sort_and_remove_duplicates(std::move(newPositions)));
+}
+} // namespace
+
 MapDocument::MoveVerticesResult MapDocument::moveVertices(
   std::vector<vm::vec3> vertexPositions, const vm::vec3& delta)
 {
-  auto newVertexPositions = std::vector<vm::vec3>{};
-  auto newNodes = applyToNodeContents(
+  using MoveResult =
+    kdl::result<std::vector<vm::vec3>, Model::BrushError, CannotMoveHandlesError>;
+
+  const auto uvLock = pref(Preferences::UVLock);
+  auto moveResult = moveHandles<vm::vec3>(
+    *this,
     m_selectedNodes.nodes(),
-    kdl::overload(
-      [](Model::Layer&) { return true; },
-      [](Model::Group&) { return true; },
-      [](Model::Entity&) { return true; },
-      [&](Model::Brush& brush) {
-        const auto verticesToMove = kdl::vec_filter(
-          vertexPositions, [&](const auto& vertex) { return brush.hasVertex(vertex); });
-        if (verticesToMove.empty())
-        {
-          return true;
-        }
+    "Could not move brush vertices",
+    [&](Model::Brush& brush) -> MoveResult {
+      const auto verticesToMove = kdl::vec_filter(
+        vertexPositions, [&](const auto& vertex) { return brush.hasVertex(vertex); });
+      if (verticesToMove.empty())
+      {
+        return std::vector<vm::vec3>{};
+      }
 
-        if (!brush.canMoveVertices(m_worldBounds, verticesToMove, delta))
-        {
-          return false;
-        }
+      if (!brush.canMoveVertices(m_worldBounds, verticesToMove, delta))
+      {
+        return CannotMoveHandlesError{};
+      }
 
-        return brush
-          .moveVertices(m_worldBounds, verticesToMove, delta, pref(Preferences::UVLock))
-          .transform([&]() {
-            auto newPositions = brush.findClosestVertexPositions(verticesToMove + delta);
-            newVertexPositions =
-              kdl::vec_concat(std::move(newVertexPositions), std::move(newPositions));
-          })
-          .if_error([&](const Model::BrushError e) {
-            error() << "Could not move brush vertices: " << e;
-          })
-          .is_success();
-      },
-      [](Model::BezierPatch&) { return true; }));
+      return brush.moveVertices(m_worldBounds, verticesToMove, delta, uvLock)
+        .transform(
+          [&]() { return brush.findClosestVertexPositions(verticesToMove + delta); });
+    });
 
-  if (newNodes)
+  if (moveResult)
   {
-    kdl::vec_sort_and_remove_duplicates(newVertexPositions);
+    auto& [newNodes, newVertexPositions] = *moveResult;
 
     const auto commandName =
       kdl::str_plural(vertexPositions.size(), "Move Brush Vertex", "Move Brush Vertices");
     auto transaction = Transaction{*this, commandName};
 
     const auto changedLinkedGroups = findContainingLinkedGroups(
-      *m_world, kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; }));
+      *m_world, kdl::vec_transform(newNodes, [](const auto& p) { return p.first; }));
 
     const auto result = executeAndStore(std::make_unique<BrushVertexCommand>(
       commandName,
-      std::move(*newNodes),
+      std::move(newNodes),
       std::move(vertexPositions),
       std::move(newVertexPositions)));
 
@@ -3905,55 +4140,47 @@ MapDocument::MoveVerticesResult MapDocument::moveVertices(
 bool MapDocument::moveEdges(
   std::vector<vm::segment3> edgePositions, const vm::vec3& delta)
 {
-  auto newEdgePositions = std::vector<vm::segment3>{};
-  auto newNodes = applyToNodeContents(
+  using MoveResult =
+    kdl::result<std::vector<vm::segment3>, Model::BrushError, CannotMoveHandlesError>;
+
+  const auto uvLock = pref(Preferences::UVLock);
+  auto moveResult = moveHandles<vm::segment3>(
+    *this,
     m_selectedNodes.nodes(),
-    kdl::overload(
-      [](Model::Layer&) { return true; },
-      [](Model::Group&) { return true; },
-      [](Model::Entity&) { return true; },
-      [&](Model::Brush& brush) {
-        const auto edgesToMove = kdl::vec_filter(
-          edgePositions, [&](const auto& edge) { return brush.hasEdge(edge); });
-        if (edgesToMove.empty())
-        {
-          return true;
-        }
+    "Could not move brush edges",
+    [&](Model::Brush& brush) -> MoveResult {
+      const auto edgesToMove = kdl::vec_filter(
+        edgePositions, [&](const auto& edge) { return brush.hasEdge(edge); });
+      if (edgesToMove.empty())
+      {
+        return std::vector<vm::segment3>{};
+      }
 
-        if (!brush.canMoveEdges(m_worldBounds, edgesToMove, delta))
-        {
-          return false;
-        }
+      if (!brush.canMoveEdges(m_worldBounds, edgesToMove, delta))
+      {
+        return CannotMoveHandlesError{};
+      }
 
-        return brush
-          .moveEdges(m_worldBounds, edgesToMove, delta, pref(Preferences::UVLock))
-          .transform([&]() {
-            auto newPositions = brush.findClosestEdgePositions(kdl::vec_transform(
-              edgesToMove, [&](const auto& edge) { return edge.translate(delta); }));
-            newEdgePositions =
-              kdl::vec_concat(std::move(newEdgePositions), std::move(newPositions));
-          })
-          .if_error([&](const Model::BrushError e) {
-            error() << "Could not move brush edges: " << e;
-          })
-          .is_success();
-      },
-      [](Model::BezierPatch&) { return true; }));
+      return brush.moveEdges(m_worldBounds, edgesToMove, delta, uvLock).transform([&]() {
+        return brush.findClosestEdgePositions(kdl::vec_transform(
+          edgesToMove, [&](const auto& edge) { return edge.translate(delta); }));
+      });
+    });
 
-  if (newNodes)
+  if (moveResult)
   {
-    kdl::vec_sort_and_remove_duplicates(newEdgePositions);
+    auto& [newNodes, newEdgePositions] = *moveResult;
 
     const auto commandName =
       kdl::str_plural(edgePositions.size(), "Move Brush Edge", "Move Brush Edges");
     auto transaction = Transaction{*this, commandName};
 
     const auto changedLinkedGroups = findContainingLinkedGroups(
-      *m_world, kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; }));
+      *m_world, kdl::vec_transform(newNodes, [](const auto& p) { return p.first; }));
 
     const auto result = executeAndStore(std::make_unique<BrushEdgeCommand>(
       commandName,
-      std::move(*newNodes),
+      std::move(newNodes),
       std::move(edgePositions),
       std::move(newEdgePositions)));
 
@@ -3973,55 +4200,47 @@ bool MapDocument::moveEdges(
 bool MapDocument::moveFaces(
   std::vector<vm::polygon3> facePositions, const vm::vec3& delta)
 {
-  auto newFacePositions = std::vector<vm::polygon3>{};
-  auto newNodes = applyToNodeContents(
+  using MoveResult =
+    kdl::result<std::vector<vm::polygon3>, Model::BrushError, CannotMoveHandlesError>;
+
+  const auto uvLock = pref(Preferences::UVLock);
+  auto moveResult = moveHandles<vm::polygon3>(
+    *this,
     m_selectedNodes.nodes(),
-    kdl::overload(
-      [](Model::Layer&) { return true; },
-      [](Model::Group&) { return true; },
-      [](Model::Entity&) { return true; },
-      [&](Model::Brush& brush) {
-        const auto facesToMove = kdl::vec_filter(
-          facePositions, [&](const auto& face) { return brush.hasFace(face); });
-        if (facesToMove.empty())
-        {
-          return true;
-        }
+    "Could not move brush faces",
+    [&](Model::Brush& brush) -> MoveResult {
+      const auto facesToMove = kdl::vec_filter(
+        facePositions, [&](const auto& face) { return brush.hasFace(face); });
+      if (facesToMove.empty())
+      {
+        return std::vector<vm::polygon3>{};
+      }
 
-        if (!brush.canMoveFaces(m_worldBounds, facesToMove, delta))
-        {
-          return false;
-        }
+      if (!brush.canMoveFaces(m_worldBounds, facesToMove, delta))
+      {
+        return CannotMoveHandlesError{};
+      }
 
-        return brush
-          .moveFaces(m_worldBounds, facesToMove, delta, pref(Preferences::UVLock))
-          .transform([&]() {
-            auto newPositions = brush.findClosestFacePositions(kdl::vec_transform(
-              facesToMove, [&](const auto& face) { return face.translate(delta); }));
-            newFacePositions =
-              kdl::vec_concat(std::move(newFacePositions), std::move(newPositions));
-          })
-          .if_error([&](const Model::BrushError e) {
-            error() << "Could not move brush faces: " << e;
-          })
-          .is_success();
-      },
-      [](Model::BezierPatch&) { return true; }));
+      return brush.moveFaces(m_worldBounds, facesToMove, delta, uvLock).transform([&]() {
+        return brush.findClosestFacePositions(kdl::vec_transform(
+          facesToMove, [&](const auto& face) { return face.translate(delta); }));
+      });
+    });
 
-  if (newNodes)
+  if (moveResult)
   {
-    kdl::vec_sort_and_remove_duplicates(newFacePositions);
+    auto& [newNodes, newFacePositions] = *moveResult;
 
     const auto commandName =
       kdl::str_plural(facePositions.size(), "Move Brush Face", "Move Brush Faces");
     auto transaction = Transaction{*this, commandName};
 
     auto changedLinkedGroups = findContainingLinkedGroups(
-      *m_world, kdl::vec_transform(*newNodes, [](const auto& p) { return p.first; }));
+      *m_world, kdl::vec_transform(newNodes, [](const auto& p) { return p.first; }));
 
     const auto result = executeAndStore(std::make_unique<BrushFaceCommand>(
       commandName,
-      std::move(*newNodes),
+      std::move(newNodes),
       std::move(facePositions),
       std::move(newFacePositions)));
 
@@ -4678,7 +4897,9 @@ void MapDocument::clearEntityModels()
 }
 
 static auto makeSetEntityModelsVisitor(
-  Logger& logger, Assets::EntityModelManager& manager)
+  Logger& logger,
+  Assets::EntityModelManager& manager,
+  Assets::ModelSpecificationCache& modelSpecificationCache)
 {
   return kdl::overload(
     [](auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
@@ -4687,7 +4908,7 @@ static auto makeSetEntityModelsVisitor(
     [&](Model::EntityNode* entityNode) {
       const auto modelSpec = Assets::safeGetModelSpecification(
         logger, entityNode->entity().classname(), [&]() {
-          return entityNode->entity().modelSpecification();
+          return entityNode->entity().modelSpecification(modelSpecificationCache);
         });
       const auto* frame = manager.frame(modelSpec);
       entityNode->setModelFrame(frame);
@@ -4709,12 +4930,17 @@ static auto makeUnsetEntityModelsVisitor()
 
 void MapDocument::setEntityModels()
 {
-  m_world->accept(makeSetEntityModelsVisitor(*this, *m_entityModelManager));
+  auto modelSpecificationCache = Assets::ModelSpecificationCache{};
+  m_world->accept(
+    makeSetEntityModelsVisitor(*this, *m_entityModelManager, modelSpecificationCache));
 }
 
 void MapDocument::setEntityModels(const std::vector<Model::Node*>& nodes)
 {
-  Model::Node::visitAll(nodes, makeSetEntityModelsVisitor(*this, *m_entityModelManager));
+  auto modelSpecificationCache = Assets::ModelSpecificationCache{};
+  Model::Node::visitAll(
+    nodes,
+    makeSetEntityModelsVisitor(*this, *m_entityModelManager, modelSpecificationCache));
 }
 
 void MapDocument::unsetEntityModels()
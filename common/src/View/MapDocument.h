@@ -34,6 +34,7 @@
 #include <vecmath/forward.h>
 #include <vecmath/util.h>
 
+#include <iosfwd>
 #include <map>
 #include <memory>
 #include <optional>
@@ -135,6 +136,7 @@ protected:
   vm::bbox3 m_lastSelectionBounds;
   mutable vm::bbox3 m_selectionBounds;
   mutable bool m_selectionBoundsValid;
+  mutable std::optional<std::vector<Model::BrushNode*>> m_allSelectedBrushNodes;
 
   ViewEffectsService* m_viewEffectsService;
 
@@ -299,6 +301,7 @@ public: // new, load, save document
   void saveDocument();
   void saveDocumentAs(const IO::Path& path);
   void saveDocumentTo(const IO::Path& path);
+  void saveDocumentTo(std::ostream& stream);
   void exportDocumentAs(const IO::ExportOptions& options);
 
 private:
@@ -312,8 +315,23 @@ public: // copy and paste
   std::string serializeSelectedNodes();
   std::string serializeSelectedBrushFaces();
 
+  /**
+   * Returns clones of the selected nodes that have the same structure as the result of
+   * serializing the selected nodes and parsing them again. In particular, selected brushes
+   * and patches of an entity are added to a clone of that entity.
+   *
+   * The caller takes ownership of the returned nodes.
+   */
+  std::vector<Model::Node*> cloneSelectedNodes() const;
+
   PasteType paste(const std::string& str);
 
+  /**
+   * Pastes nodes that were returned by cloneSelectedNodes. This document takes ownership
+   * of the given nodes.
+   */
+  PasteType pasteClonedNodes(const std::vector<Model::Node*>& nodes);
+
 private:
   bool pasteNodes(const std::vector<Model::Node*>& nodes);
   bool pasteBrushFaces(const std::vector<Model::BrushFace>& faces);
@@ -359,7 +377,7 @@ public: // selection
    * If multiple linked groups are selected, returns brushes from all of them, so
    * attempting to perform commands on all of them will be blocked as a conflict.
    */
-  std::vector<Model::BrushNode*> allSelectedBrushNodes() const;
+  const std::vector<Model::BrushNode*>& allSelectedBrushNodes() const;
   bool hasAnySelectedBrushNodes() const;
   const Model::NodeCollection& selectedNodes() const override;
 
@@ -377,7 +395,7 @@ public: // selection
    * linked groups in a link set and applying textures.)
    */
   std::vector<Model::BrushFaceHandle> allSelectedBrushFaces() const override;
-  std::vector<Model::BrushFaceHandle> selectedBrushFaces() const override;
+  const std::vector<Model::BrushFaceHandle>& selectedBrushFaces() const override;
 
   const vm::bbox3& referenceBounds() const override;
   const vm::bbox3& lastSelectionBounds() const override;
@@ -403,7 +421,15 @@ public: // selection
 
 protected:
   void updateLastSelectionBounds();
-  void invalidateSelectionBounds();
+
+  /**
+   * Updates the cached selection bounds and selected brush nodes after the given nodes
+   * were added to the selection. Valid caches are extended by the given nodes, so that
+   * selecting nodes does not require visiting the entire selection again.
+   */
+  void addToSelectionCaches(
+    const std::vector<Model::Node*>& selectedNodes, bool hadSelectedNodes);
+  void invalidateSelectionCaches();
 
 private:
   void validateSelectionBounds() const;
@@ -101,13 +101,14 @@ void MapDocumentCommandFacade::performSelect(const std::vector<Model::Node*>& no
     }
   }
 
+  const auto hadSelectedNodes = hasSelectedNodes();
   m_selectedNodes.addNodes(selected);
+  addToSelectionCaches(selected, hadSelectedNodes);
 
   Selection selection;
   selection.addSelectedNodes(selected);
 
   selectionDidChangeNotifier(selection);
-  invalidateSelectionBounds();
 }
 
 void MapDocumentCommandFacade::performSelect(
@@ -189,12 +190,12 @@ void MapDocumentCommandFacade::performDeselect(const std::vector<Model::Node*>&
   }
 
   m_selectedNodes.removeNodes(deselected);
+  invalidateSelectionCaches();
 
   Selection selection;
   selection.addDeselectedNodes(deselected);
 
   selectionDidChangeNotifier(selection);
-  invalidateSelectionBounds();
 }
 
 void MapDocumentCommandFacade::performDeselect(
@@ -220,7 +221,10 @@ void MapDocumentCommandFacade::performDeselect(
     }
   }
 
-  m_selectedBrushFaces = kdl::vec_erase_all(std::move(m_selectedBrushFaces), deselected);
+  // the deselected faces are no longer marked as selected
+  m_selectedBrushFaces = kdl::vec_erase_if(
+    std::move(m_selectedBrushFaces),
+    [](const auto& handle) { return !handle.face().selected(); });
 
   Selection selection;
   selection.addDeselectedBrushFaces(deselected);
@@ -279,7 +283,7 @@ void MapDocumentCommandFacade::performAddNodes(
   setEntityDefinitions(addedNodes);
   setEntityModels(addedNodes);
   setTextures(addedNodes);
-  invalidateSelectionBounds();
+  invalidateSelectionCaches();
 
   nodesWereAddedNotifier(addedNodes);
 }
@@ -303,7 +307,7 @@ void MapDocumentCommandFacade::performRemoveNodes(
     parent->removeChildren(std::begin(children), std::end(children));
   }
 
-  invalidateSelectionBounds();
+  invalidateSelectionCaches();
 }
 
 static std::vector<Model::Node*> collectOldChildren(
@@ -358,7 +362,7 @@ MapDocumentCommandFacade::performReplaceChildren(
   setEntityModels(allNewChildren);
   setTextures(allNewChildren);
 
-  invalidateSelectionBounds();
+  invalidateSelectionCaches();
 
   nodesWereAddedNotifier(allNewChildren);
 
@@ -469,7 +473,7 @@ void MapDocumentCommandFacade::performSwapNodeContents(
     setTextures(nodes);
   }
 
-  invalidateSelectionBounds();
+  invalidateSelectionCaches();
 }
 
 std::map<Model::Node*, Model::VisibilityState> MapDocumentCommandFacade::
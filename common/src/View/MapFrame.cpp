@@ -62,6 +62,7 @@
 #include "View/MapDocument.h"
 #include "View/MapViewBase.h"
 #include "View/MapViewToolBox.h"
+#include "View/NodeClipboardData.h"
 #include "View/ObjExportDialog.h"
 #include "View/PasteType.h"
 #include "View/QtUtils.h"
@@ -196,8 +197,11 @@ MapFrame::~MapFrame()
   qDeleteAll(std::rbegin(children), std::rend(children));
 
   // let's trigger a final autosave before releasing the document
+  // triggerAutosave does nothing while a backup is being written, so wait for it first
   NullLogger logger;
+  m_autosaver->waitForPendingBackup(logger);
   m_autosaver->triggerAutosave(logger);
+  m_autosaver->waitForPendingBackup(logger);
 
   m_document->setViewEffectsService(nullptr);
   m_document.reset();
@@ -781,7 +785,7 @@ void MapFrame::connectObservers()
   m_notifierConnection +=
     m_document->documentWasNewedNotifier.connect(this, &MapFrame::documentDidChange);
   m_notifierConnection +=
-    m_document->documentWasLoadedNotifier.connect(this, &MapFrame::documentDidChange);
+    m_document->documentWasLoadedNotifier.connect(this, &MapFrame::documentWasLoaded);
   m_notifierConnection +=
     m_document->documentWasSavedNotifier.connect(this, &MapFrame::documentDidChange);
   m_notifierConnection += m_document->documentModificationStateDidChangeNotifier.connect(
@@ -839,6 +843,15 @@ void MapFrame::documentDidChange(View::MapDocument*)
   updateRecentDocumentsMenu();
 }
 
+void MapFrame::documentWasLoaded(View::MapDocument* document)
+{
+  documentDidChange(document);
+
+  // if the application crashed, the newest backup might not contain the changes that
+  // were appended to its journal yet
+  m_autosaver->recoverJournal(logger());
+}
+
 void MapFrame::documentModificationStateDidChange()
 {
   updateTitleDelayed();
@@ -1404,17 +1417,21 @@ void MapFrame::copyToClipboard()
 {
   QClipboard* clipboard = QApplication::clipboard();
 
-  std::string str;
   if (m_document->hasSelectedNodes())
   {
-    str = m_document->serializeSelectedNodes();
+    // the clipboard takes ownership of the data
+    clipboard->setMimeData(new NodeClipboardData{*m_document});
   }
-  else if (m_document->hasSelectedBrushFaces())
+  else
   {
-    str = m_document->serializeSelectedBrushFaces();
-  }
+    std::string str;
+    if (m_document->hasSelectedBrushFaces())
+    {
+      str = m_document->serializeSelectedBrushFaces();
+    }
 
-  clipboard->setText(mapStringToUnicode(m_document->encoding(), str));
+    clipboard->setText(mapStringToUnicode(m_document->encoding(), str));
+  }
 }
 
 bool MapFrame::canCutSelection() const
@@ -1469,6 +1486,15 @@ void MapFrame::pasteAtOriginalPosition()
 PasteType MapFrame::paste()
 {
   auto* clipboard = QApplication::clipboard();
+  if (const auto* mimeData = clipboard->mimeData())
+  {
+    // nodes copied in this process can be pasted without parsing them
+    if (const auto nodes = NodeClipboardData::cloneNodes(*mimeData, *m_document))
+    {
+      return m_document->pasteClonedNodes(*nodes);
+    }
+  }
+
   const auto qtext = clipboard->text();
 
   if (qtext.isEmpty())
@@ -175,6 +175,7 @@ private: // notification handlers
 
   void documentWasCleared(View::MapDocument* document);
   void documentDidChange(View::MapDocument* document);
+  void documentWasLoaded(View::MapDocument* document);
   void documentModificationStateDidChange();
 
   void transactionDone(const std::string&);
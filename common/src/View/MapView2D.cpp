@@ -83,6 +83,7 @@ MapView2D::MapView2D(
   Logger* logger)
   : MapViewBase(logger, document, toolBox, renderer, contextManager)
   , m_camera(std::make_unique<Renderer::OrthographicCamera>())
+  , m_gridRenderer(std::make_unique<Renderer::GridRenderer>(*m_camera))
 {
   connectObservers();
   initializeCamera(viewPlane);
@@ -105,6 +106,8 @@ MapView2D::MapView2D(
   mapViewBaseVirtualInit();
 }
 
+MapView2D::~MapView2D() = default;
+
 void MapView2D::initializeCamera(const ViewPlane viewPlane)
 {
   auto document = kdl::mem_lock(m_document);
@@ -386,7 +389,7 @@ Renderer::Camera& MapView2D::doGetCamera()
 void MapView2D::doRenderGrid(Renderer::RenderContext&, Renderer::RenderBatch& renderBatch)
 {
   auto document = kdl::mem_lock(m_document);
-  renderBatch.addOneShot(new Renderer::GridRenderer(*m_camera, document->worldBounds()));
+  m_gridRenderer->render(renderBatch, document->worldBounds());
 }
 
 void MapView2D::doRenderMap(
@@ -88,6 +88,7 @@ MapView3D::MapView3D(
   : MapViewBase(logger, std::move(document), toolBox, renderer, contextManager)
   , m_camera(std::make_unique<Renderer::PerspectiveCamera>())
   , m_flyModeHelper(std::make_unique<FlyModeHelper>(*m_camera))
+  , m_gridRenderer(std::make_unique<Renderer::GridRenderer3D>())
   , m_ignoreCameraChangeEvents(false)
 {
   bindEvents();
@@ -556,7 +557,7 @@ void MapView3D::doRenderGrid(Renderer::RenderContext& context, Renderer::RenderB
   auto document = kdl::mem_lock(m_document);
   
   if(context.show3DGrid()) {
-    renderBatch.addOneShot(new Renderer::GridRenderer3D(*m_camera, document->worldBounds()));
+    m_gridRenderer->render(renderBatch, document->worldBounds());
   }
 }
 
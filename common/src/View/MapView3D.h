@@ -35,6 +35,7 @@ class Logger;
 
 namespace Renderer
 {
+class GridRenderer3D;
 class PerspectiveCamera;
 }
 
@@ -48,6 +49,7 @@ class MapView3D : public MapViewBase
 private:
   std::unique_ptr<Renderer::PerspectiveCamera> m_camera;
   std::unique_ptr<FlyModeHelper> m_flyModeHelper;
+  std::unique_ptr<Renderer::GridRenderer3D> m_gridRenderer;
   bool m_ignoreCameraChangeEvents;
 
   NotifierConnection m_notifierConnection;
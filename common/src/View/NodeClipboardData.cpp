@@ -0,0 +1,133 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NodeClipboardData.h"
+
+#include "Model/Game.h"
+#include "Model/LayerNode.h"
+#include "Model/WorldNode.h"
+#include "View/MapDocument.h"
+#include "View/MapTextEncoding.h"
+#include "View/QtUtils.h"
+
+#include <QCoreApplication>
+
+#include <sstream>
+
+namespace TrenchBroom
+{
+namespace View
+{
+namespace
+{
+const auto IdMimeType = QString{"application/x-trenchbroom-nodes-id"};
+const auto TextMimeType = QString{"text/plain"};
+
+QByteArray makeId()
+{
+  static auto nextId = quint64(1);
+  return QByteArray::number(QCoreApplication::applicationPid()) + "-"
+         + QByteArray::number(nextId++);
+}
+} // namespace
+
+struct NodeClipboardData::Contents
+{
+  QByteArray id;
+  std::shared_ptr<Model::Game> game;
+  MapTextEncoding encoding;
+
+  /**
+   * Holds the copied nodes in its default layer. The world's properties and map format
+   * are needed to serialize the nodes.
+   */
+  std::unique_ptr<Model::WorldNode> world;
+};
+
+NodeClipboardData::NodeClipboardData(const MapDocument& document)
+  : m_contents{std::make_shared<Contents>(Contents{
+    makeId(),
+    document.game(),
+    document.encoding(),
+    std::make_unique<Model::WorldNode>(
+      document.world()->entityPropertyConfig(),
+      document.world()->entity(),
+      document.world()->mapFormat())})}
+{
+  m_contents->world->defaultLayer()->addChildren(document.cloneSelectedNodes());
+  currentContents() = m_contents;
+}
+
+NodeClipboardData::~NodeClipboardData() = default;
+
+std::weak_ptr<NodeClipboardData::Contents>& NodeClipboardData::currentContents()
+{
+  static auto contents = std::weak_ptr<Contents>{};
+  return contents;
+}
+
+std::optional<std::vector<Model::Node*>> NodeClipboardData::cloneNodes(
+  const QMimeData& mimeData, const MapDocument& document)
+{
+  const auto contents = currentContents().lock();
+  if (
+    !contents || contents->world->mapFormat() != document.world()->mapFormat()
+    || !mimeData.hasFormat(IdMimeType) || mimeData.data(IdMimeType) != contents->id)
+  {
+    return std::nullopt;
+  }
+
+  return Model::Node::cloneRecursively(
+    document.worldBounds(), contents->world->defaultLayer()->children());
+}
+
+QStringList NodeClipboardData::formats() const
+{
+  return {TextMimeType, IdMimeType};
+}
+
+bool NodeClipboardData::hasFormat(const QString& mimeType) const
+{
+  return formats().contains(mimeType);
+}
+
+QVariant NodeClipboardData::retrieveData(
+  const QString& mimeType, const QVariant::Type type) const
+{
+  if (mimeType == IdMimeType)
+  {
+    return m_contents->id;
+  }
+
+  if (mimeType.startsWith(TextMimeType))
+  {
+    if (!m_text)
+    {
+      auto stream = std::stringstream{};
+      m_contents->game->writeNodesToStream(
+        *m_contents->world, m_contents->world->defaultLayer()->children(), stream);
+      m_text = mapStringToUnicode(m_contents->encoding, stream.str());
+    }
+    return *m_text;
+  }
+
+  return QMimeData::retrieveData(mimeType, type);
+}
+} // namespace View
+} // namespace TrenchBroom
@@ -0,0 +1,87 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QMimeData>
+#include <QString>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace TrenchBroom
+{
+namespace Model
+{
+class Node;
+}
+
+namespace View
+{
+class MapDocument;
+
+/**
+ * Clipboard data for the nodes copied from a map document.
+ *
+ * Holds clones of the copied nodes so that pasting them into a document of the same map
+ * format in this process does not need to parse them. The text representation is only
+ * created when it is requested, e.g. when the nodes are pasted into another application.
+ *
+ * Each instance is tagged with a unique ID so that it can be recognized when it is
+ * retrieved from the clipboard again.
+ */
+class NodeClipboardData : public QMimeData
+{
+private:
+  struct Contents;
+  std::shared_ptr<Contents> m_contents;
+  mutable std::optional<QString> m_text;
+
+  /**
+   * The contents of the most recently created clipboard data. The clipboard data owns its
+   * contents, so they are released once the clipboard data is replaced and destroyed.
+   */
+  static std::weak_ptr<Contents>& currentContents();
+
+public:
+  /**
+   * Creates clipboard data for the nodes currently selected in the given document.
+   */
+  explicit NodeClipboardData(const MapDocument& document);
+  ~NodeClipboardData() override;
+
+  /**
+   * If the given clipboard data holds nodes that were copied in this process from a
+   * document with the same map format as the given document, returns clones of these
+   * nodes. The caller takes ownership of the clones.
+   *
+   * Otherwise, returns std::nullopt, and the clipboard contents must be parsed.
+   */
+  static std::optional<std::vector<Model::Node*>> cloneNodes(
+    const QMimeData& mimeData, const MapDocument& document);
+
+  QStringList formats() const override;
+  bool hasFormat(const QString& mimeType) const override;
+
+protected:
+  QVariant retrieveData(const QString& mimeType, QVariant::Type type) const override;
+};
+} // namespace View
+} // namespace TrenchBroom
@@ -113,7 +113,11 @@ RenderView::RenderView(GLContextManager& contextManager, QWidget* parent)
       + " Max time between frames: " + std::to_string(maxFrameTime) + "ms. "
       + std::to_string(m_glContext->vboManager().currentVboCount()) + " current VBOs ("
       + std::to_string(m_glContext->vboManager().peakVboCount()) + " peak) totalling "
-      + std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB";
+      + std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB. "
+      + "Last frame: " + std::to_string(m_lastFrameCallCounts.programSwitches)
+      + " program switches, " + std::to_string(m_lastFrameCallCounts.bufferBinds)
+      + " buffer binds, " + std::to_string(m_lastFrameCallCounts.textureBinds)
+      + " texture binds";
   });
 
   fpsCounter->start(1000);
@@ -190,9 +194,11 @@ void RenderView::paintGL()
   if (TrenchBroom::View::isReportingCrash())
     return;
 
+  glResetCallCounts();
   render();
 
   // Update stats
+  m_lastFrameCallCounts = glCallCounts();
   m_framesRendered++;
   if (m_timeSinceLastFrame.isValid())
   {
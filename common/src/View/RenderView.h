@@ -57,6 +57,7 @@ private: // FPS counter
   // stats since the last counter update
   int m_framesRendered;
   int m_maxFrameTimeMsecs;
+  GLCallCounts m_lastFrameCallCounts;
   // other
   int64_t m_lastFPSCounterUpdate;
   QElapsedTimer m_timeSinceLastFrame;
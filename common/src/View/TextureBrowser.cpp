@@ -223,22 +223,23 @@ void TextureBrowser::documentWasLoaded(MapDocument*)
 
 void TextureBrowser::nodesWereAdded(const std::vector<Model::Node*>&)
 {
-  reload();
+  // the view observes the texture usage counts itself, so the layout stays valid
+  m_view->update();
 }
 
 void TextureBrowser::nodesWereRemoved(const std::vector<Model::Node*>&)
 {
-  reload();
+  m_view->update();
 }
 
 void TextureBrowser::nodesDidChange(const std::vector<Model::Node*>&)
 {
-  reload();
+  m_view->update();
 }
 
 void TextureBrowser::brushFacesDidChange(const std::vector<Model::BrushFaceHandle>&)
 {
-  reload();
+  m_view->update();
 }
 
 void TextureBrowser::textureCollectionsDidChange()
@@ -44,6 +44,7 @@
 #include <vecmath/mat_ext.h>
 #include <vecmath/vec.h>
 
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -54,6 +55,49 @@ namespace TrenchBroom
 {
 namespace View
 {
+namespace
+{
+std::vector<std::vector<size_t>> allTextureIndices(
+  const std::vector<std::vector<std::string>>& names)
+{
+  return kdl::vec_transform(names, [](const auto& groupNames) {
+    auto indices = std::vector<size_t>(groupNames.size());
+    std::iota(indices.begin(), indices.end(), size_t(0));
+    return indices;
+  });
+}
+
+/**
+ * Returns the indices of the candidate names that contain the given filter text, or
+ * nothing if filtering was cancelled.
+ */
+std::optional<std::vector<std::vector<size_t>>> filterTextureNames(
+  const std::vector<std::vector<std::string>>& names,
+  const std::vector<std::vector<size_t>>& candidates,
+  const std::string& filterText,
+  const std::atomic<bool>& cancelled)
+{
+  auto result = std::vector<std::vector<size_t>>{};
+  result.reserve(candidates.size());
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    auto& matches = result.emplace_back();
+    for (const auto index : candidates[i])
+    {
+      if (cancelled)
+      {
+        return std::nullopt;
+      }
+      if (kdl::ci::str_contains(names[i][index], filterText))
+      {
+        matches.push_back(index);
+      }
+    }
+  }
+  return result;
+}
+} // namespace
+
 TextureBrowserView::TextureBrowserView(
   QScrollBar* scrollBar,
   GLContextManager& contextManager,
@@ -63,6 +107,7 @@ TextureBrowserView::TextureBrowserView(
   , m_group(false)
   , m_hideUnused(false)
   , m_sortOrder(TextureSortOrder::Name)
+  , m_filterTaskId(0)
   , m_selectedTexture(nullptr)
 {
   auto doc = kdl::mem_lock(m_document);
@@ -72,6 +117,7 @@ TextureBrowserView::TextureBrowserView(
 
 TextureBrowserView::~TextureBrowserView()
 {
+  cancelFilterTask();
   clear();
 }
 
@@ -115,8 +161,16 @@ void TextureBrowserView::setFilterText(const std::string& filterText)
     return;
   }
   m_filterText = filterText;
-  invalidate();
-  update();
+  if (m_sortedGroups)
+  {
+    // the layout is reloaded once the filter task has finished
+    startFilterTask();
+  }
+  else
+  {
+    invalidateLayout();
+    update();
+  }
 }
 
 const Assets::Texture* TextureBrowserView::selectedTexture() const
@@ -144,7 +198,12 @@ void TextureBrowserView::revealTexture(const Assets::Texture* texture)
 
 void TextureBrowserView::usageCountDidChange()
 {
-  invalidate();
+  // the usage counts only affect the colors of the cells unless they are used to sort or
+  // to filter the textures
+  if (m_hideUnused || m_sortOrder == TextureSortOrder::Usage)
+  {
+    invalidate();
+  }
   update();
 }
 
@@ -169,19 +228,20 @@ void TextureBrowserView::doReloadLayout(Layout& layout)
 
   const Renderer::FontDescriptor font(fontPath, static_cast<size_t>(fontSize));
 
-  if (m_group)
+  // the titles consist of two lines of text
+  const auto lineHeight = fontManager().font(font).measure(std::string{}).y();
+  const auto titleHeight = 2.0f * lineHeight + 4.0f;
+
+  for (const auto& group : getFilteredGroups())
   {
-    for (const Assets::TextureCollection& collection : getCollections())
+    if (m_group)
     {
-      layout.addGroup(collection.name(), static_cast<float>(fontSize) + 2.0f);
-      for (const Assets::Texture* texture : getTextures(collection))
-        addTextureToLayout(layout, texture, collection.name(), font);
+      layout.addGroup(group.name, static_cast<float>(fontSize) + 2.0f);
+    }
+    for (const Assets::Texture* texture : group.textures)
+    {
+      addTextureToLayout(layout, texture, group.name, titleHeight);
     }
-  }
-  else
-  {
-    for (const Assets::Texture* texture : getTextures())
-      addTextureToLayout(layout, texture, "", font);
   }
 }
 
@@ -189,45 +249,26 @@ void TextureBrowserView::addTextureToLayout(
   Layout& layout,
   const Assets::Texture* texture,
   const std::string& groupName,
-  const Renderer::FontDescriptor& font)
+  const float titleHeight)
 {
   const float maxCellWidth = layout.maxCellWidth();
 
   const auto textureName = IO::Path(texture->name()).lastComponent().asString();
 
-  const auto textureFont =
-    fontManager().selectFontSize(font, textureName, maxCellWidth, 6);
-  const auto groupFont = fontManager().selectFontSize(font, groupName, maxCellWidth, 6);
-
-  const auto defaultTextHeight =
-    fontManager().font(font).measure(groupName + textureName).y();
-  const auto textureNameSize = fontManager().font(textureFont).measure(textureName);
-  const auto groupNameSize = fontManager().font(groupFont).measure(groupName);
-
-  const auto totalSize = vm::vec2f(
-    vm::max(groupNameSize.x(), textureNameSize.x()), 2.0f * defaultTextHeight + 4.0f);
-
   const float scaleFactor = pref(Preferences::TextureBrowserIconSize);
   const float scaledTextureWidth =
     vm::round(scaleFactor * static_cast<float>(texture->width()));
   const float scaledTextureHeight =
     vm::round(scaleFactor * static_cast<float>(texture->height()));
 
-  auto cellData = TextureCellData{
-    texture,
-    textureName,
-    groupName,
-    vm::vec2f((maxCellWidth - textureNameSize.x()) / 2.0f, defaultTextHeight + 3.0f),
-    vm::vec2f((maxCellWidth - groupNameSize.x()) / 2.0f, 1.0f),
-    textureFont,
-    groupFont};
+  auto cellData = TextureCellData{texture, textureName, groupName, std::nullopt};
 
   layout.addItem(
     std::move(cellData),
     scaledTextureWidth,
     scaledTextureHeight,
     maxCellWidth,
-    totalSize.y());
+    titleHeight);
 }
 
 struct TextureBrowserView::CompareByUsageCount
@@ -266,21 +307,6 @@ struct TextureBrowserView::MatchUsageCount
   }
 };
 
-struct TextureBrowserView::MatchName
-{
-  std::string pattern;
-
-  explicit MatchName(const std::string& i_pattern)
-    : pattern(i_pattern)
-  {
-  }
-
-  bool operator()(const Assets::Texture* texture) const
-  {
-    return !kdl::ci::str_contains(texture->name(), pattern);
-  }
-};
-
 const std::vector<Assets::TextureCollection>& TextureBrowserView::getCollections() const
 {
   auto doc = kdl::mem_lock(m_document);
@@ -306,13 +332,124 @@ std::vector<const Assets::Texture*> TextureBrowserView::getTextures() const
   return textures;
 }
 
+std::vector<TextureBrowserView::TextureGroup> TextureBrowserView::getSortedGroups() const
+{
+  if (m_group)
+  {
+    return kdl::vec_transform(getCollections(), [&](const auto& collection) {
+      return TextureGroup{collection.name(), getTextures(collection)};
+    });
+  }
+  return {TextureGroup{"", getTextures()}};
+}
+
+const std::vector<TextureBrowserView::TextureGroup>& TextureBrowserView::
+  getFilteredGroups()
+{
+  if (!m_sortedGroups)
+  {
+    m_sortedGroups = getSortedGroups();
+    m_sortedNames = std::make_shared<const TextureNames>(
+      kdl::vec_transform(*m_sortedGroups, [](const auto& group) {
+        return kdl::vec_transform(
+          group.textures, [](const auto* texture) { return texture->name(); });
+      }));
+
+    // the sorted textures are filtered right away so that the browser never shows
+    // textures that don't match the filter text
+    const auto notCancelled = std::atomic<bool>{false};
+    auto filteredIndices = filterTextureNames(
+      *m_sortedNames, allTextureIndices(*m_sortedNames), m_filterText, notCancelled);
+    setFilteredIndices(std::move(*filteredIndices), m_filterText);
+  }
+
+  return m_filteredGroups;
+}
+
+void TextureBrowserView::setFilteredIndices(
+  TextureIndices filteredIndices, std::string filteredText)
+{
+  m_filteredGroups.clear();
+  m_filteredGroups.reserve(filteredIndices.size());
+  for (size_t i = 0; i < filteredIndices.size(); ++i)
+  {
+    const auto& sortedGroup = (*m_sortedGroups)[i];
+    m_filteredGroups.push_back(TextureGroup{
+      sortedGroup.name, kdl::vec_transform(filteredIndices[i], [&](const auto index) {
+        return sortedGroup.textures[index];
+      })});
+  }
+
+  m_filteredIndices = std::move(filteredIndices);
+  m_filteredText = std::move(filteredText);
+}
+
+void TextureBrowserView::startFilterTask()
+{
+  cancelFilterTask();
+
+  // if the filter text was only extended, the textures that didn't match before can't
+  // match now, so only the previous matches need to be filtered
+  auto candidates = kdl::ci::str_contains(m_filterText, m_filteredText)
+                      ? m_filteredIndices
+                      : allTextureIndices(*m_sortedNames);
+
+  // the task only reads the copied texture names, so it cannot observe the texture
+  // collections being replaced
+  m_filterTaskCancelled = std::make_shared<std::atomic<bool>>(false);
+  m_filterTask = std::async(
+    std::launch::async,
+    [this,
+     filterTaskId = m_filterTaskId,
+     sortedNames = m_sortedNames,
+     candidates = std::move(candidates),
+     filterText = m_filterText,
+     cancelled = m_filterTaskCancelled]() {
+      if (
+        auto filteredIndices =
+          filterTextureNames(*sortedNames, candidates, filterText, *cancelled))
+      {
+        // this view waits for the task to finish before it is destroyed
+        QMetaObject::invokeMethod(
+          this,
+          [this,
+           filterTaskId,
+           filterText,
+           filteredIndices = std::move(*filteredIndices)]() mutable {
+            filterTaskDidFinish(filterTaskId, std::move(filteredIndices), filterText);
+          },
+          Qt::QueuedConnection);
+      }
+    });
+}
+
+void TextureBrowserView::filterTaskDidFinish(
+  const size_t filterTaskId, TextureIndices filteredIndices, std::string filteredText)
+{
+  // the results of cancelled tasks are dropped
+  if (filterTaskId == m_filterTaskId)
+  {
+    setFilteredIndices(std::move(filteredIndices), std::move(filteredText));
+    invalidateLayout();
+    update();
+  }
+}
+
+void TextureBrowserView::cancelFilterTask()
+{
+  if (m_filterTask.valid())
+  {
+    *m_filterTaskCancelled = true;
+    m_filterTask.wait();
+  }
+  ++m_filterTaskId;
+}
+
 void TextureBrowserView::filterTextures(
   std::vector<const Assets::Texture*>& textures) const
 {
   if (m_hideUnused)
     textures = kdl::vec_erase_if(std::move(textures), MatchUsageCount());
-  if (!m_filterText.empty())
-    textures = kdl::vec_erase_if(std::move(textures), MatchName(m_filterText));
 }
 
 void TextureBrowserView::sortTextures(std::vector<const Assets::Texture*>& textures) const
@@ -328,6 +465,17 @@ void TextureBrowserView::sortTextures(std::vector<const Assets::Texture*>& textu
   }
 }
 
+void TextureBrowserView::doInvalidate()
+{
+  // this drops the results of a pending filter task when the texture collections change
+  cancelFilterTask();
+  m_sortedGroups = std::nullopt;
+  m_sortedNames.reset();
+  m_filteredGroups.clear();
+  m_filteredIndices.clear();
+  m_filteredText.clear();
+}
+
 void TextureBrowserView::doClear() {}
 
 void TextureBrowserView::doRender(Layout& layout, const float y, const float height)
@@ -364,6 +512,27 @@ const Color& TextureBrowserView::getBackgroundColor()
   return pref(Preferences::BrowserBackgroundColor);
 }
 
+namespace
+{
+/**
+ * Calls the given function for every cell of the given group that intersects the given
+ * vertical range. The rows outside of the range are skipped without visiting them.
+ */
+template <typename L>
+void forEachVisibleCell(
+  const LayoutGroup& group, const float y, const float height, const L& lambda)
+{
+  const auto [first, last] = group.indicesOfRowsIntersectingY(y, height);
+  for (auto i = first; i < last; ++i)
+  {
+    for (const auto& cell : group.rows()[i].cells())
+    {
+      lambda(cell);
+    }
+  }
+}
+} // namespace
+
 void TextureBrowserView::renderBounds(Layout& layout, const float y, const float height)
 {
   using BoundsVertex = Renderer::GLVertexTypes::P2C4::Vertex;
@@ -373,29 +542,19 @@ void TextureBrowserView::renderBounds(Layout& layout, const float y, const float
   {
     if (group.intersectsY(y, height))
     {
-      for (const auto& row : group.rows())
-      {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            const LayoutBounds& bounds = cell.itemBounds();
-            const Assets::Texture* texture = cellData(cell).texture;
-            const Color& color = textureColor(*texture);
-            vertices.emplace_back(
-              vm::vec2f(bounds.left() - 2.0f, height - (bounds.top() - 2.0f - y)), color);
-            vertices.emplace_back(
-              vm::vec2f(bounds.left() - 2.0f, height - (bounds.bottom() + 2.0f - y)),
-              color);
-            vertices.emplace_back(
-              vm::vec2f(bounds.right() + 2.0f, height - (bounds.bottom() + 2.0f - y)),
-              color);
-            vertices.emplace_back(
-              vm::vec2f(bounds.right() + 2.0f, height - (bounds.top() - 2.0f - y)),
-              color);
-          }
-        }
-      }
+      forEachVisibleCell(group, y, height, [&](const auto& cell) {
+        const LayoutBounds& bounds = cell.itemBounds();
+        const Assets::Texture* texture = cellData(cell).texture;
+        const Color& color = textureColor(*texture);
+        vertices.emplace_back(
+          vm::vec2f(bounds.left() - 2.0f, height - (bounds.top() - 2.0f - y)), color);
+        vertices.emplace_back(
+          vm::vec2f(bounds.left() - 2.0f, height - (bounds.bottom() + 2.0f - y)), color);
+        vertices.emplace_back(
+          vm::vec2f(bounds.right() + 2.0f, height - (bounds.bottom() + 2.0f - y)), color);
+        vertices.emplace_back(
+          vm::vec2f(bounds.right() + 2.0f, height - (bounds.top() - 2.0f - y)), color);
+      });
     }
   }
 
@@ -420,54 +579,53 @@ void TextureBrowserView::renderTextures(Layout& layout, const float y, const flo
 {
   using TextureVertex = Renderer::GLVertexTypes::P2T2::Vertex;
 
+  // the quads of all visible cells are uploaded at once and then rendered one by one
+  std::vector<const Assets::Texture*> textures;
+  std::vector<TextureVertex> vertices;
+
+  for (const auto& group : layout.groups())
+  {
+    if (group.intersectsY(y, height))
+    {
+      forEachVisibleCell(group, y, height, [&](const auto& cell) {
+        const LayoutBounds& bounds = cell.itemBounds();
+        textures.push_back(cellData(cell).texture);
+
+        vertices.emplace_back(
+          vm::vec2f(bounds.left(), height - (bounds.top() - y)), vm::vec2f(0.0f, 0.0f));
+        vertices.emplace_back(
+          vm::vec2f(bounds.left(), height - (bounds.bottom() - y)),
+          vm::vec2f(0.0f, 1.0f));
+        vertices.emplace_back(
+          vm::vec2f(bounds.right(), height - (bounds.bottom() - y)),
+          vm::vec2f(1.0f, 1.0f));
+        vertices.emplace_back(
+          vm::vec2f(bounds.right(), height - (bounds.top() - y)), vm::vec2f(1.0f, 0.0f));
+      });
+    }
+  }
+
+  Renderer::VertexArray vertexArray = Renderer::VertexArray::move(std::move(vertices));
+  vertexArray.prepare(vboManager());
+
   Renderer::ActiveShader shader(shaderManager(), Renderer::Shaders::TextureBrowserShader);
   shader.set("ApplyTinting", false);
   shader.set("Texture", 0);
   shader.set("Brightness", pref(Preferences::Brightness));
 
-  size_t num = 0;
-
-  for (const auto& group : layout.groups())
+  if (vertexArray.setup())
   {
-    if (group.intersectsY(y, height))
+    for (size_t i = 0; i < textures.size(); ++i)
     {
-      for (const auto& row : group.rows())
-      {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            const LayoutBounds& bounds = cell.itemBounds();
-            const Assets::Texture* texture = cellData(cell).texture;
-
-            Renderer::VertexArray vertexArray =
-              Renderer::VertexArray::move(std::vector<TextureVertex>(
-                {TextureVertex(
-                   vm::vec2f(bounds.left(), height - (bounds.top() - y)),
-                   vm::vec2f(0.0f, 0.0f)),
-                 TextureVertex(
-                   vm::vec2f(bounds.left(), height - (bounds.bottom() - y)),
-                   vm::vec2f(0.0f, 1.0f)),
-                 TextureVertex(
-                   vm::vec2f(bounds.right(), height - (bounds.bottom() - y)),
-                   vm::vec2f(1.0f, 1.0f)),
-                 TextureVertex(
-                   vm::vec2f(bounds.right(), height - (bounds.top() - y)),
-                   vm::vec2f(1.0f, 0.0f))}));
-
-            shader.set("GrayScale", texture->overridden());
-            texture->activate();
-
-            vertexArray.prepare(vboManager());
-            vertexArray.render(Renderer::PrimType::Quads);
-
-            texture->deactivate();
-
-            ++num;
-          }
-        }
-      }
+      const auto* texture = textures[i];
+      shader.set("GrayScale", texture->overridden());
+      texture->activate();
+
+      vertexArray.render(Renderer::PrimType::Quads, static_cast<GLint>(4 * i), 4);
+
+      texture->deactivate();
     }
+    vertexArray.cleanup();
   }
 }
 
@@ -567,57 +725,52 @@ TextureBrowserView::StringMap TextureBrowserView::collectStringVertices(
           std::end(vertices), std::begin(titleVertices), std::end(titleVertices));
       }
 
-      for (const auto& row : group.rows())
-      {
-        if (row.intersectsY(y, height))
-        {
-          for (const auto& cell : row.cells())
-          {
-            const auto titleBounds = cell.titleBounds();
-            const auto& textureFont = fontManager().font(cellData(cell).mainTitleFont);
-            const auto& groupFont = fontManager().font(cellData(cell).subTitleFont);
-
-            // y is relative to top, but OpenGL coords are relative to bottom, so invert
-            const auto titleOffset =
-              vm::vec2f(titleBounds.left(), y + height - titleBounds.bottom());
-
-            const auto textureNameOffset = titleOffset + cellData(cell).mainTitleOffset;
-            const auto groupNameOffset = titleOffset + cellData(cell).subTitleOffset;
-
-            const auto& textureName = cellData(cell).mainTitle;
-            const auto& groupName = cellData(cell).subTitle;
-
-            const auto textureNameQuads =
-              textureFont.quads(textureName, false, textureNameOffset);
-            const auto groupNameQuads =
-              groupFont.quads(groupName, false, groupNameOffset);
-
-            const auto textureNameVertices = TextVertex::toList(
-              textureNameQuads.size() / 2,
-              kdl::skip_iterator(
-                std::begin(textureNameQuads), std::end(textureNameQuads), 0, 2),
-              kdl::skip_iterator(
-                std::begin(textureNameQuads), std::end(textureNameQuads), 1, 2),
-              kdl::skip_iterator(std::begin(textColor), std::end(textColor), 0, 0));
-
-            const auto groupNameVertices = TextVertex::toList(
-              groupNameQuads.size() / 2,
-              kdl::skip_iterator(
-                std::begin(groupNameQuads), std::end(groupNameQuads), 0, 2),
-              kdl::skip_iterator(
-                std::begin(groupNameQuads), std::end(groupNameQuads), 1, 2),
-              kdl::skip_iterator(std::begin(subTextColor), std::end(subTextColor), 0, 0));
-
-            auto& mainTitleVertices = stringVertices[cellData(cell).mainTitleFont];
-            mainTitleVertices =
-              kdl::vec_concat(std::move(mainTitleVertices), textureNameVertices);
-
-            auto& subTitleVertices = stringVertices[cellData(cell).subTitleFont];
-            subTitleVertices =
-              kdl::vec_concat(std::move(subTitleVertices), groupNameVertices);
-          }
-        }
-      }
+      forEachVisibleCell(group, y, height, [&](const auto& cell) {
+        const auto titleBounds = cell.titleBounds();
+        const auto& titleLayout = this->titleLayout(layout, cell);
+        const auto& textureFont = fontManager().font(titleLayout.mainTitleFont);
+        const auto& groupFont = fontManager().font(titleLayout.subTitleFont);
+
+        // y is relative to top, but OpenGL coords are relative to bottom, so invert
+        const auto titleOffset =
+          vm::vec2f(titleBounds.left(), y + height - titleBounds.bottom());
+
+        const auto textureNameOffset = titleOffset + titleLayout.mainTitleOffset;
+        const auto groupNameOffset = titleOffset + titleLayout.subTitleOffset;
+
+        const auto& textureName = cellData(cell).mainTitle;
+        const auto& groupName = cellData(cell).subTitle;
+
+        const auto textureNameQuads =
+          textureFont.quads(textureName, false, textureNameOffset);
+        const auto groupNameQuads = groupFont.quads(groupName, false, groupNameOffset);
+
+        const auto textureNameVertices = TextVertex::toList(
+          textureNameQuads.size() / 2,
+          kdl::skip_iterator(
+            std::begin(textureNameQuads), std::end(textureNameQuads), 0, 2),
+          kdl::skip_iterator(
+            std::begin(textureNameQuads), std::end(textureNameQuads), 1, 2),
+          kdl::skip_iterator(std::begin(textColor), std::end(textColor), 0, 0));
+
+        const auto groupNameVertices = TextVertex::toList(
+          groupNameQuads.size() / 2,
+          kdl::skip_iterator(std::begin(groupNameQuads), std::end(groupNameQuads), 0, 2),
+          kdl::skip_iterator(std::begin(groupNameQuads), std::end(groupNameQuads), 1, 2),
+          kdl::skip_iterator(std::begin(subTextColor), std::end(subTextColor), 0, 0));
+
+        auto& mainTitleVertices = stringVertices[titleLayout.mainTitleFont];
+        mainTitleVertices.insert(
+          std::end(mainTitleVertices),
+          std::begin(textureNameVertices),
+          std::end(textureNameVertices));
+
+        auto& subTitleVertices = stringVertices[titleLayout.subTitleFont];
+        subTitleVertices.insert(
+          std::end(subTitleVertices),
+          std::begin(groupNameVertices),
+          std::end(groupNameVertices));
+      });
     }
   }
 
@@ -675,5 +828,37 @@ const TextureCellData& TextureBrowserView::cellData(const Cell& cell) const
 {
   return cell.itemAs<TextureCellData>();
 }
+
+const TextureCellTitleLayout& TextureBrowserView::titleLayout(
+  Layout& layout, const Cell& cell)
+{
+  const auto& cellData = this->cellData(cell);
+  if (!cellData.titleLayout)
+  {
+    const auto font = Renderer::FontDescriptor{
+      pref(Preferences::RendererFontPath()),
+      static_cast<size_t>(pref(Preferences::BrowserFontSize))};
+
+    const float maxCellWidth = layout.maxCellWidth();
+    const auto& textureName = cellData.mainTitle;
+    const auto& groupName = cellData.subTitle;
+
+    const auto textureFont =
+      fontManager().selectFontSize(font, textureName, maxCellWidth, 6);
+    const auto groupFont = fontManager().selectFontSize(font, groupName, maxCellWidth, 6);
+
+    const auto defaultTextHeight =
+      fontManager().font(font).measure(groupName + textureName).y();
+    const auto textureNameSize = fontManager().font(textureFont).measure(textureName);
+    const auto groupNameSize = fontManager().font(groupFont).measure(groupName);
+
+    cellData.titleLayout = TextureCellTitleLayout{
+      vm::vec2f((maxCellWidth - textureNameSize.x()) / 2.0f, defaultTextHeight + 3.0f),
+      vm::vec2f((maxCellWidth - groupNameSize.x()) / 2.0f, 1.0f),
+      textureFont,
+      groupFont};
+  }
+  return *cellData.titleLayout;
+}
 } // namespace View
 } // namespace TrenchBroom
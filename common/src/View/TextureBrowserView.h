@@ -24,8 +24,11 @@
 #include "Renderer/GLVertexType.h"
 #include "View/CellView.h"
 
+#include <atomic>
+#include <future>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -45,17 +48,26 @@ class GLContextManager;
 class MapDocument;
 using TextureGroupData = std::string;
 
-struct TextureCellData
+struct TextureCellTitleLayout
 {
-  const Assets::Texture* texture;
-  std::string mainTitle;
-  std::string subTitle;
   vm::vec2f mainTitleOffset;
   vm::vec2f subTitleOffset;
   Renderer::FontDescriptor mainTitleFont;
   Renderer::FontDescriptor subTitleFont;
 };
 
+struct TextureCellData
+{
+  const Assets::Texture* texture;
+  std::string mainTitle;
+  std::string subTitle;
+
+  /**
+   * The fonts and offsets of the titles are only computed once the cell is rendered.
+   */
+  mutable std::optional<TextureCellTitleLayout> titleLayout;
+};
+
 enum class TextureSortOrder
 {
   Name,
@@ -69,12 +81,36 @@ private:
   using TextVertex = Renderer::GLVertexTypes::P2T2C4::Vertex;
   using StringMap = std::map<Renderer::FontDescriptor, std::vector<TextVertex>>;
 
+  struct TextureGroup
+  {
+    std::string name;
+    std::vector<const Assets::Texture*> textures;
+  };
+
+  // the texture names and the indices of matching textures, for each group
+  using TextureNames = std::vector<std::vector<std::string>>;
+  using TextureIndices = std::vector<std::vector<size_t>>;
+
   std::weak_ptr<MapDocument> m_document;
   bool m_group;
   bool m_hideUnused;
   TextureSortOrder m_sortOrder;
   std::string m_filterText;
 
+  // the sorted textures of each group, not yet filtered by name
+  std::optional<std::vector<TextureGroup>> m_sortedGroups;
+  // a copy of the names of the sorted textures, which is read by the filter task
+  std::shared_ptr<const TextureNames> m_sortedNames;
+  // the sorted textures of each group that match m_filteredText
+  std::vector<TextureGroup> m_filteredGroups;
+  TextureIndices m_filteredIndices;
+  std::string m_filteredText;
+
+  // filters the sorted textures by m_filterText in the background
+  std::future<void> m_filterTask;
+  std::shared_ptr<std::atomic<bool>> m_filterTaskCancelled;
+  size_t m_filterTaskId;
+
   const Assets::Texture* m_selectedTexture;
 
   NotifierConnection m_notifierConnection;
@@ -105,21 +141,30 @@ private:
     Layout& layout,
     const Assets::Texture* texture,
     const std::string& groupName,
-    const Renderer::FontDescriptor& font);
+    float titleHeight);
 
   struct CompareByUsageCount;
   struct CompareByName;
   struct MatchUsageCount;
-  struct MatchName;
 
   const std::vector<Assets::TextureCollection>& getCollections() const;
   std::vector<const Assets::Texture*> getTextures(
     const Assets::TextureCollection& collection) const;
   std::vector<const Assets::Texture*> getTextures() const;
 
+  std::vector<TextureGroup> getSortedGroups() const;
+  const std::vector<TextureGroup>& getFilteredGroups();
+  void setFilteredIndices(TextureIndices filteredIndices, std::string filteredText);
+
+  void startFilterTask();
+  void filterTaskDidFinish(
+    size_t filterTaskId, TextureIndices filteredIndices, std::string filteredText);
+  void cancelFilterTask();
+
   void filterTextures(std::vector<const Assets::Texture*>& textures) const;
   void sortTextures(std::vector<const Assets::Texture*>& textures) const;
 
+  void doInvalidate() override;
   void doClear() override;
   void doRender(Layout& layout, float y, float height) override;
   bool doShouldRenderFocusIndicator() const override;
@@ -138,6 +183,7 @@ private:
   void doContextMenu(Layout& layout, float x, float y, QContextMenuEvent* event) override;
 
   const TextureCellData& cellData(const Cell& cell) const;
+  const TextureCellTitleLayout& titleLayout(Layout& layout, const Cell& cell);
 signals:
   void textureSelected(const Assets::Texture* texture);
 };
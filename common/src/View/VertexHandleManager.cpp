@@ -45,10 +45,11 @@ void VertexHandleManager::pick(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  for (const auto* handle : findPickCandidates(pickRay, camera, handleRadius))
   {
-    const auto distance = camera.pickPointHandle(
-      pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+    const auto& position = *handle;
+    const auto distance = camera.pickPointHandle(pickRay, position, handleRadius);
     if (!vm::is_nan(distance))
     {
       const auto hitPoint = vm::point_at_distance(pickRay, distance);
@@ -96,16 +97,18 @@ void EdgeHandleManager::pickGridHandle(
   const Grid& grid,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  for (const auto* handle : findPickCandidates(pickRay, camera, handleRadius))
   {
-    const FloatType edgeDist = camera.pickLineSegmentHandle(
-      pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+    const auto& position = *handle;
+    const FloatType edgeDist =
+      camera.pickLineSegmentHandle(pickRay, position, handleRadius);
     if (!vm::is_nan(edgeDist))
     {
       const vm::vec3 pointHandle =
         grid.snap(vm::point_at_distance(pickRay, edgeDist), position);
-      const FloatType pointDist = camera.pickPointHandle(
-        pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+      const FloatType pointDist =
+        camera.pickPointHandle(pickRay, pointHandle, handleRadius);
       if (!vm::is_nan(pointDist))
       {
         const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
@@ -121,12 +124,14 @@ void EdgeHandleManager::pickCenterHandle(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  for (const auto* handle : findPickCandidates(pickRay, camera, handleRadius))
   {
+    const auto& position = *handle;
     const vm::vec3 pointHandle = position.center();
 
-    const FloatType pointDist = camera.pickPointHandle(
-      pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+    const FloatType pointDist =
+      camera.pickPointHandle(pickRay, pointHandle, handleRadius);
     if (!vm::is_nan(pointDist))
     {
       const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
@@ -174,8 +179,10 @@ void FaceHandleManager::pickGridHandle(
   const Grid& grid,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  for (const auto* handle : findPickCandidates(pickRay, camera, handleRadius))
   {
+    const auto& position = *handle;
     const auto [valid, plane] = vm::from_points(std::begin(position), std::end(position));
     if (!valid)
     {
@@ -188,8 +195,7 @@ void FaceHandleManager::pickGridHandle(
     {
       const auto pointHandle = grid.snap(vm::point_at_distance(pickRay, distance), plane);
 
-      const auto pointDist = camera.pickPointHandle(
-        pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+      const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
       if (!vm::is_nan(pointDist))
       {
         const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
@@ -205,12 +211,13 @@ void FaceHandleManager::pickCenterHandle(
   const Renderer::Camera& camera,
   Model::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+  for (const auto* handle : findPickCandidates(pickRay, camera, handleRadius))
   {
+    const auto& position = *handle;
     const auto pointHandle = position.center();
 
-    const auto pointDist = camera.pickPointHandle(
-      pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+    const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
     if (!vm::is_nan(pointDist))
     {
       const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
@@ -25,11 +25,15 @@
 #include "Model/HitType.h"
 #include "Model/PickResult.h"
 #include "Renderer/Camera.h"
+#include "octree.h"
 
 #include <kdl/vector_set.h>
 
+#include <vecmath/bbox.h>
+#include <vecmath/polygon.h>
 #include <vecmath/segment.h>
 
+#include <algorithm>
 #include <iterator>
 #include <map>
 #include <vector>
@@ -45,6 +49,31 @@ namespace View
 {
 class Grid;
 
+/**
+ * Returns the bounds of the given vertex handle.
+ */
+inline vm::bbox3 handleBounds(const vm::vec3& handle)
+{
+  return vm::bbox3{handle, handle};
+}
+
+/**
+ * Returns the bounds of the given edge handle.
+ */
+inline vm::bbox3 handleBounds(const vm::segment3& handle)
+{
+  return vm::bbox3{
+    vm::min(handle.start(), handle.end()), vm::max(handle.start(), handle.end())};
+}
+
+/**
+ * Returns the bounds of the given face handle.
+ */
+inline vm::bbox3 handleBounds(const vm::polygon3& handle)
+{
+  return vm::bbox3::merge_all(std::begin(handle), std::end(handle));
+}
+
 class VertexHandleManagerBase
 {
 public:
@@ -172,12 +201,19 @@ protected:
 
   using HandleMap = std::map<H, HandleInfo>;
   using HandleEntry = typename HandleMap::value_type;
+  using HandleTree = octree<FloatType, HandleEntry*>;
 
   /**
    * Maps a handle position to its info.
    */
   HandleMap m_handles;
 
+  /**
+   * Spatial index of the entries of m_handles, keyed by the bounds of their handles. The
+   * entries are stable because std::map never moves its elements.
+   */
+  HandleTree m_handleTree;
+
   /**
    * The total number of selected handles, not counting duplicates.
    */
@@ -185,7 +221,8 @@ protected:
 
 public:
   VertexHandleManagerBaseT()
-    : m_selectedHandleCount(0)
+    : m_handleTree(64.0)
+    , m_selectedHandleCount(0)
   {
   }
 
@@ -324,8 +361,14 @@ public:
    */
   void add(const Handle& handle)
   {
-    m_handles[handle].inc(); // unknown value gets value constructed, which for HandleInfo
-                             // means its default constructor is called
+    // unknown value gets value constructed, which for HandleInfo means its default
+    // constructor is called
+    const auto [it, inserted] = m_handles.try_emplace(handle);
+    if (inserted)
+    {
+      m_handleTree.insert(handleBounds(it->first), &*it);
+    }
+    it->second.inc();
   }
 
   /**
@@ -346,6 +389,7 @@ public:
       if (info.count == 0)
       {
         deselect(info);
+        m_handleTree.remove(&*it);
         m_handles.erase(it);
       }
       return true;
@@ -359,6 +403,7 @@ public:
    */
   void clear()
   {
+    m_handleTree.clear();
     m_handles.clear();
     m_selectedHandleCount = 0;
   }
@@ -466,11 +511,18 @@ private:
   void forEachCloseHandle(const H& otherHandle, F fun)
   {
     static const auto epsilon = 0.001 * 0.001;
-    for (auto& [handle, info] : m_handles)
+    const auto bounds = handleBounds(otherHandle).expand(epsilon);
+
+    auto candidates = std::vector<HandleEntry*>{};
+    m_handleTree.find_if(
+      [&](const vm::bbox3& nodeBounds) { return nodeBounds.intersects(bounds); },
+      std::back_inserter(candidates));
+
+    for (auto* entry : candidates)
     {
-      if (compare(otherHandle, handle, epsilon) == 0)
+      if (compare(otherHandle, entry->first, epsilon) == 0)
       {
-        fun(info);
+        fun(entry->second);
       }
     }
   }
@@ -530,6 +582,58 @@ public:
     }
   }
 
+protected:
+  /**
+   * Returns every handle that might be hit by the given picking ray when it is picked
+   * with the given handle radius in the context of the given camera. A handle can only be
+   * hit if the ray passes through its bounds enlarged by the handle radius, scaled for
+   * its distance to the camera. Since this scaling grows linearly with the distance to
+   * the camera, the largest scaling within a node of the handle tree is found at one of
+   * the node's corners.
+   *
+   * @param pickRay the picking ray
+   * @param camera the camera
+   * @param handleRadius the unscaled handle radius
+   * @return the candidate handles
+   */
+  std::vector<const Handle*> findPickCandidates(
+    const vm::ray3& pickRay,
+    const Renderer::Camera& camera,
+    const FloatType handleRadius) const
+  {
+    auto candidates = std::vector<HandleEntry*>{};
+    m_handleTree.find_if(
+      [&](const vm::bbox3& bounds) {
+        auto maxScaling = 0.0f;
+        for (const auto& corner : bounds.vertices())
+        {
+          maxScaling =
+            std::max(maxScaling, camera.perspectiveScalingFactor(vm::vec3f{corner}));
+        }
+
+        // slightly enlarged to absorb rounding errors
+        const auto pickRadius =
+          FloatType(2.01) * handleRadius * static_cast<FloatType>(maxScaling);
+        const auto pickBounds = bounds.expand(pickRadius);
+        return pickBounds.contains(pickRay.origin)
+               || !vm::is_nan(vm::intersect_ray_bbox(pickRay, pickBounds));
+      },
+      std::back_inserter(candidates));
+
+    auto result = std::vector<const Handle*>{};
+    result.reserve(candidates.size());
+    for (const auto* entry : candidates)
+    {
+      result.push_back(&entry->first);
+    }
+
+    // report hits in the same order as a scan of m_handles would
+    std::sort(result.begin(), result.end(), [&](const auto* lhs, const auto* rhs) {
+      return m_handles.key_comp()(*lhs, *rhs);
+    });
+    return result;
+  }
+
 public:
   /**
    * Finds and returns all brushes in the given range which are incident to the given
@@ -532,20 +532,12 @@ public:
   template <typename O>
   void find_intersectors(const vm::ray<T, 3>& ray, O out) const
   {
-    if (m_root)
-    {
-      visit_node_if(
-        *m_root,
-        [&](const auto& node) {
-          const auto& data = get_data(node);
-          std::copy(data.begin(), data.end(), out);
-        },
-        [&](const auto& node) {
-          const auto bounds = get_address(node).to_bounds(m_min_size);
-          return bounds.contains(ray.origin)
-                 || !vm::is_nan(vm::intersect_ray_bbox(ray, bounds));
-        });
-    }
+    find_if(
+      [&](const auto& bounds) {
+        return bounds.contains(ray.origin)
+               || !vm::is_nan(vm::intersect_ray_bbox(ray, bounds));
+      },
+      out);
   }
 
   /**
@@ -572,6 +564,26 @@ public:
    */
   template <typename O>
   void find_containers(const vm::vec<T, 3>& point, O out) const
+  {
+    find_if([&](const auto& bounds) { return bounds.contains(point); }, out);
+  }
+
+  /**
+   * Finds every data item in this tree that is stored in a node whose bounds satisfy the
+   * given predicate and appends it to the given output iterator. The children of a node
+   * are only visited if the node itself satisfies the predicate, so the predicate must
+   * hold for a node whenever it holds for any box contained in that node.
+   *
+   * The found items are only candidates, since the bounds of an item can be much smaller
+   * than the bounds of the node that contains it.
+   *
+   * @tparam P the predicate type
+   * @tparam O the output iterator type
+   * @param predicate a unary predicate that accepts the bounds of a node
+   * @param out the output iterator to append to
+   */
+  template <typename P, typename O>
+  void find_if(const P& predicate, O out) const
   {
     if (m_root)
     {
@@ -582,7 +594,7 @@ public:
           std::copy(data.begin(), data.end(), out);
         },
         [&](const auto& node) {
-          return get_address(node).to_bounds(m_min_size).contains(point);
+          return predicate(get_address(node).to_bounds(m_min_size));
         });
     }
   }
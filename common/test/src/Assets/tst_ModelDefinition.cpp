@@ -24,7 +24,9 @@
 #include "IO/Path.h"
 
 #include <map>
+#include <string>
 #include <tuple>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -115,6 +117,76 @@ TEST_CASE("ModelDefinitionTest.defaultModelSpecification")
   CHECK(modelDefinition.defaultModelSpecification() == expectedModelSpecification);
 }
 
+TEST_CASE("ModelDefinitionTest.propertyKeys")
+{
+  using T = std::tuple<std::string, std::vector<std::string>>;
+
+  // clang-format off
+  const auto
+  [expression,                                            expectedPropertyKeys] = GENERATE(values<T>({
+  {R"("maps/b_shell0.bsp")",                              {}},
+  {R"({ path: "maps/b_shell0.bsp", skin: 1, frame: 2 })", {}},
+  {R"({ path: "maps/b_shell0.bsp", skin: skin })",        {"skin"}},
+  {R"({path: model, skin: skin, frame: model})",          {"model", "skin"}},
+  {R"({{
+      spawnflags == 1 -> "maps/b_shell0.bsp",
+      spawnflags == 2 -> { path: "maps/b_shell1.bsp", skin: skin },
+                          "maps/b_shell1.bsp"
+  }})",                                                   {"spawnflags", "skin"}},
+  }));
+  // clang-format on
+
+  CAPTURE(expression);
+
+  const auto modelDefinition = makeModelDefinition(expression);
+  CHECK_THAT(
+    modelDefinition.propertyKeys(),
+    Catch::UnorderedEquals(expectedPropertyKeys));
+}
+
+TEST_CASE("ModelDefinitionTest.modelSpecificationCache")
+{
+  const auto modelDefinition = makeModelDefinition(R"({{
+      spawnflags == 1 -> "maps/b_shell0.bsp",
+                         { path: "maps/b_shell1.bsp", skin: skin }
+  }})");
+
+  auto cache = ModelSpecificationCache{};
+
+  const auto getModelSpecification = [&](std::map<std::string, EL::Value> variables) {
+    const auto variableStore = EL::VariableTable{std::move(variables)};
+    const auto expected = modelDefinition.modelSpecification(variableStore);
+    const auto actual = cache.modelSpecification(modelDefinition, variableStore);
+    CHECK(actual == expected);
+    return actual;
+  };
+
+  CHECK(
+    getModelSpecification({{"spawnflags", EL::Value{"1"}}, {"skin", EL::Value{"2"}}})
+    == ModelSpecification{IO::Path{"maps/b_shell0.bsp"}, 0, 0});
+  CHECK(
+    getModelSpecification({{"spawnflags", EL::Value{"1"}}, {"skin", EL::Value{"3"}}})
+    == ModelSpecification{IO::Path{"maps/b_shell0.bsp"}, 0, 0});
+  CHECK(
+    getModelSpecification({{"spawnflags", EL::Value{"0"}}, {"skin", EL::Value{"2"}}})
+    == ModelSpecification{IO::Path{"maps/b_shell1.bsp"}, 2, 0});
+  CHECK(
+    getModelSpecification({
+      {"spawnflags", EL::Value{"0"}},
+      {"skin", EL::Value{"2"}},
+      {"other", EL::Value{"x"}},
+    })
+    == ModelSpecification{IO::Path{"maps/b_shell1.bsp"}, 2, 0});
+
+  // non-string values are not cached
+  CHECK(
+    getModelSpecification({{"spawnflags", EL::Value{1}}, {"skin", EL::Value{3}}})
+    == ModelSpecification{IO::Path{"maps/b_shell0.bsp"}, 0, 0});
+  CHECK(
+    getModelSpecification({{"spawnflags", EL::Value{0}}, {"skin", EL::Value{3}}})
+    == ModelSpecification{IO::Path{"maps/b_shell1.bsp"}, 3, 0});
+}
+
 TEST_CASE("ModelDefinitionTest.scale")
 {
   using T = std::tuple<std::string, std::optional<std::string>, vm::vec3>;
@@ -19,6 +19,7 @@
 
 #include <cmath>
 
+#include "EL/CompiledExpression.h"
 #include "EL/ELExceptions.h"
 #include "EL/EvaluationContext.h"
 #include "EL/Expression.h"
@@ -747,5 +748,69 @@ TEST_CASE("ExpressionTest.testOptimize")
 
   CHECK(IO::ELParser::parseStrict(expression).optimize() == expectedExpression);
 }
+
+TEST_CASE("ExpressionTest.testCompile")
+{
+  using T = std::tuple<std::string, MapType>;
+
+  const auto spawnflags = [](const int value) {
+    return MapType{{"spawnflags", Value{value}}};
+  };
+
+  // clang-format off
+  const auto
+  [expression,                                  variables] = GENERATE_COPY(values<T>({
+  {"2 + 3 * 4 - x",                             {{"x", Value{1}}}},
+  {"[1, 2..4, x]",                              {{"x", Value{"test"}}}},
+  {"{k1: x, k2: 3 + 7, k3: [x]}",               {{"x", Value{55}}}},
+  {"!x && y",                                   {{"x", Value{true}}, {"y", Value{true}}}},
+  {"x && y",                                    {{"x", Value{false}}}},
+  {"x && y",                                    {{"x", Value{true}}, {"y", Value{false}}}},
+  {"x && y",                                    {{"x", Value{true}}}},
+  {"x && y",                                    {{"y", Value{true}}}},
+  {"x && y",                                    {{"x", Value{1}}, {"y", Value{true}}}},
+  {"x || y",                                    {{"x", Value{true}}}},
+  {"x || y",                                    {{"x", Value{false}}, {"y", Value{2}}}},
+  {"x || y",                                    {{"x", Value{false}}, {"y", Value::Null}}},
+  {"false && [] < 1",                           {}},
+  {"true || [] < 1",                            {}},
+  {"true && [] < 1",                            {}},
+  {"false -> x[-1]",                            {}},
+  {"x -> 'asdf'",                               {{"x", Value{"true"}}}},
+  {"[1, 2, 3][1]",                              {}},
+  {"[1, 2, 3][x..]",                            {{"x", Value{1}}}},
+  {"[1, [2, 3, 4]][1][..0]",                    {}},
+  {"[1, 2, 3][[4, 5][..0][0] - 4]",             {}},
+  {"'test'[2..1]",                              {}},
+  {"{k1: 1, k2: [1, 2]}['k2'][1]",              {}},
+  {"{{}}",                                      {}},
+  {"{{ x == 1 -> 'a', x == 2 -> 'b', 'c' }}",   {{"x", Value{2}}}},
+  {"{{ x == 1 -> 'a', x == 2 -> 'b' }}",        {{"x", Value{3}}}},
+  {"{{ spawnflags & 2 -> { path: 'a.mdl', skin: spawnflags }, "
+     "{ path: 'b.mdl', frame: 1 } }}",          spawnflags(3)},
+  {"{{ spawnflags & 2 -> { path: 'a.mdl', skin: spawnflags }, "
+     "{ path: 'b.mdl', frame: 1 } }}",          spawnflags(1)},
+  {"x + 1",                                     {{"x", Value{ArrayType{}}}}},
+  {"~x",                                        {{"x", Value{"a"}}}},
+  }));
+  // clang-format on
+
+  CAPTURE(expression, variables);
+
+  const auto parsedExpression = IO::ELParser::parseStrict(expression);
+  const auto compiledExpression = parsedExpression.compile();
+  const auto context = EvaluationContext{VariableTable{variables}};
+
+  try
+  {
+    const auto expectedValue = parsedExpression.evaluate(context);
+    CHECK(compiledExpression.evaluate(context) == expectedValue);
+    CHECK(compiledExpression.evaluate(VariableTable{variables}) == expectedValue);
+  }
+  catch (const Exception&)
+  {
+    CHECK_THROWS_AS(compiledExpression.evaluate(context), Exception);
+  }
+}
 } // namespace EL
 } // namespace TrenchBroom
@@ -157,6 +157,58 @@ TEST_CASE("DiskTest.getDirectoryContents")
     }));
 }
 
+TEST_CASE("DiskTest.findAllItems")
+{
+  const auto env = makeTestEnvironment();
+
+  CHECK_THROWS_AS(Disk::findAllItems(Path("asdf/bleh"), true), FileSystemException);
+  CHECK_THROWS_AS(
+    Disk::findAllItems(env.dir() + Path("does/not/exist"), true), FileSystemException);
+
+  using Item = std::pair<Path, bool>;
+
+  CHECK(
+    Disk::findAllItems(env.dir(), false)
+    == std::vector<Item>{
+      {Path("anotherDir"), true},
+      {Path("dir1"), true},
+      {Path("dir2"), true},
+      {Path("test.txt"), false},
+      {Path("test2.map"), false},
+    });
+
+  CHECK(
+    Disk::findAllItems(env.dir(), true)
+    == std::vector<Item>{
+      {Path("anotherDir"), true},
+      {Path("anotherDir/subDirTest"), true},
+      {Path("anotherDir/subDirTest/test2.map"), false},
+      {Path("anotherDir/test3.map"), false},
+      {Path("dir1"), true},
+      {Path("dir2"), true},
+      {Path("test.txt"), false},
+      {Path("test2.map"), false},
+    });
+
+  SECTION("Changes to the directory are picked up")
+  {
+    Disk::createFile(env.dir() + Path("dir1/test4.map"), "");
+    Disk::deleteFile(env.dir() + Path("anotherDir/test3.map"));
+
+    CHECK(
+      Disk::findAllItems(env.dir() + Path("anotherDir"), true)
+      == std::vector<Item>{
+        {Path("subDirTest"), true},
+        {Path("subDirTest/test2.map"), false},
+      });
+    CHECK(
+      Disk::findAllItems(env.dir() + Path("dir1"), true)
+      == std::vector<Item>{
+        {Path("test4.map"), false},
+      });
+  }
+}
+
 TEST_CASE("DiskTest.openFile")
 {
   const auto env = makeTestEnvironment();
@@ -171,6 +223,24 @@ TEST_CASE("DiskTest.openFile")
   CHECK(Disk::openFile(env.dir() + Path("anotherDir/subDirTest/test2.map")) != nullptr);
 }
 
+TEST_CASE("DiskTest.createFileAtomically")
+{
+  const auto env = makeTestEnvironment();
+
+  SECTION("Creates missing directories")
+  {
+    Disk::createFileAtomically(env.dir() + Path("newDir/new.txt"), "new content");
+    CHECK(env.directoryExists(Path("newDir")));
+    CHECK(env.loadFile(Path("newDir/new.txt")) == "new content");
+  }
+
+  SECTION("Replaces an existing file")
+  {
+    Disk::createFileAtomically(env.dir() + Path("test.txt"), "other content");
+    CHECK(env.loadFile(Path("test.txt")) == "other content");
+  }
+}
+
 TEST_CASE("DiskTest.resolvePath")
 {
   const auto env = makeTestEnvironment();
@@ -21,17 +21,22 @@
 #include "Assets/EntityDefinitionTestUtils.h"
 #include "Assets/PropertyDefinition.h"
 #include "IO/DiskIO.h"
+#include "IO/EntityDefinitionCache.h"
+#include "IO/EntityDefinitionClassInfo.h"
 #include "IO/FgdParser.h"
 #include "IO/File.h"
 #include "IO/FileMatcher.h"
 #include "IO/Path.h"
 #include "IO/Reader.h"
+#include "IO/TestEnvironment.h"
 #include "IO/TestParserStatus.h"
 
 #include <kdl/vector_utils.h>
 
 #include <algorithm>
+#include <sstream>
 #include <string>
+#include <typeinfo>
 
 #include "Catch2.h"
 
@@ -1078,6 +1083,30 @@ TEST_CASE("FgdParserTest.parseRecursiveInclude")
   kdl::vec_clear_and_delete(defs);
 }
 
+TEST_CASE("FgdParserTest.parseMissingInclude")
+{
+  auto env = TestEnvironment{[](TestEnvironment& e) {
+    e.createFile(
+      Path{"host.fgd"}, R"(@include "missing.fgd"
+@SolidClass = worldspawn : "World entity" [])");
+  }};
+
+  const auto path = env.dir() + Path{"host.fgd"};
+  auto file = Disk::openFile(path);
+  auto reader = file->reader().buffer();
+
+  const Color defaultColor(1.0f, 1.0f, 1.0f, 1.0f);
+  FgdParser parser(reader.stringView(), defaultColor, file->path());
+
+  TestParserStatus status;
+  const auto classInfos = parser.parseClassInfos(status);
+  CHECK(classInfos.size() == 1u);
+  CHECK(parser.includedFiles().empty());
+  CHECK(
+    parser.missingIncludedFiles()
+    == std::vector<Path>{env.dir() + Path{"missing.fgd"}});
+}
+
 TEST_CASE("FgdParserTest.parseStringContinuations")
 {
   const std::string file =
@@ -1103,5 +1132,91 @@ TEST_CASE("FgdParserTest.parseStringContinuations")
 
   kdl::vec_clear_and_delete(definitions);
 }
+
+TEST_CASE("FgdParserTest.entityDefinitionCache")
+{
+  const std::string file = R"(
+@baseclass color(255 0 0) size(-8 -8 -24, 8 8 32) = Base
+[
+  targetname(target_source) : "Name"
+  target(target_destination) : "Target"
+]
+@PointClass base(Base) model({ "path": "progs/player.mdl", "skin": 1, "scale": 0.5 }) =
+  info_player_start : "Player start"
+[
+  angle(integer) : "Angle" : 90
+  message(string) : "Message" : "hello"
+  speed(float) : "Speed" : "1.5"
+  style(choices) : "Style" : 1 =
+  [
+    0 : "Normal"
+    1 : "Flicker"
+  ]
+  spawnflags(flags) =
+  [
+    1 : "Silent" : 1
+    4 : "Loud" : 0
+  ]
+  custom(custom) : "Custom" : "value"
+]
+@SolidClass = func_door : "Door" []
+)";
+
+  const Color defaultColor(1.0f, 1.0f, 1.0f, 1.0f);
+  FgdParser parser(file, defaultColor);
+
+  TestParserStatus status;
+  const auto classInfos = parser.parseClassInfos(status);
+  REQUIRE(classInfos.size() == 3u);
+
+  const auto cache = EntityDefinitionCache{
+    {makeEntityDefinitionCacheKey(Path{"/defs/test.fgd"}, file)},
+    {Path{"/defs/missing.fgd"}},
+    classInfos,
+    {{LogLevel::Warn, "warning"}}};
+
+  auto stream = std::stringstream{};
+  REQUIRE(writeEntityDefinitionCache(stream, cache));
+  const auto buffer = stream.str();
+
+  const auto cached = readEntityDefinitionCache(buffer);
+  REQUIRE(cached.has_value());
+  CHECK(cached->keys == cache.keys);
+  CHECK(cached->missingFiles == cache.missingFiles);
+  CHECK(cached->messages == cache.messages);
+  REQUIRE(cached->classInfos.size() == classInfos.size());
+
+  for (size_t i = 0; i < classInfos.size(); ++i)
+  {
+    const auto& expected = classInfos[i];
+    const auto& actual = cached->classInfos[i];
+    CHECK(actual.type == expected.type);
+    CHECK(actual.line == expected.line);
+    CHECK(actual.column == expected.column);
+    CHECK(actual.name == expected.name);
+    CHECK(actual.description == expected.description);
+    CHECK(actual.color == expected.color);
+    CHECK(actual.size == expected.size);
+    CHECK(actual.modelDefinition == expected.modelDefinition);
+    CHECK(actual.superClasses == expected.superClasses);
+
+    REQUIRE(actual.propertyDefinitions.size() == expected.propertyDefinitions.size());
+    for (size_t j = 0; j < expected.propertyDefinitions.size(); ++j)
+    {
+      const auto& expectedDefinition = *expected.propertyDefinitions[j];
+      const auto& actualDefinition = *actual.propertyDefinitions[j];
+      CHECK(typeid(actualDefinition) == typeid(expectedDefinition));
+      CHECK(actualDefinition.equals(&expectedDefinition));
+      CHECK(actualDefinition.shortDescription() == expectedDefinition.shortDescription());
+      CHECK(actualDefinition.longDescription() == expectedDefinition.longDescription());
+      CHECK(actualDefinition.readOnly() == expectedDefinition.readOnly());
+      CHECK(
+        Assets::PropertyDefinition::defaultValue(actualDefinition)
+        == Assets::PropertyDefinition::defaultValue(expectedDefinition));
+    }
+  }
+
+  CHECK(readEntityDefinitionCache(buffer.substr(0, buffer.size() - 1u)) == std::nullopt);
+}
 } // namespace IO
 } // namespace TrenchBroom
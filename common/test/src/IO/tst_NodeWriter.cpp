@@ -47,6 +47,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "Catch2.h"
@@ -308,6 +309,74 @@ TEST_CASE("NodeWriterTest.writeWorldspawnWithBrushInDefaultLayer")
   CHECK(actual == expected);
 }
 
+TEST_CASE("NodeWriterTest.writeMapSetsFilePositions")
+{
+  const vm::bbox3 worldBounds(8192.0);
+
+  Model::WorldNode map({}, {}, Model::MapFormat::Standard);
+
+  Model::BrushBuilder builder(map.mapFormat(), worldBounds);
+  auto* worldBrushNode = new Model::BrushNode(builder.createCube(64.0, "none").value());
+  map.defaultLayer()->addChild(worldBrushNode);
+
+  auto* entityNode =
+    new Model::EntityNode(Model::Entity({}, {{"classname", "func_door"}}));
+  auto* entityBrushNode = new Model::BrushNode(builder.createCube(64.0, "none").value());
+  entityNode->addChild(entityBrushNode);
+  map.defaultLayer()->addChild(entityNode);
+
+  std::stringstream str;
+  NodeWriter writer(map, str);
+  writer.writeMap();
+
+  const std::string actual = str.str();
+  const std::string expected =
+    R"(// entity 0
+{
+"classname" "worldspawn"
+// brush 0
+{
+( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) none 0 0 0 1 1
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) none 0 0 0 1 1
+( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) none 0 0 0 1 1
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) none 0 0 0 1 1
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) none 0 0 0 1 1
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) none 0 0 0 1 1
+}
+}
+// entity 1
+{
+"classname" "func_door"
+// brush 0
+{
+( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) none 0 0 0 1 1
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) none 0 0 0 1 1
+( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) none 0 0 0 1 1
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) none 0 0 0 1 1
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) none 0 0 0 1 1
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) none 0 0 0 1 1
+}
+}
+)";
+  CHECK(actual == expected);
+
+  CHECK(map.lineNumber() == 2u);
+  CHECK(map.containsLine(13u));
+  CHECK(!map.containsLine(14u));
+
+  CHECK(worldBrushNode->lineNumber() == 5u);
+  CHECK(worldBrushNode->containsLine(12u));
+  CHECK(!worldBrushNode->containsLine(13u));
+
+  CHECK(entityNode->lineNumber() == 15u);
+  CHECK(entityNode->containsLine(26u));
+  CHECK(!entityNode->containsLine(27u));
+
+  CHECK(entityBrushNode->lineNumber() == 18u);
+  CHECK(entityBrushNode->containsLine(25u));
+  CHECK(!entityBrushNode->containsLine(26u));
+}
+
 TEST_CASE("NodeWriterTest.writeWorldspawnWithBrushInCustomLayer")
 {
   const vm::bbox3 worldBounds(8192.0);
@@ -1186,6 +1255,88 @@ TEST_CASE("NodeWriterTest.writeSmallValuesWithoutScientificNotation")
   CHECK(actual == expected);
 }
 
+TEST_CASE("NodeWriterTest.writeValuesLikeFmt")
+{
+  const vm::bbox3 worldBounds(8192.0);
+
+  Model::WorldNode map({}, {}, Model::MapFormat::Standard);
+
+  Model::BrushBuilder builder(map.mapFormat(), worldBounds);
+  auto brush = builder.createCube(64.0, "defaultTexture").value();
+
+  auto& face = brush.face(0);
+  auto faceAttributes = face.attributes();
+  faceAttributes.setXOffset(12.75f);
+  faceAttributes.setYOffset(1e16f);
+  faceAttributes.setRotation(-123456.0f);
+  faceAttributes.setXScale(0.1f);
+  faceAttributes.setYScale(-2.5f);
+  face.setAttributes(std::move(faceAttributes));
+
+  // integral values around 2^24, beyond which not all digits of a float are needed
+  auto& otherFace = brush.face(1);
+  auto otherFaceAttributes = otherFace.attributes();
+  otherFaceAttributes.setXOffset(123456792.0f);
+  otherFaceAttributes.setYOffset(1e14f);
+  otherFaceAttributes.setRotation(16777216.0f);
+  otherFaceAttributes.setXScale(16777215.0f);
+  otherFaceAttributes.setYScale(-16777218.0f);
+  otherFace.setAttributes(std::move(otherFaceAttributes));
+
+  std::stringstream str;
+  NodeWriter writer(map, str);
+  writer.writeBrushFaces({brush.face(0), brush.face(1)});
+
+  const std::string actual = str.str();
+  const std::string expected =
+    R"(( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) defaultTexture 12.75 1e+16 -123456 0.1 -2.5
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) defaultTexture 123456790 100000000000000 16777216 16777215 -16777218
+)";
+  CHECK(actual == expected);
+}
+
+TEST_CASE("NodeWriterTest.writePointsRoundTrip")
+{
+  const vm::bbox3 worldBounds(8192.0);
+
+  Model::WorldNode map({}, {}, Model::MapFormat::Standard);
+
+  Model::BrushBuilder builder(map.mapFormat(), worldBounds);
+  auto brush = builder.createCube(64.0, "defaultTexture").value();
+  REQUIRE(brush
+            .transform(
+              worldBounds,
+              vm::rotation_matrix(
+                vm::to_radians(15.0), vm::to_radians(22.0), vm::to_radians(89.0)),
+              false)
+            .is_success());
+
+  std::stringstream str;
+  NodeWriter writer(map, str);
+  writer.writeBrushFaces(brush.faces());
+
+  for (const auto& face : brush.faces())
+  {
+    std::string line;
+    REQUIRE(std::getline(str, line));
+
+    std::stringstream lineStr(line);
+    for (const auto& point : face.points())
+    {
+      std::string token;
+      lineStr >> token;
+      CHECK(token == "(");
+      for (size_t i = 0; i < 3; ++i)
+      {
+        lineStr >> token;
+        CHECK(std::stod(token) == point[i]);
+      }
+      lineStr >> token;
+      CHECK(token == ")");
+    }
+  }
+}
+
 TEST_CASE("NodeWriterTest.quoteTextureNamesIfNecessary")
 {
   using FormatInfo = std::tuple<Model::MapFormat, std::string>;
@@ -22,10 +22,17 @@
 #include "IO/DiskIO.h"
 #include "IO/FileMatcher.h"
 #include "IO/Path.h"
+#include "IO/Quake3ShaderCache.h"
 #include "IO/Quake3ShaderFileSystem.h"
+#include "IO/TestEnvironment.h"
 #include "Logger.h"
+#include "TestLogger.h"
 
 #include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -92,5 +99,159 @@ TEST_CASE("Quake3ShaderFileSystemTest.testSkipMalformedFiles")
       texturePrefix + Path("test/not_existing2"),
     }));
 }
+
+TEST_CASE("Quake3ShaderFileSystemTest.shaderCache")
+{
+  auto shader = Assets::Quake3Shader();
+  shader.shaderPath = Path{"textures/test/shader"};
+  shader.editorImage = Path{"textures/test/editor_image.tga"};
+  shader.lightImage = Path{"textures/test/light_image.tga"};
+  shader.culling = Assets::Quake3Shader::Culling::None;
+  shader.surfaceParms = {"trans", "nonsolid"};
+
+  auto& stage = shader.addStage();
+  stage.map = Path{"textures/test/stage.tga"};
+  stage.blendFunc.srcFactor = Assets::Quake3ShaderStage::BlendFunc::One;
+  stage.blendFunc.destFactor = Assets::Quake3ShaderStage::BlendFunc::OneMinusSrcAlpha;
+
+  const auto entries = std::vector<Quake3ShaderCacheEntry>{
+    {Path{"scripts/test.shader"},
+     makeQuake3ShaderCacheKey("source"),
+     std::vector<Assets::Quake3Shader>{shader, Assets::Quake3Shader()},
+     {{LogLevel::Warn, "Unknown blendFunc source factor 'GL_FOO'"}},
+     ""},
+    {Path{"scripts/empty.shader"},
+     makeQuake3ShaderCacheKey(""),
+     std::vector<Assets::Quake3Shader>{},
+     {},
+     ""},
+    {Path{"scripts/malformed.shader"},
+     makeQuake3ShaderCacheKey("{"),
+     std::nullopt,
+     {},
+     "Unexpected token"},
+  };
+
+  auto stream = std::stringstream{};
+  writeQuake3ShaderCache(stream, entries);
+  const auto cache = stream.str();
+
+  SECTION("Reading a cache yields the written entries")
+  {
+    const auto readEntries = readQuake3ShaderCache(cache);
+    REQUIRE(readEntries.has_value());
+    REQUIRE(readEntries->size() == entries.size());
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+      CHECK((*readEntries)[i].path == entries[i].path);
+      CHECK((*readEntries)[i].key == entries[i].key);
+      CHECK((*readEntries)[i].shaders == entries[i].shaders);
+      CHECK((*readEntries)[i].messages == entries[i].messages);
+      CHECK((*readEntries)[i].error == entries[i].error);
+    }
+  }
+
+  SECTION("Reading a truncated cache fails")
+  {
+    CHECK(readQuake3ShaderCache(cache.substr(0, cache.size() - 1)) == std::nullopt);
+  }
+
+  SECTION("Different sources have different keys")
+  {
+    CHECK(makeQuake3ShaderCacheKey("source") != makeQuake3ShaderCacheKey("sourcf"));
+  }
+}
+
+TEST_CASE("Quake3ShaderFileSystemTest.loadShadersUsingCache")
+{
+  NullLogger logger;
+
+  auto env = TestEnvironment{[](TestEnvironment& e) {
+    e.createDirectory(Path{"scripts"});
+    e.createFile(Path{"scripts/test.shader"}, R"(
+textures/test/shader1
+{
+    qer_editorimage textures/test/editor_image1.tga
+}
+)");
+  }};
+
+  const auto cachePath = env.dir() + Path{"cache/shaders.cache"};
+  const auto texturePrefix = Path{"textures"};
+
+  const auto findShaders = [&]() {
+    auto diskFS = std::make_shared<DiskFileSystem>(env.dir());
+    auto fs = Quake3ShaderFileSystem{
+      diskFS, Path{"scripts"}, std::vector<Path>{texturePrefix}, logger, cachePath};
+    return fs.findItems(texturePrefix + Path{"test"}, FileExtensionMatcher{""});
+  };
+
+  const auto expectedShaders = std::vector<Path>{texturePrefix + Path{"test/shader1"}};
+  CHECK_THAT(findShaders(), Catch::UnorderedEquals(expectedShaders));
+  CHECK(env.fileExists(Path{"cache/shaders.cache"}));
+
+  // loading again uses the cache
+  CHECK_THAT(findShaders(), Catch::UnorderedEquals(expectedShaders));
+
+  // changing a script invalidates its cache entry
+  env.createFile(Path{"scripts/test.shader"}, R"(
+textures/test/shader1
+{
+    qer_editorimage textures/test/editor_image1.tga
+}
+
+textures/test/shader2
+{
+    qer_editorimage textures/test/editor_image2.tga
+}
+)");
+
+  CHECK_THAT(
+    findShaders(),
+    Catch::UnorderedEquals(std::vector<Path>{
+      texturePrefix + Path{"test/shader1"},
+      texturePrefix + Path{"test/shader2"},
+    }));
+}
+
+TEST_CASE("Quake3ShaderFileSystemTest.loadShadersWithWarningsUsingCache")
+{
+  auto env = TestEnvironment{[](TestEnvironment& e) {
+    e.createDirectory(Path{"scripts"});
+    e.createFile(Path{"scripts/test.shader"}, R"(
+textures/test/shader1
+{
+    {
+        map textures/test/stage.tga
+        blendFunc GL_FOO GL_ZERO
+    }
+}
+)");
+  }};
+
+  const auto cachePath = env.dir() + Path{"cache/shaders.cache"};
+  const auto texturePrefix = Path{"textures"};
+
+  const auto loadShaders = [&]() {
+    auto logger = TestLogger{};
+    auto diskFS = std::make_shared<DiskFileSystem>(env.dir());
+    auto fs = Quake3ShaderFileSystem{
+      diskFS, Path{"scripts"}, std::vector<Path>{texturePrefix}, logger, cachePath};
+    return logger.countMessages(LogLevel::Warn);
+  };
+
+  CHECK(loadShaders() == 1u);
+
+  // the script is cached along with its messages
+  const auto entries = readQuake3ShaderCache(env.loadFile(Path{"cache/shaders.cache"}));
+  REQUIRE(entries.has_value());
+  REQUIRE(entries->size() == 1u);
+  CHECK(entries->front().shaders.has_value());
+  CHECK(entries->front().messages.size() == 1u);
+
+  // loading again replays the cached messages
+  CHECK(loadShaders() == 1u);
+}
 } // namespace IO
 } // namespace TrenchBroom
@@ -20,7 +20,13 @@
 #include "IO/Token.h"
 #include "IO/Tokenizer.h"
 
+#include <kdl/string_utils.h>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
 #include <string>
+#include <vector>
 
 #include <vecmath/approx.h>
 
@@ -273,5 +279,106 @@ TEST_CASE("TokenizerTest.simpleLanguageBlockWithNegativeDecimalAttribute")
   CHECK((token = tokenizer.nextToken()).type() == SimpleToken::CBrace);
   CHECK(tokenizer.nextToken().type() == SimpleToken::Eof);
 }
+
+namespace
+{
+using TestToken = TokenTemplate<SimpleToken::Type>;
+
+TestToken makeToken(const std::string& str)
+{
+  return TestToken{SimpleToken::String, str.data(), str.data() + str.size(), 0, 0, 0};
+}
+
+std::vector<std::string> makeRandomNumberStrings()
+{
+  auto randEngine = std::mt19937{};
+  auto result = std::vector<std::string>{};
+
+  // random sequences of characters that can occur in number tokens
+  const auto chars = std::string{"0123456789+-.e"};
+  auto charDist = std::uniform_int_distribution<size_t>{0, chars.size() - 1};
+  auto lengthDist = std::uniform_int_distribution<size_t>{0, 30};
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    auto str = std::string{};
+    const auto length = lengthDist(randEngine);
+    for (size_t j = 0; j < length; ++j)
+    {
+      str.push_back(chars[charDist(randEngine)]);
+    }
+    result.push_back(std::move(str));
+  }
+
+  // well formed numbers as they occur in map files
+  auto valueDist = std::uniform_real_distribution<double>{-65536.0, 65536.0};
+  auto precisionDist = std::uniform_int_distribution<int>{0, 25};
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    const auto value = valueDist(randEngine);
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.*f", precisionDist(randEngine), value);
+    result.emplace_back(buffer);
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    result.emplace_back(buffer);
+    std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value));
+    result.emplace_back(buffer);
+  }
+
+  // numbers with many digits
+  for (const auto& str : std::vector<std::string>{
+         "9007199254740992",
+         "9007199254740993",
+         "-9007199254740993.5",
+         "0.30000000000000004",
+         "123456789.123456789012345",
+         "0.0000000000000000000001",
+         "0.00000000000000000000001",
+         "999999999",
+         "1000000000",
+         "-2147483648",
+         "2147483648",
+         "-0",
+         "+0",
+         "-0.0",
+         "."})
+  {
+    result.push_back(str);
+  }
+
+  return result;
+}
+
+bool isSameValue(const double lhs, const double rhs)
+{
+  return lhs == rhs && std::signbit(lhs) == std::signbit(rhs);
+}
+} // namespace
+
+TEST_CASE("TokenizerTest.toFloatMatchesStrToDouble")
+{
+  for (const auto& str : makeRandomNumberStrings())
+  {
+    CAPTURE(str);
+
+    const auto expected = kdl::str_to_double(str).value_or(0.0);
+    const auto token = makeToken(str);
+    CHECK(isSameValue(token.toFloat<double>(), expected));
+    CHECK(isSameValue(
+      static_cast<double>(token.toFloat<float>()), static_cast<double>(float(expected))));
+  }
+}
+
+TEST_CASE("TokenizerTest.toIntegerMatchesStrToLong")
+{
+  for (const auto& str : makeRandomNumberStrings())
+  {
+    CAPTURE(str);
+
+    const auto expected = kdl::str_to_long(str).value_or(0l);
+    const auto token = makeToken(str);
+    CHECK(token.toInteger<long>() == expected);
+    CHECK(token.toInteger<int>() == static_cast<int>(expected));
+  }
+}
 } // namespace IO
 } // namespace TrenchBroom
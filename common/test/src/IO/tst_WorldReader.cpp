@@ -17,10 +17,13 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "Exceptions.h"
 #include "IO/DiskIO.h"
 #include "IO/File.h"
+#include "IO/NodeWriter.h"
 #include "IO/TestParserStatus.h"
 #include "IO/WorldReader.h"
+#include "Logger.h"
 #include "Model/BezierPatch.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushFaceAttributes.h"
@@ -39,7 +42,9 @@
 
 #include <fmt/format.h>
 
+#include <sstream>
 #include <string>
+#include <tuple>
 
 #include "Catch2.h"
 #include "TestUtils.h"
@@ -1948,5 +1953,207 @@ TEST_CASE("WorldReaderTest.parseUnknownFormatEmptyMap")
   REQUIRE(world != nullptr);
   CHECK(world->mapFormat() == Model::MapFormat::Standard);
 }
+
+namespace
+{
+std::string writeWorld(const Model::WorldNode& world)
+{
+  auto str = std::stringstream{};
+  auto writer = NodeWriter{world, str};
+  writer.writeMap();
+  return str.str();
+}
+
+std::vector<size_t> collectLineNumbers(const Model::Node& node)
+{
+  auto result = std::vector<size_t>{};
+  node.visitChildren(
+    [&](const Model::Node* child) {
+      result.push_back(child->lineNumber());
+      const auto childPositions = collectLineNumbers(*child);
+      result.insert(result.end(), childPositions.begin(), childPositions.end());
+    });
+  return result;
+}
+} // namespace
+
+TEST_CASE("WorldReaderTest.readFromCache")
+{
+  using MapInfo = std::tuple<Model::MapFormat, std::string>;
+
+  // clang-format off
+  const auto [mapFormat, data] = GENERATE(values<MapInfo>({
+  {Model::MapFormat::Quake2, R"(
+{
+"classname" "worldspawn"
+"message" "a map"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) none 0 0 0 1 1 1 2 3
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) none 0 0 0 1 1
+}
+}
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_name" "My Layer"
+"_tb_id" "1"
+"_tb_layer_sort_index" "0"
+}
+{
+"classname" "func_group"
+"_tb_type" "_tb_group"
+"_tb_name" "My Group"
+"_tb_id" "2"
+"_tb_layer" "1"
+{
+( -800 288 1024 ) ( -736 288 1024 ) ( -736 224 1024 ) rtz/c_mf_v3c 56 -32 0 1 1
+( -800 288 1024 ) ( -800 224 1024 ) ( -800 224 576 ) rtz/c_mf_v3c 56 -32 0 1 1
+( -736 224 1024 ) ( -736 288 1024 ) ( -736 288 576 ) rtz/c_mf_v3c 56 -32 0 1 1
+( -736 288 1024 ) ( -800 288 1024 ) ( -800 288 576 ) rtz/c_mf_v3c 56 -32 0 1 1
+( -800 224 1024 ) ( -736 224 1024 ) ( -736 224 576 ) rtz/c_mf_v3c 56 -32 0 1 1
+( -800 224 576 ) ( -736 224 576 ) ( -736 288 576 ) rtz/c_mf_v3c 56 -32 0 1 1
+}
+}
+{
+"classname" "func_door"
+"_tb_group" "2"
+{
+( -800 288 1024 ) ( -736 288 1024 ) ( -736 224 1024 ) rtz/c_mf_v3c 56 -32 15 0.5 2
+( -800 288 1024 ) ( -800 224 1024 ) ( -800 224 576 ) rtz/c_mf_v3c 56 -32 0 1 1
+( -736 224 1024 ) ( -736 288 1024 ) ( -736 288 576 ) rtz/c_mf_v3c 56 -32 0 1 1
+( -736 288 1024 ) ( -800 288 1024 ) ( -800 288 576 ) rtz/c_mf_v3c 56 -32 0 1 1
+( -800 224 1024 ) ( -736 224 1024 ) ( -736 224 576 ) rtz/c_mf_v3c 56 -32 0 1 1
+( -800 224 576 ) ( -736 224 576 ) ( -736 288 576 ) rtz/c_mf_v3c 56 -32 0 1 1
+}
+})"},
+  {Model::MapFormat::Valve, R"(
+{
+"classname" "worldspawn"
+"mapversion" "220"
+{
+( -800 288 1024 ) ( -736 288 1024 ) ( -736 224 1024 ) rtz/c_mf_v3c [ 1 0 0 -0 ] [ 0 -1 0 0 ] 0 1 1
+( -800 288 1024 ) ( -800 224 1024 ) ( -800 224 576 ) rtz/c_mf_v3c [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -736 224 1024 ) ( -736 288 1024 ) ( -736 288 576 ) rtz/c_mf_v3c [ 0 -1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -736 288 1024 ) ( -800 288 1024 ) ( -800 288 576 ) rtz/c_mf_v3c [ 0.7071 0.7071 0 12.5 ] [ 0 0 -1 0 ] 45 1 1
+( -800 224 1024 ) ( -736 224 1024 ) ( -736 224 576 ) rtz/c_mf_v3c [ 1 0 0 -0 ] [ 0 0 -1 0 ] 0 1 1
+( -800 224 576 ) ( -736 224 576 ) ( -736 288 576 ) rtz/c_mf_v3c [ -1 0 0 -0 ] [ 0 -1 0 0 ] 0 1 1
+}
+}
+{
+"classname" "info_player_start"
+"origin" "32 32 24"
+})"},
+  {Model::MapFormat::Quake3, R"(
+{
+"classname" "worldspawn"
+{
+patchDef2
+{
+common/caulk
+( 3 3 0 0 0 )
+(
+( (-64 -64 4 0   0 ) (-64 0 4 0   -0.25 ) (-64 64 4 0   -0.5 ) )
+( (  0 -64 4 0.2 0 ) (  0 0 4 0.2 -0.25 ) (  0 64 4 0.2 -0.5 ) )
+( ( 64 -64 4 0.4 0 ) ( 64 0 4 0.4 -0.25 ) ( 64 64 4 0.4 -0.5 ) )
+)
+}
+}
+})"},
+  }));
+  // clang-format on
+
+  const auto worldBounds = vm::bbox3{8192.0};
+  auto status = TestParserStatus{};
+
+  auto cacheStream = std::stringstream{};
+  auto reader = WorldReader{data, mapFormat, {}};
+  const auto expectedWorld = reader.read(worldBounds, cacheStream, status);
+  const auto cache = cacheStream.str();
+
+  SECTION("Reading from an up to date cache yields the same world")
+  {
+    auto cacheReader = WorldReader{data, mapFormat, {}};
+    const auto world = cacheReader.readFromCache(cache, worldBounds, status);
+    REQUIRE(world != nullptr);
+
+    CHECK(writeWorld(*world) == writeWorld(*expectedWorld));
+    CHECK(collectLineNumbers(*world) == collectLineNumbers(*expectedWorld));
+  }
+
+  SECTION("A cache created from a different string is not used")
+  {
+    const auto changedData = data + "\n";
+    auto cacheReader = WorldReader{changedData, mapFormat, {}};
+    CHECK(cacheReader.readFromCache(cache, worldBounds, status) == nullptr);
+
+    const auto world = cacheReader.read(worldBounds, status);
+    CHECK(writeWorld(*world) == writeWorld(*expectedWorld));
+  }
+
+  SECTION("A cache created for a different map format is not used")
+  {
+    auto cacheReader = WorldReader{data, Model::MapFormat::Quake3_Legacy, {}};
+    CHECK(cacheReader.readFromCache(cache, worldBounds, status) == nullptr);
+  }
+
+  SECTION("A truncated cache is not used")
+  {
+    const auto truncatedCache = cache.substr(0, cache.size() - 1u);
+    auto cacheReader = WorldReader{data, mapFormat, {}};
+    CHECK(cacheReader.readFromCache(truncatedCache, worldBounds, status) == nullptr);
+  }
+}
+
+TEST_CASE("WorldReaderTest.readFromCacheLogsParserMessages")
+{
+  const auto data = R"(
+{
+"classname" "worldspawn"
+"message" "a map"
+"message" "a duplicate"
+})";
+
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto cacheStream = std::stringstream{};
+  auto status = TestParserStatus{};
+  auto reader = WorldReader{data, Model::MapFormat::Standard, {}};
+  reader.read(worldBounds, cacheStream, status);
+  REQUIRE(status.countStatus(LogLevel::Warn) == 1u);
+
+  auto cacheStatus = TestParserStatus{};
+  auto cacheReader = WorldReader{data, Model::MapFormat::Standard, {}};
+  const auto cache = cacheStream.str();
+  CHECK(cacheReader.readFromCache(cache, worldBounds, cacheStatus) != nullptr);
+  CHECK(cacheStatus.messages(LogLevel::Warn) == status.messages(LogLevel::Warn));
+}
+
+TEST_CASE("WorldReaderTest.readWithCacheFails")
+{
+  const auto data = R"(
+{
+"classname" "worldspawn"
+"message" "a map"
+"message" "a duplicate"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) none 0 0
+})";
+
+  const auto worldBounds = vm::bbox3{8192.0};
+
+  auto cacheStream = std::stringstream{};
+  auto status = TestParserStatus{};
+  auto reader = WorldReader{data, Model::MapFormat::Standard, {}};
+  CHECK_THROWS_AS(reader.read(worldBounds, cacheStream, status), ParserException);
+
+  // nothing is written, but the messages logged before parsing failed are kept
+  CHECK(cacheStream.str().empty());
+  CHECK(status.countStatus(LogLevel::Warn) == 1u);
+}
+
 } // namespace IO
 } // namespace TrenchBroom
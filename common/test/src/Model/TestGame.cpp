@@ -142,16 +142,20 @@ std::unique_ptr<WorldNode> TestGame::doLoadMap(
 
 void TestGame::doWriteMap(WorldNode& world, const IO::Path& path) const
 {
-  const auto mapFormatName = formatName(world.mapFormat());
-
   std::ofstream file = openPathAsOutputStream(path);
   if (!file)
   {
     throw FileSystemException("Cannot open file: " + path.asString());
   }
-  IO::writeGameComment(file, gameName(), mapFormatName);
+  doWriteMap(world, file);
+}
 
-  IO::NodeWriter writer(world, file);
+void TestGame::doWriteMap(WorldNode& world, std::ostream& stream) const
+{
+  const auto mapFormatName = formatName(world.mapFormat());
+  IO::writeGameComment(stream, gameName(), mapFormatName);
+
+  IO::NodeWriter writer(world, stream);
   writer.writeMap();
 }
 
@@ -2410,6 +2410,42 @@ TEST_CASE("BrushTest.subtractDisjoint")
     subtraction.vertexPositions(), Catch::UnorderedEquals(brush1.vertexPositions()));
 }
 
+TEST_CASE("BrushTest.subtractMultipleFromCorners")
+{
+  const vm::bbox3 worldBounds(4096.0);
+
+  const vm::bbox3 minuendBounds(vm::vec3::fill(-32.0), vm::vec3::fill(+32.0));
+  const vm::bbox3 subtrahend1Bounds(vm::vec3::fill(-40.0), vm::vec3::fill(-24.0));
+  const vm::bbox3 subtrahend2Bounds(vm::vec3::fill(+24.0), vm::vec3::fill(+40.0));
+  const vm::bbox3 subtrahend3Bounds(vm::vec3::fill(+64.0), vm::vec3::fill(+72.0));
+
+  BrushBuilder builder(MapFormat::Standard, worldBounds);
+  const Brush minuend = builder.createCuboid(minuendBounds, "texture").value();
+  const Brush subtrahend1 = builder.createCuboid(subtrahend1Bounds, "texture").value();
+  const Brush subtrahend2 = builder.createCuboid(subtrahend2Bounds, "texture").value();
+  const Brush subtrahend3 = builder.createCuboid(subtrahend3Bounds, "texture").value();
+
+  const auto result = kdl::collect_values(
+    minuend.subtract(
+      MapFormat::Standard,
+      worldBounds,
+      "texture",
+      {&subtrahend1, &subtrahend2, &subtrahend3}),
+    [](const auto&) {});
+  REQUIRE_FALSE(result.empty());
+
+  // all fragments are cuboids, so their volumes add up to the volume of the result
+  auto volume = 0.0;
+  for (const auto& fragment : result)
+  {
+    CHECK(minuendBounds.contains(fragment.bounds()));
+
+    const auto size = fragment.bounds().size();
+    volume += size.x() * size.y() * size.z();
+  }
+  CHECK(volume == 64.0 * 64.0 * 64.0 - 2.0 * 8.0 * 8.0 * 8.0);
+}
+
 TEST_CASE("BrushTest.subtractEnclosed")
 {
   const vm::bbox3 worldBounds(4096.0);
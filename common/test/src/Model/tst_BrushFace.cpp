@@ -86,6 +86,55 @@ TEST_CASE("BrushFaceTest.constructWithColinearPoints")
       .is_success());
 }
 
+TEST_CASE("BrushFaceTest.shareAttributes")
+{
+  const vm::vec3 p0(0.0, 0.0, 4.0);
+  const vm::vec3 p1(1.0, 0.0, 4.0);
+  const vm::vec3 p2(0.0, -1.0, 4.0);
+
+  const BrushFaceAttributes attribs("some_texture");
+  const BrushFace face =
+    BrushFace::create(
+      p0, p1, p2, attribs, std::make_unique<ParaxialTexCoordSystem>(p0, p1, p2, attribs))
+      .value();
+
+  auto copy = face;
+  CHECK(&copy.attributes() == &face.attributes());
+
+  SECTION("Transforming a copy without changing its attributes keeps sharing them")
+  {
+    const auto translation = vm::translation_matrix(vm::vec3(16.0, 0.0, 0.0));
+    REQUIRE(copy.transform(translation, false).is_success());
+    CHECK(&copy.attributes() == &face.attributes());
+  }
+
+  SECTION("Setting equal attributes keeps sharing them")
+  {
+    copy.setAttributes(attribs);
+    CHECK(&copy.attributes() == &face.attributes());
+  }
+
+  SECTION("Changing the attributes of a copy does not change the original")
+  {
+    auto newAttribs = attribs;
+    newAttribs.setXOffset(8.0f);
+    copy.setAttributes(newAttribs);
+
+    CHECK(&copy.attributes() != &face.attributes());
+    CHECK(copy.attributes().xOffset() == 8.0f);
+    CHECK(face.attributes().xOffset() == 0.0f);
+  }
+
+  SECTION("Flipping the texture of a copy does not change the original")
+  {
+    copy.flipTexture(vm::vec3::pos_z(), vm::vec3::pos_x(), vm::direction::left);
+
+    CHECK(&copy.attributes() != &face.attributes());
+    CHECK(copy.attributes() != face.attributes());
+    CHECK(face.attributes() == attribs);
+  }
+}
+
 TEST_CASE("BrushFaceTest.textureUsageCount")
 {
   const vm::vec3 p0(0.0, 0.0, 4.0);
@@ -17,13 +17,19 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "Assets/EntityDefinition.h"
 #include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
+#include "Color.h"
 #include "IO/DiskIO.h"
+#include "IO/EntityDefinitionCache.h"
+#include "IO/FgdParser.h"
 #include "IO/GameConfigParser.h"
 #include "IO/IOUtils.h"
 #include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TestParserStatus.h"
 #include "Logger.h"
 #include "Model/EntityNode.h"
 #include "Model/GameConfig.h"
@@ -31,6 +37,10 @@
 
 #include <kdl/vector_utils.h>
 
+#include <fstream>
+#include <string>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace TrenchBroom
@@ -180,5 +190,89 @@ TEST_CASE("GameTest.loadQuake3Shaders")
       "skies/hub1/dusk",
     }));
 }
+
+TEST_CASE("GameTest.loadEntityDefinitionsUsingCache")
+{
+  const auto hostSource = std::string{R"(@include "included.fgd"
+@SolidClass = worldspawn : "World entity" [])"};
+
+  auto env = IO::TestEnvironment{[&](IO::TestEnvironment& e) {
+    e.createFile(IO::Path{"host.fgd"}, hostSource);
+  }};
+
+  const auto path = env.dir() + IO::Path{"host.fgd"};
+  const auto cachePath = IO::entityDefinitionCachePath(path);
+
+  const auto configPath = IO::Disk::getCurrentWorkingDir()
+                          + IO::Path("fixture/games/Quake/GameConfig.cfg");
+  const auto configStr = IO::Disk::readTextFile(configPath);
+  auto configParser = IO::GameConfigParser(configStr, configPath);
+  auto config = configParser.parse();
+
+  auto logger = NullLogger();
+  auto game = GameImpl(config, env.dir(), logger);
+
+  const auto loadDefinitionNames = [&]() {
+    auto status = IO::TestParserStatus{};
+    auto definitions = game.loadEntityDefinitions(status, path);
+    const auto names = kdl::vec_transform(
+      definitions, [](const auto* definition) { return definition->name(); });
+    kdl::vec_clear_and_delete(definitions);
+    return names;
+  };
+
+  CHECK_THAT(
+    loadDefinitionNames(),
+    Catch::UnorderedEquals(std::vector<std::string>{"worldspawn"}));
+  CHECK(IO::Disk::fileExists(cachePath));
+
+  SECTION("An up to date cache is used")
+  {
+    // replace the cache with one that matches the files, but contains other class infos
+    const auto source = R"(@PointClass = info_player_start : "Start" [])";
+    auto parser = IO::FgdParser{source, Color{1.0f, 1.0f, 1.0f, 1.0f}};
+    auto status = IO::TestParserStatus{};
+    const auto cache = IO::EntityDefinitionCache{
+      {IO::makeEntityDefinitionCacheKey(path, hostSource)},
+      {env.dir() + IO::Path{"included.fgd"}},
+      parser.parseClassInfos(status),
+      {}};
+
+    auto stream = IO::openPathAsOutputStream(cachePath, std::ios::out | std::ios::binary);
+    REQUIRE(IO::writeEntityDefinitionCache(stream, cache));
+    stream.close();
+
+    CHECK_THAT(
+      loadDefinitionNames(),
+      Catch::UnorderedEquals(std::vector<std::string>{"info_player_start"}));
+  }
+
+  SECTION("Adding or changing an included file invalidates the cache")
+  {
+    env.createFile(
+      IO::Path{"included.fgd"}, R"(@PointClass = info_player_start : "Start" [])");
+    CHECK_THAT(
+      loadDefinitionNames(),
+      Catch::UnorderedEquals(
+        std::vector<std::string>{"info_player_start", "worldspawn"}));
+
+    env.createFile(
+      IO::Path{"included.fgd"}, R"(@PointClass = info_player_coop : "Coop start" [])");
+    CHECK_THAT(
+      loadDefinitionNames(),
+      Catch::UnorderedEquals(std::vector<std::string>{"info_player_coop", "worldspawn"}));
+  }
+
+  SECTION("Changing the entity definition file invalidates the cache")
+  {
+    env.createFile(IO::Path{"host.fgd"}, hostSource + R"(
+@SolidClass = func_door : "Door" [])");
+    CHECK_THAT(
+      loadDefinitionNames(),
+      Catch::UnorderedEquals(std::vector<std::string>{"worldspawn", "func_door"}));
+  }
+
+  IO::Disk::deleteFile(cachePath);
+}
 } // namespace Model
 } // namespace TrenchBroom
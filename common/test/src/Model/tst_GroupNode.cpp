@@ -238,6 +238,45 @@ TEST_CASE("GroupNodeTest.updateLinkedGroups")
       })
       .or_else([](const auto&) { FAIL(); });
   }
+
+  SECTION("Update multiple target groups")
+  {
+    auto untransformedGroupNode = std::unique_ptr<GroupNode>{
+      static_cast<GroupNode*>(groupNode.cloneRecursively(worldBounds))};
+    auto transformedGroupNode = std::unique_ptr<GroupNode>{
+      static_cast<GroupNode*>(groupNode.cloneRecursively(worldBounds))};
+    transformNode(
+      *transformedGroupNode,
+      vm::translation_matrix(vm::vec3(0.0, 2.0, 0.0)),
+      worldBounds);
+
+    transformNode(
+      *entityNode, vm::translation_matrix(vm::vec3(0.0, 0.0, 3.0)), worldBounds);
+    REQUIRE(entityNode->entity().origin() == vm::vec3(1.0, 0.0, 3.0));
+
+    updateLinkedGroups(
+      groupNode,
+      {untransformedGroupNode.get(), &groupNode, transformedGroupNode.get()},
+      worldBounds)
+      .transform([&](const UpdateLinkedGroupsResult& r) {
+        REQUIRE(r.size() == 2u);
+
+        const auto getOrigin = [](const auto& newChildren) {
+          REQUIRE(newChildren.size() == 1u);
+          const auto* newEntityNode =
+            dynamic_cast<EntityNode*>(newChildren.front().get());
+          REQUIRE(newEntityNode != nullptr);
+          return newEntityNode->entity().origin();
+        };
+
+        CHECK(r[0].first == untransformedGroupNode.get());
+        CHECK(getOrigin(r[0].second) == vm::vec3(1.0, 0.0, 3.0));
+
+        CHECK(r[1].first == transformedGroupNode.get());
+        CHECK(getOrigin(r[1].second) == vm::vec3(1.0, 2.0, 3.0));
+      })
+      .or_else([](const auto&) { FAIL(); });
+  }
 }
 
 TEST_CASE("GroupNodeTest.updateNestedLinkedGroups")
@@ -0,0 +1,117 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/Renderable.h"
+#include "Renderer/Shaders.h"
+
+#include <kdl/vector_utils.h>
+
+#include <optional>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+namespace
+{
+class TestRenderable : public Renderable
+{
+private:
+  std::optional<RenderKey> m_key;
+
+public:
+  explicit TestRenderable(std::optional<RenderKey> key)
+    : m_key{std::move(key)}
+  {
+  }
+
+private:
+  void doRender(RenderContext&) override {}
+  std::optional<RenderKey> doGetRenderKey() const override { return m_key; }
+};
+} // namespace
+
+TEST_CASE("RenderableTest.sortRenderables")
+{
+  const int vertexBuffers[2] = {0, 0};
+  const auto* vb0 = &vertexBuffers[0];
+  const auto* vb1 = &vertexBuffers[1];
+
+  const auto* faceShader = &Shaders::FaceShader;
+  const auto* edgeShader = &Shaders::EdgeShader;
+
+  SECTION("Opaque renderables are rendered before transparent renderables")
+  {
+    auto t1 = TestRenderable{RenderKey{RenderPass::Transparent, edgeShader, vb0}};
+    auto o1 = TestRenderable{RenderKey{RenderPass::Opaque, faceShader, vb0}};
+    auto t2 = TestRenderable{RenderKey{RenderPass::Transparent, faceShader, vb0}};
+    auto o2 = TestRenderable{RenderKey{RenderPass::Opaque, faceShader, vb0}};
+
+    auto renderables = std::vector<Renderable*>{&t1, &o1, &t2, &o2};
+    sortRenderables(renderables);
+    CHECK(renderables == std::vector<Renderable*>{&o1, &o2, &t1, &t2});
+  }
+
+  SECTION("Transparent renderables keep their order")
+  {
+    auto t1 = TestRenderable{RenderKey{RenderPass::Transparent, faceShader, vb1}};
+    auto t2 = TestRenderable{RenderKey{RenderPass::Transparent, edgeShader, vb0}};
+    auto t3 = TestRenderable{RenderKey{RenderPass::Transparent, faceShader, vb0}};
+
+    auto renderables = std::vector<Renderable*>{&t1, &t2, &t3};
+    sortRenderables(renderables);
+    CHECK(renderables == std::vector<Renderable*>{&t1, &t2, &t3});
+  }
+
+  SECTION("Renderables without a key are not reordered")
+  {
+    auto t1 = TestRenderable{RenderKey{RenderPass::Transparent, edgeShader, vb0}};
+    auto o1 = TestRenderable{RenderKey{RenderPass::Opaque, faceShader, vb0}};
+    auto b = TestRenderable{std::nullopt};
+    auto o2 = TestRenderable{RenderKey{RenderPass::Opaque, faceShader, vb0}};
+    auto t2 = TestRenderable{RenderKey{RenderPass::Transparent, edgeShader, vb0}};
+    auto o3 = TestRenderable{RenderKey{RenderPass::Opaque, faceShader, vb0}};
+
+    auto renderables = std::vector<Renderable*>{&t1, &o1, &b, &o2, &t2, &o3};
+    sortRenderables(renderables);
+    CHECK(renderables == std::vector<Renderable*>{&o1, &t1, &b, &o2, &o3, &t2});
+  }
+
+  SECTION("Opaque renderables are grouped by shader and vertex buffer")
+  {
+    auto f1 = TestRenderable{RenderKey{RenderPass::Opaque, faceShader, vb1}};
+    auto e1 = TestRenderable{RenderKey{RenderPass::Opaque, edgeShader, vb0}};
+    auto f0 = TestRenderable{RenderKey{RenderPass::Opaque, faceShader, vb0}};
+    auto e2 = TestRenderable{RenderKey{RenderPass::Opaque, edgeShader, vb0}};
+
+    auto renderables = std::vector<Renderable*>{&f1, &e1, &f0, &e2};
+    sortRenderables(renderables);
+
+    const auto faces = std::vector<Renderable*>{&f0, &f1};
+    const auto edges = std::vector<Renderable*>{&e1, &e2};
+    CHECK(
+      (renderables == kdl::vec_concat(faces, edges)
+       || renderables == kdl::vec_concat(edges, faces)));
+  }
+}
+} // namespace Renderer
+} // namespace TrenchBroom
@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Renderer/ShaderProgramCache.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace Renderer
+{
+TEST_CASE("ShaderProgramCacheTest.writeAndReadCache")
+{
+  const auto key = ShaderProgramCacheKey{
+    "Vendor", "Renderer", "4.5 Compatibility", makeShaderProgramSourceHash({"a", "b"})};
+  const auto binary = ShaderProgramBinary{0x8763u, {'\0', 'b', 'i', 'n', '\xff'}};
+
+  auto stream = std::stringstream{};
+  writeShaderProgramCache(stream, key, binary);
+  const auto cache = stream.str();
+
+  SECTION("Reading a cache yields the written binary")
+  {
+    CHECK(readShaderProgramCache(cache, key) == binary);
+  }
+
+  SECTION("Reading a cache with a different key fails")
+  {
+    auto otherDriverKey = key;
+    otherDriverKey.glVersion = "4.6 Compatibility";
+    CHECK(readShaderProgramCache(cache, otherDriverKey) == std::nullopt);
+
+    auto otherSourceKey = key;
+    otherSourceKey.sourceHash = makeShaderProgramSourceHash({"a", "c"});
+    CHECK(readShaderProgramCache(cache, otherSourceKey) == std::nullopt);
+  }
+
+  SECTION("Reading a truncated cache fails")
+  {
+    CHECK(readShaderProgramCache(cache.substr(0, cache.size() - 1), key) == std::nullopt);
+  }
+
+  SECTION("Different sources have different hashes")
+  {
+    CHECK(
+      makeShaderProgramSourceHash({"a", "b"}) != makeShaderProgramSourceHash({"b", "a"}));
+    CHECK(makeShaderProgramSourceHash({"ab"}) != makeShaderProgramSourceHash({"a", "b"}));
+  }
+}
+} // namespace Renderer
+} // namespace TrenchBroom
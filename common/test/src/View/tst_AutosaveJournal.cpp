@@ -0,0 +1,217 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "View/AutosaveJournal.h"
+
+#include <kdl/string_utils.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace View
+{
+TEST_CASE("AutosaveJournalTest.stripObjectComments")
+{
+  CHECK(stripObjectComments("") == "");
+  CHECK(
+    stripObjectComments(R"(// Game: Quake
+// Format: Standard
+// entity 0
+{
+"classname" "worldspawn"
+// brush 0
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1
+}
+// brush 12
+// brush
+// brush 1a
+}
+// entity 1)")
+    == R"(// Game: Quake
+// Format: Standard
+{
+"classname" "worldspawn"
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1
+}
+// brush
+// brush 1a
+}
+)");
+}
+
+TEST_CASE("AutosaveJournalTest.restoreObjectComments")
+{
+  const auto mapText = std::string{R"(// Game: Quake
+// Format: Quake3
+// entity 0
+{
+"classname" "worldspawn"
+// brush 0
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1
+}
+// brush 1
+{
+patchDef2
+{
+tex
+( 3 3 0 0 0 )
+(
+( ( 0 0 0 0 0 ) ( 0 1 0 0 0 ) ( 0 2 0 0 0 ) )
+)
+}
+}
+}
+// entity 1
+{
+"classname" "func_group"
+// brush 0
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1
+}
+}
+// entity 2
+{
+"classname" "info_player_start"
+}
+)"};
+
+  CHECK(restoreObjectComments("") == "");
+  CHECK(restoreObjectComments(stripObjectComments(mapText)) == mapText);
+}
+
+TEST_CASE("AutosaveJournalTest.makeJournalRecord")
+{
+  SECTION("Identical texts yield an empty record")
+  {
+    const auto record = makeJournalRecord("a\nb\n", "a\nb\n", 0u);
+    REQUIRE(record.has_value());
+    CHECK(replayJournal("a\nb\n", *record) == "a\nb\n");
+  }
+
+  SECTION("Records only contain the changed lines")
+  {
+    const auto oldText = std::string{"a\nb\nc\nd\ne\n"};
+    const auto newText = std::string{"a\nx\nc\nd\ne\ny\n"};
+
+    const auto record = makeJournalRecord(oldText, newText, 4u);
+    REQUIRE(record.has_value());
+    CHECK(record->find("\na\n") == std::string::npos);
+    CHECK(record->find("\nc\n") == std::string::npos);
+    CHECK(replayJournal(oldText, *record) == newText);
+  }
+
+  SECTION("Returns nullopt if there are too many changes")
+  {
+    CHECK(makeJournalRecord("a\nb\nc\n", "x\ny\nz\n", 5u) == std::nullopt);
+    CHECK(makeJournalRecord("a\nb\nc\n", "x\ny\nz\n", 6u).has_value());
+    CHECK(makeJournalRecord("a\n", "a\nb\nc\nd\n", 2u) == std::nullopt);
+  }
+}
+
+TEST_CASE("AutosaveJournalTest.replayJournal")
+{
+  auto rng = std::mt19937{42};
+  const auto randomIndex = [&](const size_t count) {
+    return std::uniform_int_distribution<size_t>{0u, count - 1u}(rng);
+  };
+
+  const auto randomLine = [&]() {
+    // few distinct lines so that the texts contain many repetitions
+    static const auto lines = std::vector<std::string>{"{", "}", "a", "b", "c", ""};
+    return lines[randomIndex(lines.size())];
+  };
+
+  const auto randomEdit = [&](std::vector<std::string> lines) {
+    const auto editCount = randomIndex(8u) + 1u;
+    for (size_t i = 0; i < editCount; ++i)
+    {
+      switch (randomIndex(3u))
+      {
+      case 0:
+        lines.insert(
+          std::next(lines.begin(), static_cast<std::ptrdiff_t>(randomIndex(lines.size() + 1u))),
+          randomLine());
+        break;
+      case 1:
+        if (lines.size() > 1u)
+        {
+          lines.erase(
+            std::next(lines.begin(), static_cast<std::ptrdiff_t>(randomIndex(lines.size()))));
+        }
+        break;
+      default:
+        lines[randomIndex(lines.size())] = randomLine();
+        break;
+      }
+    }
+    return lines;
+  };
+
+  auto lines = std::vector<std::string>{};
+  for (size_t i = 0; i < 200u; ++i)
+  {
+    lines.push_back(randomLine());
+  }
+
+  const auto checkpoint = kdl::str_join(lines, "\n");
+  auto expectedTexts = std::vector<std::string>{checkpoint};
+  auto journal = std::string{};
+
+  for (size_t i = 0; i < 50u; ++i)
+  {
+    lines = randomEdit(std::move(lines));
+    const auto text = kdl::str_join(lines, "\n");
+
+    const auto record = makeJournalRecord(expectedTexts.back(), text, 64u);
+    REQUIRE(record.has_value());
+
+    journal += *record;
+    expectedTexts.push_back(text);
+  }
+
+  CHECK(replayJournal(checkpoint, journal) == expectedTexts.back());
+
+  SECTION("Replaying stops at an incomplete record")
+  {
+    const auto truncatedJournal = journal.substr(0, journal.size() - 1u);
+    CHECK(
+      replayJournal(checkpoint, truncatedJournal)
+      == expectedTexts[expectedTexts.size() - 2u]);
+  }
+
+  SECTION("Replaying stops at a record that does not apply")
+  {
+    const auto firstRecordEnd = journal.find("\n@ ");
+    REQUIRE(firstRecordEnd != std::string::npos);
+
+    CHECK(
+      replayJournal(checkpoint, journal.substr(firstRecordEnd + 1u))
+      == checkpoint);
+  }
+}
+} // namespace View
+} // namespace TrenchBroom
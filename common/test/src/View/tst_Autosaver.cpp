@@ -22,10 +22,12 @@
 #include "Logger.h"
 #include "Model/BrushNode.h"
 #include "Model/LayerNode.h"
+#include "View/AutosaveJournal.h"
 #include "View/Autosaver.h"
 #include "View/MapDocumentTest.h"
 
 #include <chrono>
+#include <sstream>
 #include <thread>
 
 #include "TestUtils.h"
@@ -65,6 +67,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverNoSaveUntilSaveInter
   document->addNodes({{document->currentLayer(), {createBrushNode("some_texture")}}});
 
   autosaver.triggerAutosave(logger);
+  autosaver.waitForPendingBackup(logger);
 
   CHECK_FALSE(env.fileExists(IO::Path("autosave/test.1.map")));
   CHECK_FALSE(env.directoryExists(IO::Path("autosave")));
@@ -82,6 +85,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverNoSaveOfUnchangedMap
 
   Autosaver autosaver(document, 0s);
   autosaver.triggerAutosave(logger);
+  autosaver.waitForPendingBackup(logger);
 
   CHECK_FALSE(env.fileExists(IO::Path("autosave/test.1.map")));
   CHECK_FALSE(env.directoryExists(IO::Path("autosave")));
@@ -107,6 +111,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAfterSaveInterv
   std::this_thread::sleep_for(100ms);
 
   autosaver.triggerAutosave(logger);
+  autosaver.waitForPendingBackup(logger);
 
   CHECK(env.fileExists(IO::Path("autosave/test.1.map")));
   CHECK(env.directoryExists(IO::Path("autosave")));
@@ -132,6 +137,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAgainAfterSaveI
   std::this_thread::sleep_for(100ms);
 
   autosaver.triggerAutosave(logger);
+  autosaver.waitForPendingBackup(logger);
 
   CHECK(env.fileExists(IO::Path("autosave/test.1.map")));
   CHECK(env.directoryExists(IO::Path("autosave")));
@@ -141,12 +147,14 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAgainAfterSaveI
   std::this_thread::sleep_for(100ms);
 
   autosaver.triggerAutosave(logger);
+  autosaver.waitForPendingBackup(logger);
   CHECK_FALSE(env.fileExists(IO::Path("autosave/test.2.map")));
 
   // modify the map
   document->addNodes({{document->currentLayer(), {createBrushNode("some_texture")}}});
 
   autosaver.triggerAutosave(logger);
+  autosaver.waitForPendingBackup(logger);
   CHECK(env.fileExists(IO::Path("autosave/test.2.map")));
 }
 
@@ -172,8 +180,150 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesWhenCrashFilesP
   document->addNodes({{document->currentLayer(), {createBrushNode("some_texture")}}});
 
   autosaver.triggerAutosave(logger);
+  autosaver.waitForPendingBackup(logger);
 
   CHECK(env.fileExists(IO::Path("autosave/test.2.map")));
 }
+
+TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesSnapshotOfDocument")
+{
+  using namespace std::literals::chrono_literals;
+
+  IO::TestEnvironment env;
+  NullLogger logger;
+
+  document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+  assert(env.fileExists(IO::Path("test.map")));
+
+  Autosaver autosaver(document, 0s);
+
+  // modify the map
+  document->addNodes({{document->currentLayer(), {createBrushNode("some_texture")}}});
+
+  auto expected = std::stringstream{};
+  document->saveDocumentTo(expected);
+
+  autosaver.triggerAutosave(logger);
+
+  // modify the map while the backup is being written
+  document->addNodes({{document->currentLayer(), {createBrushNode("other_texture")}}});
+
+  autosaver.waitForPendingBackup(logger);
+
+  CHECK(env.loadFile(IO::Path("autosave/test.1.map")) == expected.str());
+}
+
+TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverAppendsChangesToJournal")
+{
+  using namespace std::literals::chrono_literals;
+
+  IO::TestEnvironment env;
+  NullLogger logger;
+
+  document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+  assert(env.fileExists(IO::Path("test.map")));
+
+  const auto serializeDocument = [&]() {
+    auto str = std::stringstream{};
+    document->saveDocumentTo(str);
+    return stripObjectComments(str.str());
+  };
+
+  const auto replayBackup = [&](const IO::Path& backupPath) {
+    return replayJournal(
+      stripObjectComments(env.loadFile(backupPath)),
+      env.loadFile(makeJournalName(backupPath)));
+  };
+
+  {
+    Autosaver autosaver(document, 0s);
+
+    // modify the map
+    for (size_t i = 0; i < 20; ++i)
+    {
+      document->addNodes({{document->currentLayer(), {createBrushNode("some_texture")}}});
+    }
+
+    autosaver.triggerAutosave(logger);
+    autosaver.waitForPendingBackup(logger);
+
+    CHECK(env.fileExists(IO::Path("autosave/test.1.map")));
+    CHECK_FALSE(env.fileExists(IO::Path("autosave/test.1.journal")));
+
+    // modify the map again
+    document->addNodes({{document->currentLayer(), {createBrushNode("other_texture")}}});
+
+    autosaver.triggerAutosave(logger);
+    autosaver.waitForPendingBackup(logger);
+
+    CHECK_FALSE(env.fileExists(IO::Path("autosave/test.2.map")));
+    CHECK(env.fileExists(IO::Path("autosave/test.1.journal")));
+    CHECK(replayBackup(IO::Path("autosave/test.1.map")) == serializeDocument());
+  }
+
+  auto expected = std::stringstream{};
+  document->saveDocumentTo(expected);
+
+  // the journal is replayed into a new backup by the next session
+  Autosaver autosaver(document, 0s);
+
+  document->addNodes({{document->currentLayer(), {createBrushNode("some_texture")}}});
+
+  autosaver.triggerAutosave(logger);
+  autosaver.waitForPendingBackup(logger);
+
+  CHECK_FALSE(env.fileExists(IO::Path("autosave/test.1.journal")));
+  CHECK(env.loadFile(IO::Path("autosave/test.2.map")) == expected.str());
+  CHECK(env.fileExists(IO::Path("autosave/test.3.map")));
+}
+
+TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverRecoversJournalAfterCrash")
+{
+  using namespace std::literals::chrono_literals;
+
+  IO::TestEnvironment env;
+  NullLogger logger;
+
+  document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+  assert(env.fileExists(IO::Path("test.map")));
+
+  {
+    Autosaver autosaver(document, 0s);
+
+    for (size_t i = 0; i < 20; ++i)
+    {
+      document->addNodes({{document->currentLayer(), {createBrushNode("some_texture")}}});
+    }
+
+    autosaver.triggerAutosave(logger);
+    autosaver.waitForPendingBackup(logger);
+
+    document->addNodes({{document->currentLayer(), {createBrushNode("other_texture")}}});
+
+    autosaver.triggerAutosave(logger);
+    autosaver.waitForPendingBackup(logger);
+
+    REQUIRE(env.fileExists(IO::Path("autosave/test.1.journal")));
+
+    // the application crashes here, so no final backup is created
+  }
+
+  auto expected = std::stringstream{};
+  document->saveDocumentTo(expected);
+
+  // the journal is recovered when the map is opened again, before any further changes
+  Autosaver autosaver(document, 0s);
+  autosaver.recoverJournal(logger);
+  autosaver.waitForPendingBackup(logger);
+
+  CHECK_FALSE(env.fileExists(IO::Path("autosave/test.1.journal")));
+  CHECK(env.loadFile(IO::Path("autosave/test.2.map")) == expected.str());
+
+  // recovering again does not create another backup
+  autosaver.recoverJournal(logger);
+  autosaver.waitForPendingBackup(logger);
+
+  CHECK_FALSE(env.fileExists(IO::Path("autosave/test.3.map")));
+}
 } // namespace View
 } // namespace TrenchBroom
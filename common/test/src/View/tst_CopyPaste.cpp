@@ -446,5 +446,86 @@ TEST_CASE_METHOD(MapDocumentTest, "CopyPasteTest.undoRedo")
   CHECK(dynamic_cast<Model::BrushNode*>(defaultLayer.children().front()) != nullptr);
   CHECK(document->selectedNodes().brushCount() == 1u);
 }
+TEST_CASE_METHOD(MapDocumentTest, "CopyPasteTest.pasteClonedNodes")
+{
+  auto* brushNode = createBrushNode();
+  auto* entityBrushNode1 = createBrushNode();
+  auto* entityBrushNode2 = createBrushNode();
+  auto* entityNode = new Model::EntityNode{Model::Entity{{}, {{"classname", "func_door"}}}};
+
+  document->addNodes({{document->parentForNodes(), {brushNode, entityNode}}});
+  document->addNodes({{entityNode, {entityBrushNode1, entityBrushNode2}}});
+
+  const auto& defaultLayer = *document->world()->defaultLayer();
+  const auto childCount = defaultLayer.childCount();
+
+  SECTION("Selected brushes of an entity are cloned together with the entity")
+  {
+    document->selectNodes({brushNode, entityBrushNode1});
+
+    const auto clones = document->cloneSelectedNodes();
+    REQUIRE(clones.size() == 2u);
+
+    auto* clonedBrushNode = dynamic_cast<Model::BrushNode*>(clones[0]);
+    REQUIRE(clonedBrushNode != nullptr);
+    CHECK(clonedBrushNode->brush() == brushNode->brush());
+
+    auto* clonedEntityNode = dynamic_cast<Model::EntityNode*>(clones[1]);
+    REQUIRE(clonedEntityNode != nullptr);
+    CHECK(clonedEntityNode->entity() == entityNode->entity());
+    REQUIRE(clonedEntityNode->childCount() == 1u);
+
+    document->deselectAll();
+    CHECK(document->pasteClonedNodes(clones) == PasteType::Node);
+    CHECK(defaultLayer.childCount() == childCount + 2u);
+    CHECK(document->selectedNodes().brushCount() == 2u);
+    CHECK(clonedEntityNode->parent() == &defaultLayer);
+  }
+
+  SECTION("Pasting cloned groups resets duplicate persistent group IDs")
+  {
+    document->selectNodes({brushNode});
+    auto* groupNode = document->groupSelection("test");
+    REQUIRE(groupNode->persistentId().has_value());
+
+    document->deselectAll();
+    document->selectNodes({groupNode});
+
+    const auto clones = document->cloneSelectedNodes();
+    document->deselectAll();
+    REQUIRE(document->pasteClonedNodes(clones) == PasteType::Node);
+
+    auto* pastedGroupNode = dynamic_cast<Model::GroupNode*>(defaultLayer.children().back());
+    REQUIRE(pastedGroupNode != nullptr);
+    REQUIRE(pastedGroupNode != groupNode);
+    CHECK(pastedGroupNode->persistentId() != groupNode->persistentId());
+  }
+
+  SECTION("Pasting cloned linked groups unlinks orphaned linked groups")
+  {
+    document->selectNodes({brushNode});
+    auto* groupNode = document->groupSelection("test");
+
+    document->deselectAll();
+    document->selectNodes({groupNode});
+    auto* linkedGroupNode = document->createLinkedDuplicate();
+    const auto linkedGroupId = linkedGroupNode->group().linkedGroupId();
+    REQUIRE(linkedGroupId);
+
+    document->deselectAll();
+    document->selectNodes({linkedGroupNode});
+    const auto clones = document->cloneSelectedNodes();
+
+    document->selectAllNodes();
+    document->deleteObjects();
+
+    REQUIRE(document->pasteClonedNodes(clones) == PasteType::Node);
+    REQUIRE(defaultLayer.childCount() == 1u);
+
+    auto* pastedGroupNode = dynamic_cast<Model::GroupNode*>(defaultLayer.children().back());
+    REQUIRE(pastedGroupNode != nullptr);
+    CHECK(pastedGroupNode->group().linkedGroupId() == std::nullopt);
+  }
+}
 } // namespace View
 } // namespace TrenchBroom
@@ -0,0 +1,216 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FloatType.h"
+#include "Renderer/Camera.h"
+#include "Renderer/OrthographicCamera.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/Lasso.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/intersection.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/plane.h>
+#include <vecmath/ray.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace View
+{
+namespace
+{
+/**
+ * Selects the given points by projecting each of them onto the lasso plane, without
+ * discarding any of them beforehand.
+ */
+std::vector<vm::vec3> selectExactly(
+  const Renderer::Camera& camera,
+  const FloatType distance,
+  const vm::vec3& start,
+  const vm::vec3& cur,
+  const std::vector<vm::vec3>& points)
+{
+  const auto defaultPoint = camera.defaultPoint(static_cast<float>(distance));
+  const auto plane = vm::plane3{vm::vec3{defaultPoint}, vm::vec3{camera.direction()}};
+  const auto transform = vm::mat4x4{vm::coordinate_system_matrix(
+    camera.right(), camera.up(), -camera.direction(), defaultPoint)};
+
+  const auto transformedStart = transform * start;
+  const auto transformedCur = transform * cur;
+  const auto box = vm::bbox2{
+    vm::vec2{vm::min(transformedStart, transformedCur)},
+    vm::vec2{vm::max(transformedStart, transformedCur)}};
+
+  auto result = std::vector<vm::vec3>{};
+  for (const auto& point : points)
+  {
+    const auto ray = vm::ray3{camera.pickRay(vm::vec3f{point})};
+    const auto hitDistance = vm::intersect_ray_plane(ray, plane);
+    if (!vm::is_nan(hitDistance))
+    {
+      const auto projected = transform * vm::point_at_distance(ray, hitDistance);
+      if (box.contains(vm::vec2{projected}))
+      {
+        result.push_back(point);
+      }
+    }
+  }
+  return result;
+}
+
+/**
+ * Returns points around the edges of the volume that is swept by the lasso rectangle
+ * with the given corners, at several distances from the camera, as well as points
+ * spread across the camera's field of view.
+ */
+std::vector<vm::vec3> makePoints(
+  const Renderer::Camera& camera, const vm::vec3& start, const vm::vec3& cur)
+{
+  const auto position = vm::vec3{camera.position()};
+  const auto direction = vm::vec3{camera.direction()};
+  const auto right = vm::vec3{camera.right()};
+  const auto up = vm::vec3{camera.up()};
+
+  // moves a point on the lasso plane along its pick ray
+  const auto alongRay = [&](const vm::vec3& point, const FloatType factor) {
+    return camera.perspectiveProjection()
+             ? position + factor * (point - position)
+             : point + (factor - 1.0) * 64.0 * direction;
+  };
+
+  auto result = std::vector<vm::vec3>{};
+  for (const auto offset : {-1.0, -0.1, -0.01, 0.0, 0.01, 0.1, 1.0})
+  {
+    for (const auto t : {0.0, 0.25, 0.5, 0.75, 1.0})
+    {
+      const auto onPlane = std::vector<vm::vec3>{
+        start + t * vm::dot(cur - start, right) * right + offset * up,
+        start + t * vm::dot(cur - start, right) * right - offset * up
+          + vm::dot(cur - start, up) * up,
+        start + t * vm::dot(cur - start, up) * up + offset * right,
+        start + t * vm::dot(cur - start, up) * up - offset * right
+          + vm::dot(cur - start, right) * right,
+      };
+      for (const auto& point : onPlane)
+      {
+        for (const auto factor : {0.5, 1.0, 2.0, 10.0, 100.0})
+        {
+          result.push_back(alongRay(point, factor));
+        }
+      }
+    }
+  }
+
+  for (int x = -20; x <= 20; ++x)
+  {
+    for (int y = -20; y <= 20; ++y)
+    {
+      for (int z = 1; z <= 10; ++z)
+      {
+        result.push_back(
+          position + FloatType(8) * (FloatType(x) * right + FloatType(y) * up)
+          + FloatType(16 * (z - 5)) * direction);
+      }
+    }
+  }
+
+  return result;
+}
+
+void checkSelection(
+  const Renderer::Camera& camera,
+  const FloatType distance,
+  const vm::vec2f& startPos,
+  const vm::vec2f& curPos)
+{
+  // the lasso corners are points on the lasso plane, like the handle positions that the
+  // vertex tool passes to the lasso
+  const auto start = vm::vec3{camera.defaultPoint(startPos.x(), startPos.y())};
+  const auto cur = vm::vec3{camera.defaultPoint(curPos.x(), curPos.y())};
+  const auto plane = vm::plane3{
+    vm::vec3{camera.defaultPoint(static_cast<float>(distance))},
+    vm::vec3{camera.direction()}};
+  const auto startOnPlane = plane.project_point(start);
+  const auto curOnPlane = plane.project_point(cur);
+
+  auto lasso = Lasso{camera, distance, startOnPlane};
+  lasso.update(curOnPlane);
+
+  const auto points = makePoints(camera, startOnPlane, curOnPlane);
+
+  auto actual = std::vector<vm::vec3>{};
+  lasso.selected(points.begin(), points.end(), std::back_inserter(actual));
+
+  const auto expected = selectExactly(camera, distance, startOnPlane, curOnPlane, points);
+  CHECK(!expected.empty());
+  CHECK(actual == expected);
+}
+} // namespace
+
+TEST_CASE("LassoTest.selected")
+{
+  const auto viewport = Renderer::Camera::Viewport{0, 0, 1024, 768};
+  const auto distance = FloatType(64);
+
+  using T = std::tuple<vm::vec2f, vm::vec2f>;
+  const auto [startPos, curPos] = GENERATE(values<T>({
+    {{100.0f, 100.0f}, {400.0f, 300.0f}},
+    {{900.0f, 700.0f}, {500.0f, 50.0f}},
+    {{10.0f, 700.0f}, {1000.0f, 20.0f}},
+  }));
+
+  CAPTURE(startPos, curPos);
+
+  SECTION("Perspective camera")
+  {
+    const auto camera = Renderer::PerspectiveCamera{
+      90.0f,
+      1.0f,
+      8000.0f,
+      viewport,
+      vm::vec3f{32.0f, -256.0f, 64.0f},
+      vm::normalize(vm::vec3f{0.2f, 1.0f, -0.3f}),
+      vm::vec3f::pos_z()};
+    checkSelection(camera, distance, startPos, curPos);
+  }
+
+  SECTION("Orthographic camera")
+  {
+    const auto camera = Renderer::OrthographicCamera{
+      1.0f,
+      8000.0f,
+      viewport,
+      vm::vec3f{0.0f, -256.0f, 0.0f},
+      vm::vec3f::pos_y(),
+      vm::vec3f::pos_z()};
+    checkSelection(camera, distance, startPos, curPos);
+  }
+}
+} // namespace View
+} // namespace TrenchBroom
@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/Brush.h"
+#include "Model/BrushNode.h"
+#include "View/MapDocument.h"
+#include "View/MapDocumentTest.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace View
+{
+TEST_CASE_METHOD(MapDocumentTest, "MoveBrushVerticesTest.moveSharedVertex")
+{
+  const auto translate = [&](const vm::vec3& delta) {
+    return [&, delta](Model::Brush& brush) {
+      REQUIRE(brush
+                .transform(document->worldBounds(), vm::translation_matrix(delta), false)
+                .is_success());
+    };
+  };
+
+  auto* brushNode1 = createBrushNode();
+  auto* brushNode2 = createBrushNode("texture", translate(vm::vec3{32, 0, 0}));
+  auto* brushNode3 = createBrushNode("texture", translate(vm::vec3{0, 64, 0}));
+
+  document->addNodes(
+    {{document->parentForNodes(), {brushNode1, brushNode2, brushNode3}}});
+  document->selectNodes({brushNode1, brushNode2, brushNode3});
+
+  const auto originalBrush3 = brushNode3->brush();
+  const auto sharedVertex = vm::vec3{16, 16, 16};
+  REQUIRE(brushNode1->brush().hasVertex(sharedVertex));
+  REQUIRE(brushNode2->brush().hasVertex(sharedVertex));
+  REQUIRE_FALSE(brushNode3->brush().hasVertex(sharedVertex));
+
+  SECTION("Moving a vertex changes every brush that has it")
+  {
+    const auto delta = vm::vec3{0, 0, 8};
+    const auto result = document->moveVertices({sharedVertex}, delta);
+    CHECK(result.success);
+    CHECK(result.hasRemainingVertices);
+
+    CHECK(brushNode1->brush().hasVertex(sharedVertex + delta));
+    CHECK(brushNode2->brush().hasVertex(sharedVertex + delta));
+    CHECK_FALSE(brushNode1->brush().hasVertex(sharedVertex));
+    CHECK_FALSE(brushNode2->brush().hasVertex(sharedVertex));
+    CHECK(brushNode3->brush() == originalBrush3);
+
+    document->undoCommand();
+    CHECK(brushNode1->brush().hasVertex(sharedVertex));
+    CHECK(brushNode2->brush().hasVertex(sharedVertex));
+  }
+
+  SECTION("If any brush cannot be changed, no brush is changed")
+  {
+    const auto originalBrush1 = brushNode1->brush();
+    const auto originalBrush2 = brushNode2->brush();
+
+    const auto delta = vm::vec3{0, 0, document->worldBounds().size().z()};
+    const auto result = document->moveVertices({sharedVertex}, delta);
+    CHECK_FALSE(result.success);
+
+    CHECK(brushNode1->brush() == originalBrush1);
+    CHECK(brushNode2->brush() == originalBrush2);
+    CHECK(brushNode3->brush() == originalBrush3);
+  }
+}
+} // namespace View
+} // namespace TrenchBroom
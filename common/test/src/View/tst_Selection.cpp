@@ -29,6 +29,7 @@
 #include "View/MapDocument.h"
 #include "View/MapDocumentTest.h"
 
+#include <vecmath/bbox.h>
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
 #include <vecmath/mat_io.h>
@@ -600,6 +601,58 @@ TEST_CASE_METHOD(MapDocumentTest, "SelectionTest.updateLastSelectionBounds")
   CHECK(document->lastSelectionBounds() == bounds);
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "SelectionTest.updateSelectionCaches")
+{
+  auto* brushNode1 = createBrushNode();
+  auto* brushNode2 = createBrushNode();
+  auto* entityBrushNode = createBrushNode();
+  auto* entityNode = new Model::EntityNode{Model::Entity{}};
+
+  document->addNodes(
+    {{document->parentForNodes(), {brushNode1, brushNode2, entityNode}}});
+  document->addNodes({{entityNode, {entityBrushNode}}});
+
+  document->selectNodes({brushNode2});
+  document->translateObjects(vm::vec3{64, 0, 0});
+  document->deselectAll();
+
+  document->selectNodes({entityBrushNode});
+  document->translateObjects(vm::vec3{0, 64, 0});
+  document->deselectAll();
+
+  document->selectNodes({brushNode1});
+  REQUIRE(
+    document->allSelectedBrushNodes() == std::vector<Model::BrushNode*>{brushNode1});
+  REQUIRE(document->selectionBounds() == brushNode1->logicalBounds());
+
+  document->selectNodes({brushNode2, entityNode});
+  CHECK(
+    document->allSelectedBrushNodes()
+    == std::vector<Model::BrushNode*>{brushNode1, brushNode2, entityBrushNode});
+  CHECK(
+    document->selectionBounds()
+    == vm::merge(
+      vm::merge(brushNode1->logicalBounds(), brushNode2->logicalBounds()),
+      entityBrushNode->logicalBounds()));
+
+  document->deselectNodes({brushNode1});
+  CHECK(
+    document->allSelectedBrushNodes()
+    == std::vector<Model::BrushNode*>{brushNode2, entityBrushNode});
+  CHECK(
+    document->selectionBounds()
+    == vm::merge(brushNode2->logicalBounds(), entityBrushNode->logicalBounds()));
+
+  document->translateObjects(vm::vec3{0, 0, 32});
+  CHECK(
+    document->selectionBounds()
+    == vm::merge(brushNode2->logicalBounds(), entityBrushNode->logicalBounds()));
+
+  document->deselectAll();
+  CHECK(document->allSelectedBrushNodes().empty());
+  CHECK_FALSE(document->hasAnySelectedBrushNodes());
+}
+
 TEST_CASE_METHOD(
   MapDocumentTest, "SelectionCommandTest.faceSelectionUndoAfterTranslationUndo")
 {
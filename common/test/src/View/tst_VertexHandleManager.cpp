@@ -0,0 +1,134 @@
+/*
+ Copyright (C) 2022 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FloatType.h"
+#include "Model/Hit.h"
+#include "Model/PickResult.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/VertexHandleManager.h"
+
+#include <vecmath/ray.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+#include <vecmath/vec_io.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom
+{
+namespace View
+{
+TEST_CASE("VertexHandleManagerTest.pick")
+{
+  const auto viewport = Renderer::Camera::Viewport{0, 0, 1920, 1080};
+  const auto camera = Renderer::PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8000.0f,
+    viewport,
+    vm::vec3f{0.0f, -400.0f, 64.0f},
+    vm::vec3f::pos_y(),
+    vm::vec3f::pos_z()};
+
+  auto manager = VertexHandleManager{};
+  for (int x = -5; x <= 5; ++x)
+  {
+    for (int y = -5; y <= 5; ++y)
+    {
+      for (int z = -5; z <= 5; ++z)
+      {
+        manager.add(vm::vec3{16.0 * x, 16.0 * y, 16.0 * z});
+      }
+    }
+  }
+
+  const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+
+  // compares picking through the handle tree against testing every handle
+  const auto checkPick = [&](const vm::ray3& pickRay) {
+    auto expected = std::vector<vm::vec3>{};
+    for (const auto& handle : manager.allHandles())
+    {
+      if (!vm::is_nan(camera.pickPointHandle(pickRay, handle, handleRadius)))
+      {
+        expected.push_back(handle);
+      }
+    }
+
+    auto pickResult = Model::PickResult{};
+    manager.pick(pickRay, camera, pickResult);
+
+    auto actual = std::vector<vm::vec3>{};
+    for (const auto& hit : pickResult.all())
+    {
+      actual.push_back(hit.target<vm::vec3>());
+    }
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    CHECK(actual == expected);
+    return actual.size();
+  };
+
+  SECTION("Rays through handles")
+  {
+    for (const auto& handle : manager.allHandles())
+    {
+      const auto pickRay = vm::ray3{camera.pickRay(vm::vec3f{handle})};
+      CAPTURE(handle);
+      CHECK(checkPick(pickRay) > 0u);
+    }
+  }
+
+  SECTION("Rays near the edges of handles")
+  {
+    // rays that barely hit or miss a handle, depending on its distance to the camera
+    for (const auto& handle : manager.allHandles())
+    {
+      const auto screenPos = camera.project(vm::vec3f{handle});
+      for (const auto offset : {-8.0f, -4.0f, 4.0f, 8.0f})
+      {
+        const auto pickRay = vm::ray3{camera.pickRay(
+          screenPos.x() + offset, float(viewport.height) - screenPos.y() + offset)};
+        CAPTURE(handle, offset);
+        checkPick(pickRay);
+      }
+    }
+  }
+
+  SECTION("Rays across the viewport")
+  {
+    for (int x = 0; x <= viewport.width; x += 40)
+    {
+      for (int y = 0; y <= viewport.height; y += 40)
+      {
+        const auto pickRay = vm::ray3{camera.pickRay(float(x), float(y))};
+        CAPTURE(x, y);
+        checkPick(pickRay);
+      }
+    }
+  }
+}
+} // namespace View
+} // namespace TrenchBroom
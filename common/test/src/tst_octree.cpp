@@ -654,4 +654,41 @@ TEST_CASE("octree.find_containers")
     CHECK(tree.find_containers({64, 64, 64}) == std::vector<int>{1});
   }
 }
+
+TEST_CASE("octree.find_if")
+{
+  auto tree = octree<double, int>{32.0};
+
+  const auto intersects = [](const vm::bbox3d& bounds) {
+    return [=](const vm::bbox3d& nodeBounds) { return nodeBounds.intersects(bounds); };
+  };
+
+  const auto find_if = [&](const auto& predicate) {
+    auto result = std::vector<int>{};
+    tree.find_if(predicate, std::back_inserter(result));
+    return kdl::vec_sort(std::move(result));
+  };
+
+  SECTION("empty tree") { CHECK(find_if(intersects({{0, 0, 0}, {1, 1, 1}})).empty()); }
+
+  SECTION("multiple nodes")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+    tree.insert({{-64, -64, -64}, {-32, -32, -32}}, 2);
+    tree.insert({{-16, -16, -16}, {16, 16, 16}}, 3);
+
+    // no node is accepted
+    CHECK(find_if([](const auto&) { return false; }).empty());
+
+    // every node is accepted
+    CHECK(find_if([](const auto&) { return true; }) == std::vector<int>{1, 2, 3});
+
+    // only the leaf that contains 1 and its ancestors are accepted
+    CHECK(find_if(intersects({{40, 40, 40}, {48, 48, 48}})) == std::vector<int>{1, 3});
+
+    // only the leaf that contains 2 and its ancestors are accepted
+    CHECK(
+      find_if(intersects({{-48, -48, -48}, {-40, -40, -40}})) == std::vector<int>{2, 3});
+  }
+}
 } // namespace TrenchBroom